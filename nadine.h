@@ -25,12 +25,70 @@
                                 default value is whether on C99 or above
     NADINE_MEMCPY       0|1     whether memcpy is available
                                 default value is whether on hosted C env
+                                if not, a loop is used that copies words
+                                at a time where possible (GCC/Clang)
     NADINE_NATIVE_ENDIAN_INT_AUTO
                         0|1     detect NADINE_NATIVE_ENDIAN_INT automatically
                                 through the compiler, if possible. default = 1
     NADINE_NATIVE_ENDIAN_FLOAT_AUTO
                         0|1     detect NADINE_NATIVE_ENDIAN_FLOAT automatically
                                 through the compiler, if possible. default = 1
+    NADINE_NATIVE_ENDIAN_CACHE
+                        0|1|2   if the native endianness of a type is not
+                                known at compile time, 0 detects it every
+                                time it is needed, 1 detects it on first use
+                                and remembers it, and 2 detects it in
+                                nadine_init, which must be called before any
+                                other function. default = 1
+    NADINE_CONFIG_HEADER        a header to include before anything else,
+                                as a string (e.g. "nadine_native.h" as
+                                generated by nadine_probe.c)
+    NADINE_SIMD         0|1     whether to use SIMD intrinsics for arrays
+                                default value is whether the compiler
+                                targets SSE2 (x86) or NEON (ARM)
+    NADINE_DISPATCH     0|1     whether to pick the SIMD kernel for arrays
+                                at run time based on the CPU
+                                default value is whether supported (x86 with
+                                GCC/Clang/MSVC, ARM Linux; hosted only)
+    NADINE_KERNEL               pin the SIMD kernel for arrays to one of the
+                                NADINE_KERNEL_* values instead of detecting it
+    NADINE_SYS_UIO      0|1     whether nadine_iov is struct iovec from
+                                <sys/uio.h>. default = 0
+    NADINE_NONTEMPORAL_MIN      how many chars nadine_read_array_N and
+                                nadine_write_array_N must convert before
+                                they bypass the cache on x86 (see
+                                nadine_set_nontemporal). default = 32 MiB
+    NADINE_PLAN_MAX_FIELDS      maximum number of fields in a record plan
+                                (nadine_plan). default = 32
+    NADINE_INT128       0|1     enable or disable the 128-bit types
+                                (see nadine_uint128). enabled by default if
+                                unsigned __int128 or a 64-bit type is available
+    NADINE_FLOAT16      0|1     enable or disable the half-precision and
+                                bfloat16 functions (nadine_read_float16 etc.).
+                                enabled by default if float is binary32 and
+                                unsigned short has 16 bits
+    NADINE_MMAP         0|1     whether to provide nadine_convert_mapped and
+                                nadine_convert_mapped_copy. requires POSIX
+                                mmap or Windows. default = 0
+    NADINE_MAPPED_CHUNK         how many chars of a file to map at a time
+                                in the above. default = 64 MiB
+    NADINE_THREADS      0|1     whether to provide the parallel array
+                                functions (nadine_convert_array_parallel_N
+                                etc.). requires POSIX threads or Windows
+                                unless a runner is set. default = 0
+    NADINE_THREADS_PIN  0|1     whether to pin the threads of the parallel
+                                array functions to one CPU each (on Linux,
+                                requires _GNU_SOURCE). default = 0
+    NADINE_PARALLEL_MIN         how many chars each thread of the parallel
+                                array functions converts at least; smaller
+                                arrays use fewer threads. default = 1 MiB
+    NADINE_STATS        0|1     whether to count the calls to each
+                                conversion path (see nadine_get_stats).
+                                default = 0
+    NADINE_STREAM       0|1     whether to provide nadine_stream, buffered
+                                reading and writing of arrays through a
+                                FILE or a file descriptor. requires a hosted
+                                environment. default = 0
     NADINE_NATIVE_ENDIAN_INT
         native endianness (see `endian' below) for integral types
     NADINE_NATIVE_ENDIAN_FLOAT
@@ -59,6 +117,12 @@
       Since endianness conversions are involutions, these functions have
       identical behavior, and their purpose is merely to allow for
       self-documenting code.
+  void nadine_convert_array_N(unsigned endian, T *p, size_t count)
+      Converts every value in the array p[count] to or from the given
+      endianness, in place. The result is identical to calling
+      nadine_convert_N on every element, but the conversion may use SIMD
+      instructions if available (see NADINE_SIMD).
+      endian must be a valid endianness value, or the behavior is undefined.
   T nadine_read_N(unsigned endian, const void *source)
       Reads an integer or floating-point value of type T at the given pointer
       with the specified endianness and returns it. This function results in
@@ -71,6 +135,72 @@
       if destination does not have space for at least `sizeof(T)' characters
       of information. `endian' must be a valid endianness value,
       or the behavior is undefined.
+  void nadine_read_array_N(unsigned endian, T *destination,
+                           const void *source, size_t count)
+      Reads count values of type T from source with the specified endianness
+      into the array destination[count]. The result is identical to calling
+      nadine_read_N for every value, but the copy and the conversion are
+      done in a single pass. source does not have to be aligned. This function
+      results in undefined behavior if source does not contain at least
+      `count * sizeof(T)' characters of information, or if the source and
+      destination overlap. `endian' must be a valid endianness value,
+      or the behavior is undefined.
+  void nadine_write_array_N(unsigned endian, void *destination,
+                            const T *source, size_t count)
+      Writes the values in the array source[count] to destination with the
+      specified endianness. The result is identical to calling
+      nadine_write_N for every value, but the copy and the conversion are
+      done in a single pass. destination does not have to be aligned. This
+      function results in undefined behavior if destination does not have
+      space for at least `count * sizeof(T)' characters of information, or
+      if the source and destination overlap. `endian' must be a valid
+      endianness value, or the behavior is undefined.
+  T nadine_read_aligned_N(unsigned endian, const void *source)
+  void nadine_write_aligned_N(unsigned endian, void *destination, T value)
+      Like nadine_read_N and nadine_write_N, but source or destination must
+      be aligned for T, so that the value can be loaded or stored directly
+      as T and then converted, without a copy through nadine_i_memcpy or
+      char accesses. With GCC and Clang, the access may alias any type;
+      with other compilers, the memory must be accessible as T. This
+      function results in undefined behavior if the pointer is not aligned.
+  size_t nadine_bsearch_N(unsigned endian, const void *base, size_t count,
+                          T key)
+      Binary search for key in the count values at base, stored with the
+      given endianness in ascending order: returns the index of the first
+      value that is not less than key, or count if there is none. Check
+      with nadine_read_N whether the value there is equal to key.
+  size_t nadine_find_N(unsigned endian, const void *base, size_t count,
+                       T key)
+      Returns the index of the first of the count values at base, stored
+      with the given endianness, that is equal to key, or count if there is
+      none. The key is converted to the stored order once, and the values
+      are compared as they are, with SIMD instructions if available.
+  int nadine_minmax_N(unsigned endian, const void *base, size_t count,
+                      T *min, T *max)
+      Stores the least and the greatest of the count values at base,
+      stored with the given endianness, into *min and *max (either may be
+      NULL). Returns 0 if count is 0, or nonzero otherwise.
+      These three are only available for the integer types, other than the
+      128-bit ones. base does not have to be aligned.
+  void nadine_write_key_N(void *destination, T value)
+  T nadine_read_key_N(const void *source)
+  void nadine_write_array_key_N(void *destination, const T *source,
+                                size_t count)
+  void nadine_read_array_key_N(T *destination, const void *source,
+                               size_t count)
+      Write or read values as sortable keys of sizeof(T) chars: comparing
+      two keys with memcmp gives the order of the values, so that they can
+      be stored in an ordered index or sorted a char at a time with a radix
+      sort without being decoded. The keys are big-endian, with the sign
+      bit flipped for the signed types (assuming two's complement) and
+      for floats, of which negative ones have every bit flipped. In the
+      order of float keys, -0 comes before +0, and NaNs come after +inf or
+      before -inf, depending on their sign bit; otherwise, NaNs aside,
+      equal keys only come from equal values. The array functions convert
+      a chunk at a time, like nadine_write_array_N with NADINE_ENDIAN_BIG.
+      Available for every type, but for float only if it is binary32, and
+      for double only if it has the size of a 64-bit integer (the order of
+      the keys is that of IEEE 754 binary64 values).
   unsigned nadine_endian_native_N(void)
       Returns the native endianness of the system for the type
       corresponding to N. The return value is always either a valid `endian'
@@ -79,6 +209,453 @@
       If compiler support is available, endianness may be detected
       automatically, in which case this may instead be implemented
       as a preprocessor macro.
+  void nadine_init(void)
+      Detects the native endianness of every type for which it is not known
+      at compile time. With NADINE_NATIVE_ENDIAN_CACHE=2, this must be
+      called before any other function of this library; otherwise it is
+      optional, but calling it before starting any threads avoids having
+      them detect the endianness (and with NADINE_DISPATCH, the SIMD
+      kernel) on first use, at the same time. With NADINE_STATIC, only
+      affects the calling translation unit. To make the endianness known at
+      compile time where the compiler does not tell it, nadine_probe.c can
+      generate a header to use as NADINE_CONFIG_HEADER.
+  void nadine_config(nadine_config_info *info)
+      Describes how the library was compiled: info->flags is a combination
+      of the NADINE_CONFIG_* flags (SWAP_INTRINSIC: values are swapped with
+      compiler intrinsics, SHIFT_RW: nadine_read_N and nadine_write_N use
+      shifts, PUN_UNIONS: type punning goes through unions, MEMCPY:
+      NADINE_MEMCPY, NATIVE_INT and NATIVE_FLOAT: the native endianness of
+      that class is known at compile time, SIMD, DISPATCH and STATS: the
+      options of the same names, MOVBE: big-endian values of 2, 4 and 8
+      chars are read and written with the x86 MOVBE instruction),
+      info->kernel is nadine_simd_kernel() and
+      info->native_endian_cache is NADINE_NATIVE_ENDIAN_CACHE.
+      info->types[0] to info->types[info->type_count - 1] describe the
+      unsigned integer types, float and double (the signed types take the
+      paths of the unsigned ones): name is N, size is sizeof(T), native is
+      nadine_endian_native_N(), and convert[endian] and rw[endian] are the
+      paths nadine_convert_N and nadine_read_N/nadine_write_N take for each
+      of the four endians, one of NADINE_PATH_NATIVE (nothing to do),
+      NADINE_PATH_SWAP (a fused swap of the whole value),
+      NADINE_PATH_SHIFT (the value is assembled with shifts) or
+      NADINE_PATH_XFORM (chars are reversed and swapped in separate passes).
+      The array functions take the convert path, with the bulk of the array
+      going through the SIMD kernel where there is one.
+  void nadine_get_stats(nadine_stats *stats)
+  void nadine_reset_stats(void)
+      Only with NADINE_STATS. nadine_get_stats stores into stats->calls[p]
+      how many times the conversion functions have taken path p (one of
+      the NADINE_PATH_* values) since the start of the program or the last
+      nadine_reset_stats, which sets the counts to zero. The array
+      functions count once per call. The counts are not synchronized, so
+      they are approximate if several threads convert at the same time, and
+      with NADINE_STATIC, they only cover the calling translation unit.
+
+  T nadine_convert_E_N(T value)
+  T nadine_read_E_N(const void *source)
+  void nadine_write_E_N(void *destination, T value)
+      Identical to nadine_convert_N, nadine_read_N and nadine_write_N,
+      but with a fixed endianness, where E is one of
+          le      for NADINE_ENDIAN_LITTLE
+          be      for NADINE_ENDIAN_BIG
+          pdp     for NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS
+          h316    for NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS
+      Since the endianness is known when the function is defined, these
+      can be optimized better when not inlined (e.g. with NADINE_IMPL).
+      Example: nadine_read_be_uint32
+  const nadine_codec *nadine_codec_for(unsigned endian)
+      Returns the codec for endian (NULL if it is not one of the four), a
+      structure holding the endianness as endian, and for every type N,
+      pointers to the functions of that type with the endianness fixed:
+          T (*convert_N)(T value)
+          T (*read_N)(const void *source)
+          void (*write_N)(void *destination, T value)
+          void (*convert_array_N)(T *p, size_t count)
+          void (*read_array_N)(T *destination, const void *source,
+                               size_t count)
+          void (*write_array_N)(void *destination, const T *source,
+                                size_t count)
+      For formats whose endianness is only known at run time, like TIFF or
+      pcap: look the codec up once, and every value then costs an indirect
+      call of a function that knows its endianness, without the checks
+      that a variable endian takes. The codecs are constant and may be
+      shared between threads.
+      Example: c = nadine_codec_for(NADINE_ENDIAN_BIG); c->read_uint32(p)
+  unsigned nadine_simd_kernel(void)
+      Returns the SIMD kernel used by the array functions, one of
+      NADINE_KERNEL_SCALAR, NADINE_KERNEL_SSE2, NADINE_KERNEL_SSSE3,
+      NADINE_KERNEL_AVX2, NADINE_KERNEL_AVX512 or NADINE_KERNEL_NEON.
+  void nadine_set_nontemporal(unsigned mode)
+      Sets whether the x86 SIMD kernels of nadine_read_array_N and
+      nadine_write_array_N prefetch the source and write the destination
+      with non-temporal stores, so that converting an array much larger
+      than the cache does not evict everything else from it:
+      NADINE_NONTEMPORAL_AUTO (the default) when converting at least
+      NADINE_NONTEMPORAL_MIN chars in one call, NADINE_NONTEMPORAL_ON
+      always and NADINE_NONTEMPORAL_OFF never. The conversion is done
+      either way; only the cache behavior changes. The stores are fenced
+      before the functions return. This must not be called while an array
+      function runs, and with NADINE_STATIC, only affects the calling
+      translation unit.
+
+  nadine_cursor
+      A structure for reading or writing values one after another in a
+      char buffer. It has the members `base' (start of the buffer), `pos'
+      (current position), `end' (end of the buffer), all `unsigned char *',
+      and `endian' (the endianness used for reading and writing).
+  void nadine_cursor_init(nadine_cursor *c, const void *buffer, size_t size,
+                          unsigned endian)
+      Initializes the cursor to the start of buffer[size], reading and
+      writing values with the given endianness. buffer may point to const
+      data if the cursor is only used for reading.
+  int nadine_cursor_require(const nadine_cursor *c, size_t n)
+      Returns nonzero if at least n chars remain after the current position,
+      zero otherwise. This can be used to check the bounds once for a run
+      of values, which may then be read or written without further checks.
+  size_t nadine_cursor_remaining(const nadine_cursor *c)
+      Returns the number of chars after the current position.
+  size_t nadine_cursor_tell(const nadine_cursor *c)
+      Returns the number of chars before the current position.
+  void nadine_cursor_skip(nadine_cursor *c, size_t n)
+      Moves the current position forward by n chars.
+  T nadine_cursor_read_N(nadine_cursor *c)
+      Reads a value of type T at the current position, like nadine_read_N,
+      and moves the current position past it. The bounds are not checked;
+      this function results in undefined behavior if fewer than `sizeof(T)'
+      chars remain.
+  void nadine_cursor_write_N(nadine_cursor *c, T value)
+      Writes a value of type T at the current position, like nadine_write_N,
+      and moves the current position past it. The bounds are not checked;
+      this function results in undefined behavior if fewer than `sizeof(T)'
+      chars remain.
+
+  nadine_iov
+      A buffer segment with the members `iov_base' (void *) and `iov_len'
+      (size_t), like struct iovec. If NADINE_SYS_UIO is enabled, it is
+      struct iovec, so that the segments can be passed to writev or sendmsg.
+  nadine_iowriter
+      A structure for writing values one after another into a chain of
+      segments, spilling values over from one segment to the next. Its
+      member `cursor' is a nadine_cursor over the current segment.
+  void nadine_iowriter_init(nadine_iowriter *w, nadine_iov *segments,
+                            size_t count, unsigned endian)
+      Initializes the writer to the start of segments[count], writing values
+      with the given endianness.
+  void nadine_iowriter_write_N(nadine_iowriter *w, T value)
+      Writes a value of type T at the current position, like nadine_write_N,
+      and moves the current position past it. If the value does not fit in
+      the current segment, it is split between it and the following ones.
+  void nadine_iowriter_put(nadine_iowriter *w, const void *data, size_t n)
+      Copies data[n] as it is to the current position, and moves the current
+      position past it.
+  int nadine_iowriter_ok(const nadine_iowriter *w)
+      Returns nonzero if everything written so far fit in the segments, or
+      zero if the segments ran out, in which case whatever did not fit was
+      dropped.
+  size_t nadine_iowriter_tell(const nadine_iowriter *w)
+      Returns the number of chars written into the segments.
+  size_t nadine_iowriter_finish(nadine_iowriter *w)
+      Sets `iov_len' of the last segment written into to the number of
+      chars written into it, and returns the number of segments up to and
+      including it, so that they can be passed on as they are. The writer
+      may not be used after this.
+
+  nadine_bitreader
+  nadine_bitwriter
+      Structures for reading or writing fields of 1 to NADINE_BITS_MAX (57)
+      bits one after another in a char buffer, either MSB-first (endian
+      NADINE_ENDIAN_BIG: the first bit is the most significant bit of the
+      first char) or LSB-first (NADINE_ENDIAN_LITTLE; NADINE_ENDIAN_SWAPCHARS
+      is ignored). The bits are kept in a 64-bit accumulator, which is
+      refilled or stored 8 chars at a time with a single unaligned read or
+      write where at least 8 chars remain. Only available if CHAR_BIT is 8
+      and a 64-bit type is available. n must be from 1 to NADINE_BITS_MAX
+      below unless otherwise noted, and values are returned and taken as
+      a 64-bit unsigned integer type.
+  void nadine_bitreader_init(nadine_bitreader *r, const void *buffer,
+                             size_t size, unsigned endian)
+      Initializes the reader to the start of buffer[size].
+  void nadine_bitreader_refill(nadine_bitreader *r)
+      Loads chars into the accumulator, so that at least NADINE_BITS_MAX
+      bits can be peeked and consumed. Past the end of the buffer, the
+      reader reads zero bits.
+  U64 nadine_bitreader_peek(const nadine_bitreader *r, unsigned n)
+      Returns the next n bits without consuming them. The result is only
+      valid if at least n bits have been loaded by nadine_bitreader_refill
+      and not consumed yet.
+  void nadine_bitreader_consume(nadine_bitreader *r, unsigned n)
+      Skips the next n bits (0 to NADINE_BITS_MAX), which must have been
+      loaded by nadine_bitreader_refill.
+  U64 nadine_bitreader_read(nadine_bitreader *r, unsigned n)
+      Refills the reader, and then peeks and consumes n bits.
+  size_t nadine_bitreader_tell(const nadine_bitreader *r)
+      Returns the number of bits consumed.
+  void nadine_bitreader_align(nadine_bitreader *r)
+      Skips to the start of the next char, unless already at one.
+  int nadine_bitreader_ok(const nadine_bitreader *r)
+      Returns nonzero if no bits past the end of the buffer have been
+      consumed, or zero otherwise.
+  void nadine_bitwriter_init(nadine_bitwriter *w, void *buffer, size_t size,
+                             unsigned endian)
+      Initializes the writer to the start of buffer[size]. The writer may
+      store into the chars after the current position before it gets to
+      them.
+  void nadine_bitwriter_put(nadine_bitwriter *w, U64 value, unsigned n)
+      Writes the lowest n bits of value.
+  size_t nadine_bitwriter_tell(const nadine_bitwriter *w)
+      Returns the number of bits written.
+  void nadine_bitwriter_align(nadine_bitwriter *w)
+      Writes zero bits up to the start of the next char, unless already at
+      one.
+  int nadine_bitwriter_ok(const nadine_bitwriter *w)
+      Returns nonzero if everything written so far fit in the buffer, or
+      zero if whatever did not fit was dropped.
+  size_t nadine_bitwriter_finish(nadine_bitwriter *w)
+      Aligns the writer, and returns the number of chars written. The writer
+      may be used further after this.
+
+  nadine_field
+      A structure describing one field of a fixed-size record, with the
+      members `offset' and `width' (both size_t, in chars) and `kind', one
+      of NADINE_FIELD_INT (an integer), NADINE_FIELD_FLOAT (a floating-point
+      value) or NADINE_FIELD_RAW (chars never converted, such as strings).
+  int nadine_plan_compile(nadine_plan *plan, const nadine_field *fields,
+                          size_t count)
+      Compiles the record layout described by fields[count] into a plan for
+      nadine_convert_records, nadine_deinterleave and nadine_interleave.
+      Returns nonzero on success, or zero if the fields overlap, a kind is
+      invalid, or count is greater than NADINE_PLAN_MAX_FIELDS.
+  void nadine_convert_records(const nadine_plan *plan, unsigned endian,
+                              void *base, size_t stride, size_t count)
+      Converts every field of every record in place to or from the given
+      endianness, where the records start at base and are stride chars
+      apart. stride must be at least the size of the record (the end of
+      its last field). The result is identical to calling nadine_convert_N
+      on every field, but if the record is at most 16 chars, the conversion
+      may use SIMD instructions (with a single shuffle per record).
+      `endian' must be a valid endianness value, or the behavior is undefined.
+  void nadine_deinterleave(const nadine_plan *plan, unsigned endian,
+                           void *const *columns, const void *source,
+                           size_t stride, size_t count)
+      Reads every field of count records at source (stride chars apart)
+      with the given endianness into a separate array per field, so that
+      the value of field i of record k is written at
+      `(char *)columns[i] + k * fields[i].width' in native endianness.
+      Raw fields are copied as is, and fields with a NULL column are
+      skipped. The result is identical to calling nadine_read_N for every
+      field, but done one block of records at a time. The columns do not
+      have to be aligned, and may not overlap with the records.
+      `endian' must be a valid endianness value, or the behavior is undefined.
+  void nadine_interleave(const nadine_plan *plan, unsigned endian,
+                         void *destination, size_t stride,
+                         const void *const *columns, size_t count)
+      The reverse of nadine_deinterleave: writes the values from the column
+      arrays into count records at destination (stride chars apart) with
+      the given endianness. Chars of the records not covered by any field,
+      or by a field with a NULL column, are not modified.
+
+  The following are only available if CHAR_BIT is 8, and the 48-bit ones
+  only if there is a 64-bit integer type:
+
+  nadine_uint24, nadine_int24, nadine_uint48, nadine_int48
+      32-bit and 64-bit integer types (uint32_t and so on where available)
+      holding the values of packed 24-bit and 48-bit integers.
+  T nadine_read_N(unsigned endian, const void *source)
+  void nadine_write_N(unsigned endian, void *destination, T value)
+  void nadine_read_array_N(unsigned endian, T *destination,
+                           const void *source, size_t count)
+  void nadine_write_array_N(unsigned endian, void *destination,
+                            const T *source, size_t count)
+      Where N is uint24, int24, uint48 or int48 and T the type above: read
+      or write packed integers of 3 or 6 chars, sign-extending the signed
+      ones, and writing only the low 24 or 48 bits of the value. The chars
+      are big or little-endian, and with NADINE_ENDIAN_SWAPCHARS swapped in
+      pairs, leaving the last of the 3 chars of a 24-bit integer in place
+      (the same as nadine_convert_records for a field of that width).
+      nadine_read_array_uint24 and nadine_read_array_int24 unpack 4 to 8
+      values at a time with a shuffle on SSSE3, AVX2 and NEON.
+
+  The following are only available if NADINE_FLOAT16 is enabled:
+
+  float nadine_read_float16(unsigned endian, const void *source)
+  void nadine_write_float16(unsigned endian, void *destination, float value)
+      Reads or writes an IEEE 754 binary16 (half-precision) value, stored in
+      2 chars with the given endianness like an unsigned short, as a float.
+      Every half converts exactly to a float; floats are rounded to the
+      nearest half (ties to even), overflowing into infinity. NaNs stay
+      NaNs, but are made quiet.
+  float nadine_read_bfloat16(unsigned endian, const void *source)
+  void nadine_write_bfloat16(unsigned endian, void *destination, float value)
+      The same for bfloat16 values, the high 16 bits of a binary32 value.
+  void nadine_read_array_float16(unsigned endian, float *destination,
+                                 const void *source, size_t count)
+  void nadine_write_array_float16(unsigned endian, void *destination,
+                                  const float *source, size_t count)
+  void nadine_read_array_bfloat16(unsigned endian, float *destination,
+                                  const void *source, size_t count)
+  void nadine_write_array_bfloat16(unsigned endian, void *destination,
+                                   const float *source, size_t count)
+      The above for count values. The chars are swapped and the values
+      converted in a single pass, with F16C for halves if the CPU has it
+      (with NADINE_DISPATCH, or else if the AVX2 or AVX-512 kernel is in
+      use), and with NEON on AArch64. The arrays may not overlap.
+
+  The following are only available if CHAR_BIT is 8:
+
+  unsigned nadine_read_array_sum_N(unsigned endian, T *destination,
+                                   const void *source, size_t count,
+                                   unsigned sum)
+      Like nadine_read_array_N, but also returns the 16-bit ones' complement
+      sum of the values read and sum, as used by the Internet checksum
+      (RFC 1071). Pass the result of a previous call (or 0) as sum to
+      continue over several arrays; the checksum field of a big-endian
+      frame read with NADINE_ENDIAN_BIG is then ~result & 0xFFFF. The values
+      are added with SIMD instructions (SSE2, AVX2 or NEON) while they are
+      still in the cache. Only available for the 16-bit unsigned types,
+      N = unsigned_short (if it has 16 bits) and uint16.
+  unsigned long nadine_read_array_crc32c_N(unsigned endian, T *destination,
+                                           const void *source, size_t count,
+                                           unsigned long crc)
+      Like nadine_read_array_N, but also returns the CRC32C (Castagnoli)
+      of the `count * sizeof(T)' chars of source, continuing from crc,
+      which is 0 for the first array or the result of the previous call.
+      Uses the SSE4.2 instructions if the CPU has them (with
+      NADINE_DISPATCH, or else if compiling for SSE4.2) and the CRC
+      extension on ARMv8 if compiling for it, and a table otherwise.
+
+  The following are only available if CHAR_BIT is 8 and there are int16_t
+  and int32_t, and the float ones only if NADINE_FLOAT is enabled:
+
+  void nadine_read_array_int16_to_float(unsigned endian, float *destination,
+                                        const void *source, size_t count,
+                                        float scale)
+  void nadine_read_array_int32_to_float(unsigned endian, float *destination,
+                                        const void *source, size_t count,
+                                        float scale)
+      Reads count int16_t or int32_t values with the given endianness and
+      stores each converted to float and multiplied by scale, such as
+      1.0f / 32768 to normalize 16-bit audio samples to [-1, 1).
+  void nadine_write_array_float_to_int16(unsigned endian, void *destination,
+                                         const float *source, size_t count,
+                                         float scale)
+  void nadine_write_array_float_to_int32(unsigned endian, void *destination,
+                                         const float *source, size_t count,
+                                         float scale)
+      The reverse: multiplies each float by scale, rounds it to the nearest
+      integer (ties to even, in the default rounding mode), saturates it to
+      the range of the type, and writes it with the given endianness. NaNs
+      are written as 0.
+  void nadine_read_array_int16_to_int32(unsigned endian,
+                                        int32_t *destination,
+                                        const void *source, size_t count)
+  void nadine_write_array_int32_to_int16(unsigned endian, void *destination,
+                                         const int32_t *source, size_t count)
+      The same between int16_t and int32_t, sign-extending on read and
+      saturating on write.
+      All these swap, convert and scale in a single pass, with SSE2, AVX2
+      or NEON (from float to integer only on AArch64). The arrays may not
+      overlap.
+
+  The following are only available if NADINE_MMAP is enabled:
+
+  int nadine_convert_mapped(const char *path, size_t width, unsigned kind,
+                            unsigned endian, size_t offset, size_t count)
+      Converts count values of width chars, starting offset chars into the
+      file at path, in place to or from the given endianness, by mapping
+      the file into memory NADINE_MAPPED_CHUNK chars at a time. kind is one
+      of the NADINE_FIELD_ values, like for nadine_field. If count is
+      NADINE_MAPPED_ALL, every whole value up to the end of the file is
+      converted. Returns nonzero on success, or zero if the file cannot be
+      opened or mapped (errno or GetLastError tells why), width is zero, or
+      the values do not fit in the file.
+  int nadine_convert_mapped_copy(const char *destination, const char *source,
+                                 size_t width, unsigned kind, unsigned endian,
+                                 size_t offset, size_t count)
+      Like nadine_convert_mapped, but leaves source unmodified and writes
+      the result into a new file at destination (replacing any existing
+      file) of the same size. Chars outside of the converted values are
+      copied as they are. If destination is the same file as source (by
+      any name), the call fails with the file left as it is; use
+      nadine_convert_mapped to convert a file in place.
+
+  The following are only available if NADINE_STREAM is enabled:
+
+  nadine_stream
+      A structure for reading or writing binary data through a buffer,
+      over a stdio FILE or a file descriptor. A stream is used for either
+      reading or writing, not both.
+  void nadine_stream_init_file(nadine_stream *s, FILE *file, void *buffer,
+                               size_t size)
+  void nadine_stream_init_fd(nadine_stream *s, int fd, void *buffer,
+                             size_t size)
+      Initializes the stream to read or write file or fd (the latter only
+      on POSIX systems and Windows) through buffer[size], which must stay
+      available while the stream is in use and hold at least one value of
+      each type read or written; 64 KiB or more keeps the calls into the
+      system few. Neither closes the file when done. A FILE is only asked
+      for the chars a call still needs, since fread waits for all of them,
+      so that reading a pipe or socket does not block on chars that are
+      not sent yet; stdio buffers it anyway.
+  size_t nadine_stream_read_array_N(nadine_stream *s, unsigned endian,
+                                    T *destination, size_t count)
+  size_t nadine_stream_write_array_N(nadine_stream *s, unsigned endian,
+                                     const T *source, size_t count)
+      Read or write count values of T with the given endianness, filling
+      or emptying the buffer as needed, and return how many were read or
+      written: fewer than count only at the end of the stream (the chars
+      of an incomplete value then stay in the buffer), on an error, or if
+      the buffer is too small for a value. The values are converted a
+      buffer at a time with nadine_read_array_N or nadine_write_array_N,
+      straight between the buffer and the caller's array.
+  size_t nadine_stream_read(nadine_stream *s, void *data, size_t n)
+  size_t nadine_stream_write(nadine_stream *s, const void *data, size_t n)
+      The same for n chars copied as they are, such as a header. Reads of
+      at least the size of the buffer go straight into data once the
+      buffer is empty.
+  int nadine_stream_flush(nadine_stream *s)
+      Writes the buffered chars to the file (without fflush for a FILE).
+      Returns nonzero on success, or zero on an error, in which case the
+      buffered chars are lost. Call it before closing a written file.
+  int nadine_stream_ok(const nadine_stream *s)
+      Returns zero if a read from or write to the file has failed (errno
+      tells why), or nonzero otherwise; the end of the stream is not an
+      error.
+
+  The following are only available if NADINE_THREADS is enabled:
+
+  void nadine_convert_array_parallel_N(unsigned endian, T *p, size_t count,
+                                       unsigned nthreads)
+  void nadine_read_array_parallel_N(unsigned endian, T *destination,
+                                    const void *source, size_t count,
+                                    unsigned nthreads)
+  void nadine_write_array_parallel_N(unsigned endian, void *destination,
+                                     const T *source, size_t count,
+                                     unsigned nthreads)
+      Like nadine_convert_array_N, nadine_read_array_N and
+      nadine_write_array_N, but split the array into up to nthreads chunks
+      (0 for one per CPU; at most 64) converted in parallel, which start at
+      cache line boundaries of the destination where possible. Fewer chunks
+      are used if they would be smaller than NADINE_PARALLEL_MIN chars, and
+      an array too small for two is converted on the calling thread. Unless
+      a runner is set, every call starts its own threads and waits for them.
+      Chunk i of an array always goes to thread i, pinned with
+      NADINE_THREADS_PIN to the i-th of the CPUs in the affinity mask of
+      the process, so that on NUMA systems, memory first touched by a
+      parallel function (e.g. nadine_read_array_parallel_N into a newly
+      allocated array) stays local to the threads converting it. Each chunk
+      is converted with its own call to nadine_read_array_N etc., so
+      NADINE_NONTEMPORAL_AUTO only bypasses the cache for chunks of at
+      least NADINE_NONTEMPORAL_MIN chars; use nadine_set_nontemporal with
+      NADINE_NONTEMPORAL_ON for huge arrays split into smaller chunks.
+  void nadine_set_parallel_runner(nadine_parallel_runner runner,
+                                  void *context)
+      Makes the parallel array functions run their chunks with runner
+      instead of threads of their own, or with their own threads again if
+      runner is NULL. runner is called as runner(context, task, argument, n)
+      and must call task(argument, i) once for every i below n, in any
+      order and on any threads, returning only after all of them have
+      returned. This must not be called while a parallel function runs,
+      and with NADINE_STATIC, only affects the calling translation unit.
 
 Internal functions are prefixed with `nadine_i_'.
 
@@ -106,11 +683,17 @@ These sets of functions are provided for the following types:
 | `uint32_t'           | `uint32'             | `NADINE_STDINT'                |
 | `int64_t'            | `int64'              | `NADINE_STDINT'                |
 | `uint64_t'           | `uint64'             | `NADINE_STDINT'                |
+| `nadine_int128'      | `int128'             | `NADINE_INT128'                |
+| `nadine_uint128'     | `uint128'            | `NADINE_INT128'                |
 | `float'              | `float'              | `NADINE_FLOAT'                 |
 | `double'             | `double'             | `NADINE_FLOAT'                 |
 
 Example of a full name under this scheme: `nadine_convert_int'
 
+nadine_uint128 and nadine_int128 are unsigned __int128 and __int128 if the
+compiler supports them. Otherwise, they are structs with two unsigned 64-bit
+members `lo' and `hi', the low and high 64 bits of the two's complement value.
+
 *******************************************************************************/
 
 /** MIT license terms:
@@ -144,9 +727,9 @@ For Unlicense terms, please refer to <https://unlicense.org>.
 #ifndef NADINE_H
 #define NADINE_H
 
-/* we at least pretend to be C++ compatible */
-#ifdef __cplusplus
-extern "C" {
+/* user configuration, e.g. one generated by nadine_probe.c */
+#ifdef NADINE_CONFIG_HEADER
+#include NADINE_CONFIG_HEADER
 #endif
 
 #include <limits.h>
@@ -159,6 +742,56 @@ extern "C" {
 #define NADINE_ENDIAN_SWAPCHARS 2
 #define NADINE_ENDIAN_UNKNOWN UINT_MAX
 
+/* SIMD kernels for the array functions, returned by nadine_simd_kernel */
+#define NADINE_KERNEL_SCALAR 0
+#define NADINE_KERNEL_SSE2 1
+#define NADINE_KERNEL_SSSE3 2
+#define NADINE_KERNEL_AVX2 3
+#define NADINE_KERNEL_AVX512 4
+#define NADINE_KERNEL_NEON 5
+
+/* modes for nadine_set_nontemporal */
+#define NADINE_NONTEMPORAL_AUTO 0
+#define NADINE_NONTEMPORAL_OFF 1
+#define NADINE_NONTEMPORAL_ON 2
+
+/* conversion paths, reported by nadine_config and nadine_get_stats */
+#define NADINE_PATH_NATIVE 0
+#define NADINE_PATH_SWAP 1
+#define NADINE_PATH_SHIFT 2
+#define NADINE_PATH_XFORM 3
+#define NADINE_PATHS 4
+
+/* flags for nadine_config_info */
+#define NADINE_CONFIG_SWAP_INTRINSIC 0x001
+#define NADINE_CONFIG_SHIFT_RW 0x002
+#define NADINE_CONFIG_PUN_UNIONS 0x004
+#define NADINE_CONFIG_MEMCPY 0x008
+#define NADINE_CONFIG_NATIVE_INT 0x010
+#define NADINE_CONFIG_NATIVE_FLOAT 0x020
+#define NADINE_CONFIG_SIMD 0x040
+#define NADINE_CONFIG_DISPATCH 0x080
+#define NADINE_CONFIG_STATS 0x100
+#define NADINE_CONFIG_MOVBE 0x200
+
+/* record field kinds for nadine_field */
+#define NADINE_FIELD_INT 0
+#define NADINE_FIELD_FLOAT 1
+#define NADINE_FIELD_RAW 2
+
+/* bypass the cache in array functions from this many chars */
+#ifndef NADINE_NONTEMPORAL_MIN
+#define NADINE_NONTEMPORAL_MIN 33554432UL
+#endif
+
+/* maximum number of fields in a nadine_plan */
+#ifndef NADINE_PLAN_MAX_FIELDS
+#define NADINE_PLAN_MAX_FIELDS 32
+#endif
+
+/* count for nadine_convert_mapped: up to the end of the file */
+#define NADINE_MAPPED_ALL ((size_t)-1)
+
 /* check C99 */
 #ifndef NADINE_I_C99
 #if __STDC_VERSION__ >= 199901L
@@ -237,6 +870,54 @@ extern "C" {
 #endif
 #endif /* NADINE_I_HAS_ULL */
 
+/* 64-bit unsigned integer type, if any */
+#if NADINE_STDINT && defined(UINT64_MAX) && defined(INT64_MAX)
+#define NADINE_I_U64 uint64_t
+#define NADINE_I_U64_N uint64
+#define NADINE_I_S64 int64_t
+#elif (ULONG_MAX >> 31 >> 31) == 3
+#define NADINE_I_U64 unsigned long
+#define NADINE_I_U64_N unsigned_long
+#define NADINE_I_S64 long
+#elif NADINE_I_HAS_ULL && (ULLONG_MAX >> 31 >> 31) == 3
+#define NADINE_I_U64 unsigned long long
+#define NADINE_I_U64_N unsigned_long_long
+#define NADINE_I_S64 long long
+#endif
+
+/* 32-bit unsigned integer type, if any */
+#if NADINE_STDINT && defined(UINT32_MAX) && defined(INT32_MAX)
+#define NADINE_I_U32 uint32_t
+#define NADINE_I_S32 int32_t
+#elif UINT_MAX == 0xFFFFFFFFUL
+#define NADINE_I_U32 unsigned int
+#define NADINE_I_S32 int
+#elif ULONG_MAX == 0xFFFFFFFFUL
+#define NADINE_I_U32 unsigned long
+#define NADINE_I_S32 long
+#endif
+
+/* __int128 check (GCC and Clang, usually only on 64-bit targets) */
+#ifndef NADINE_I_HAS_INT128
+#if defined(__SIZEOF_INT128__) && CHAR_BIT == 8
+#define NADINE_I_HAS_INT128 1
+#else
+#define NADINE_I_HAS_INT128 0
+#endif
+#endif /* NADINE_I_HAS_INT128 */
+
+/* 128-bit types: __int128, or a struct of two 64-bit words */
+#ifndef NADINE_INT128
+#if NADINE_I_HAS_INT128 || defined(NADINE_I_U64)
+#define NADINE_INT128 1
+#else
+#define NADINE_INT128 0
+#endif
+#endif /* NADINE_INT128 */
+#if NADINE_INT128 && !NADINE_I_HAS_INT128 && !defined(NADINE_I_U64)
+#error NADINE_INT128=1 requires __int128 or a 64-bit integer type
+#endif
+
 /* auto for both by default unless explicitly disabled */
 #ifndef NADINE_NATIVE_ENDIAN_INT_AUTO
 #define NADINE_NATIVE_ENDIAN_INT_AUTO 1
@@ -245,9 +926,16 @@ extern "C" {
 #define NADINE_NATIVE_ENDIAN_FLOAT_AUTO 1
 #endif
 
+/* remember the native endianness detected at run time by default */
+#ifndef NADINE_NATIVE_ENDIAN_CACHE
+#define NADINE_NATIVE_ENDIAN_CACHE 1
+#endif
+
 #if (!defined(NADINE_NATIVE_ENDIAN_INT) && NADINE_NATIVE_ENDIAN_INT_AUTO)      \
-    || (!defined(NADINE_NATIVE_ENDIAN_FLOAT) && NADINE_NATIVE_ENDIAN_FLOAT_AUTO)
-/* architecture detection if we are going automatic for either */
+    || (!defined(NADINE_NATIVE_ENDIAN_FLOAT) && NADINE_NATIVE_ENDIAN_FLOAT_AUTO)\
+    || !defined(NADINE_SIMD) || NADINE_SIMD
+/* architecture detection if we are going automatic for either,
+   or if we might want to use SIMD */
 #define NADINE_I_DETECT_ARCH 1
 #endif
 
@@ -256,6 +944,10 @@ extern "C" {
 #if defined(__i386__) || defined(_M_I86) || defined(_M_IX86) || defined(_M_X64)\
         || defined(__X86__) || defined(__amd64__) || defined(__x86_64__)
 #define NADINE_I_ARCH_X86 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define NADINE_I_ARCH_ARM64 1
+#elif defined(__arm__) || defined(_M_ARM)
+#define NADINE_I_ARCH_ARM 1
 #endif
 #endif
 
@@ -349,6 +1041,235 @@ extern "C" {
 #define NADINE_I_BIENDIAN 1
 #endif
 
+/* check SIMD */
+#ifndef NADINE_SIMD
+#if CHAR_BIT == 8 && ((NADINE_I_ARCH_X86 && (defined(__SSE2__)                 \
+        || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))       \
+        || defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define NADINE_SIMD 1
+#else
+#define NADINE_SIMD 0
+#endif
+#endif /* #ifndef NADINE_SIMD */
+
+/* check whether we can select SIMD kernels at run time */
+#if NADINE_SIMD && (__STDC_HOSTED__ || defined(_MSC_VER)) && NADINE_I_ARCH_X86 \
+        && (__clang_major__ >= 4 || (!defined(__clang__) && __GNUC__ >= 5)     \
+            || _MSC_VER >= 1911)
+#define NADINE_I_CAN_DISPATCH 1
+#elif NADINE_SIMD && __STDC_HOSTED__ && defined(__GNUC__) && defined(__linux__)\
+        && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define NADINE_I_CAN_DISPATCH 1
+#else
+#define NADINE_I_CAN_DISPATCH 0
+#endif
+
+/* check dispatch */
+#ifndef NADINE_DISPATCH
+#define NADINE_DISPATCH NADINE_I_CAN_DISPATCH
+#endif /* #ifndef NADINE_DISPATCH */
+#if NADINE_DISPATCH && !NADINE_I_CAN_DISPATCH
+#error NADINE_DISPATCH=1 requires SIMD, a hosted environment and GCC/Clang/MSVC
+#endif
+
+/* pick the SIMD instruction sets we are allowed to compile for.
+   with dispatch, we compile for all of them and pick one at run time */
+#if NADINE_SIMD
+#if NADINE_I_ARCH_X86
+#define NADINE_I_SIMD 1
+#define NADINE_I_SIMD_SSE2 1
+#if defined(__SSSE3__) || defined(__AVX__) || NADINE_DISPATCH
+#define NADINE_I_SIMD_SSSE3 1
+#endif
+#if defined(__AVX2__) || NADINE_DISPATCH
+#define NADINE_I_SIMD_AVX2 1
+#endif
+#if defined(__AVX512BW__) || NADINE_DISPATCH
+#define NADINE_I_SIMD_AVX512 1
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define NADINE_I_SIMD 1
+#define NADINE_I_SIMD_NEON 1
+#endif
+#endif /* NADINE_SIMD */
+
+/* check MOVBE, which loads or stores a value and swaps it in one
+   instruction (Atom, Haswell and later). MSVC does not tell whether the
+   target has it, but every CPU with AVX2 does */
+#ifndef NADINE_I_MOVBE
+#if CHAR_BIT == 8 && NADINE_I_ARCH_X86 && defined(NADINE_I_U32)               \
+        && defined(NADINE_I_U64)
+#if defined(_MSC_VER) && !defined(__clang__) && _MSC_VER >= 1900               \
+        && defined(_M_X64) && (defined(__MOVBE__) || defined(__AVX2__))
+#define NADINE_I_MOVBE 1
+#define NADINE_I_MOVBE_MSVC 1
+#elif defined(__MOVBE__) && (__clang_major__ >= 4 || __GNUC__ >= 5)
+#define NADINE_I_MOVBE 1
+#endif
+#endif
+#endif /* #ifndef NADINE_I_MOVBE */
+#ifndef NADINE_I_MOVBE
+#define NADINE_I_MOVBE 0
+#endif
+
+/* intrinsic headers must be included outside of extern "C" */
+#if defined(_MSC_VER) && !defined(__clang__)
+/* _byteswap_* */
+#include <stdlib.h>
+#endif
+#if NADINE_I_SIMD_AVX2 || NADINE_I_SIMD_AVX512 || NADINE_I_MOVBE_MSVC
+#include <immintrin.h>
+#elif NADINE_I_SIMD_SSE2 && defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif NADINE_I_SIMD_SSSE3
+#include <tmmintrin.h>
+#elif NADINE_I_SIMD_SSE2
+#include <emmintrin.h>
+#elif NADINE_I_SIMD_NEON
+#include <arm_neon.h>
+#if defined(__ARM_FEATURE_CRC32) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_acle.h>
+#endif
+#endif
+
+#if NADINE_DISPATCH && defined(_MSC_VER)
+#include <intrin.h>
+#elif NADINE_DISPATCH && NADINE_I_SIMD_NEON
+#include <sys/auxv.h>
+#endif
+#if NADINE_DISPATCH && NADINE_I_SIMD_SSE2 && !defined(_MSC_VER)
+/* __get_cpuid, for the features __builtin_cpu_supports may not know */
+#include <cpuid.h>
+#endif
+
+/* check memory-mapped files */
+#ifndef NADINE_MMAP
+#define NADINE_MMAP 0
+#endif /* #ifndef NADINE_MMAP */
+#ifndef NADINE_MAPPED_CHUNK
+#define NADINE_MAPPED_CHUNK 67108864UL
+#endif /* #ifndef NADINE_MAPPED_CHUNK */
+
+#if NADINE_MMAP && (NADINE_STATIC || NADINE_IMPL)
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#endif /* NADINE_MMAP */
+
+/* check iovec */
+#ifndef NADINE_SYS_UIO
+#define NADINE_SYS_UIO 0
+#endif /* #ifndef NADINE_SYS_UIO */
+
+#if NADINE_SYS_UIO
+#include <sys/uio.h>
+#endif /* NADINE_SYS_UIO */
+
+/* check call counting */
+#ifndef NADINE_STATS
+#define NADINE_STATS 0
+#endif /* #ifndef NADINE_STATS */
+
+/* check threads */
+#ifndef NADINE_THREADS
+#define NADINE_THREADS 0
+#endif /* #ifndef NADINE_THREADS */
+#ifndef NADINE_THREADS_PIN
+#define NADINE_THREADS_PIN 0
+#endif /* #ifndef NADINE_THREADS_PIN */
+#ifndef NADINE_PARALLEL_MIN
+#define NADINE_PARALLEL_MIN 1048576UL
+#endif /* #ifndef NADINE_PARALLEL_MIN */
+
+#if NADINE_THREADS && (NADINE_STATIC || NADINE_IMPL)
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#endif /* NADINE_THREADS */
+
+/* check streams */
+#ifndef NADINE_STREAM
+#define NADINE_STREAM 0
+#endif /* #ifndef NADINE_STREAM */
+#if NADINE_STREAM && !__STDC_HOSTED__ && !defined(_MSC_VER)
+#error NADINE_STREAM=1 requires a hosted environment
+#endif
+/* file descriptors are POSIX, or in the C runtime on Windows */
+#if NADINE_STREAM && (defined(_WIN32) || defined(__unix__)                    \
+                      || defined(__unix) || defined(__APPLE__))
+#define NADINE_I_STREAM_FD 1
+#endif
+
+#if NADINE_STREAM
+#include <stdio.h>
+#if NADINE_STATIC || NADINE_IMPL
+#include <errno.h>
+#include <string.h>
+#if NADINE_I_STREAM_FD && defined(_WIN32)
+#include <io.h>
+#elif NADINE_I_STREAM_FD
+#include <unistd.h>
+#endif
+#endif /* NADINE_STATIC || NADINE_IMPL */
+#endif /* NADINE_STREAM */
+
+/* kernel selected by default, if we are not dispatching */
+#if !NADINE_I_SIMD
+#define NADINE_I_KERNEL NADINE_KERNEL_SCALAR
+#elif defined(NADINE_KERNEL)
+#define NADINE_I_KERNEL NADINE_KERNEL
+#elif NADINE_I_SIMD_AVX512
+#define NADINE_I_KERNEL NADINE_KERNEL_AVX512
+#elif NADINE_I_SIMD_AVX2
+#define NADINE_I_KERNEL NADINE_KERNEL_AVX2
+#elif NADINE_I_SIMD_SSSE3
+#define NADINE_I_KERNEL NADINE_KERNEL_SSSE3
+#elif NADINE_I_SIMD_SSE2
+#define NADINE_I_KERNEL NADINE_KERNEL_SSE2
+#elif NADINE_I_SIMD_NEON
+#define NADINE_I_KERNEL NADINE_KERNEL_NEON
+#endif
+
+#if !NADINE_DISPATCH && NADINE_I_KERNEL != NADINE_KERNEL_SCALAR               \
+    && !(NADINE_I_KERNEL == NADINE_KERNEL_SSE2 && NADINE_I_SIMD_SSE2)          \
+    && !(NADINE_I_KERNEL == NADINE_KERNEL_SSSE3 && NADINE_I_SIMD_SSSE3)        \
+    && !(NADINE_I_KERNEL == NADINE_KERNEL_AVX2 && NADINE_I_SIMD_AVX2)          \
+    && !(NADINE_I_KERNEL == NADINE_KERNEL_AVX512 && NADINE_I_SIMD_AVX512)      \
+    && !(NADINE_I_KERNEL == NADINE_KERNEL_NEON && NADINE_I_SIMD_NEON)
+#error NADINE_KERNEL is not available with the current compiler options
+#endif
+
+/* compile individual functions for an instruction set when dispatching */
+#if NADINE_DISPATCH && defined(__GNUC__) && NADINE_I_ARCH_X86
+#define NADINE_I_TARGET(x) __attribute__((__target__(x)))
+#else
+#define NADINE_I_TARGET(x)
+#endif
+
+/* for types that may alias anything, like char */
+#if __clang_major__ >= 4 || \
+    (__GNUC__ > 3 || (__GNUC__ == 3 && __GNUC_MINOR__ >= 3))
+#define NADINE_I_MAY_ALIAS __attribute__((__may_alias__))
+#define NADINE_I_HAS_MAY_ALIAS 1
+#else
+#define NADINE_I_MAY_ALIAS
+#define NADINE_I_HAS_MAY_ALIAS 0
+#endif
+
+/* we at least pretend to be C++ compatible */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /* static asserts */
 #if NADINE_I_C23
 #define NADINE_I_STATIC_ASSERT(msg, expr) static_assert(expr, msg)
@@ -419,10 +1340,24 @@ NADINE_I_STATIC_ASSERT("unsigned long long may not have padding",
 
 /* memcpy implementation */
 #if !NADINE_MEMCPY
+#if NADINE_I_HAS_MAY_ALIAS
+typedef unsigned NADINE_I_MAY_ALIAS nadine_i_word;
+#endif
+
 NADINE_I_FN void nadine_i_memcpy(void *p, const void *s, size_t n) {
     /* cast for C++ compatibility */
     const unsigned char *src = (const unsigned char *)s;
     unsigned char *dst = (unsigned char *)p;
+#if NADINE_I_HAS_MAY_ALIAS
+    /* copy words at a time if the pointers are aligned the same. the integer
+       value of a pointer is only used for its alignment */
+    const size_t w = sizeof(nadine_i_word);
+    if (n >= w && (size_t)src % w == (size_t)dst % w) {
+        for (; (size_t)dst % w; --n) *dst++ = *src++;
+        for (; n >= w; n -= w, dst += w, src += w)
+            *(nadine_i_word *)dst = *(const nadine_i_word *)src;
+    }
+#endif /* NADINE_I_HAS_MAY_ALIAS */
     while (n--) *dst++ = *src++;
 }
 #endif /* #if !NADINE_MEMCPY */
@@ -435,18 +1370,43 @@ NADINE_I_FN void nadine_i_memcpy(void *p, const void *s, size_t n) {
 #define NADINE_I_WREV4(T, x) ((T)(__builtin_bswap32((T)(x))))
 #define NADINE_I_WREV8(T, x) ((T)(__builtin_bswap64((T)(x))))
 #define NADINE_I_WREV_INTRINSIC 1
-#else
+#elif __GNUC__ == 4 && __GNUC_MINOR__ >= 3
+/* no __builtin_bswap16 before GCC 4.8; the shifts below become a rotate */
+#define NADINE_I_WREV4(T, x) ((T)(__builtin_bswap32((T)(x))))
+#define NADINE_I_WREV8(T, x) ((T)(__builtin_bswap64((T)(x))))
+#define NADINE_I_WREV_INTRINSIC 1
+#elif defined(_MSC_VER)
+/* from <stdlib.h>; unsigned long has 32 bits on Windows */
+#define NADINE_I_WREV2(T, x) ((T)(_byteswap_ushort((unsigned short)(x))))
+#define NADINE_I_WREV4(T, x) ((T)(_byteswap_ulong((unsigned long)(x))))
+#define NADINE_I_WREV8(T, x) ((T)(_byteswap_uint64((unsigned __int64)(x))))
+#define NADINE_I_WREV_INTRINSIC 1
+#elif defined(__has_builtin)
+/* other compilers that provide the GCC builtins */
+#if __has_builtin(__builtin_bswap16)
+#define NADINE_I_WREV2(T, x) ((T)(__builtin_bswap16((T)(x))))
+#endif
+#if __has_builtin(__builtin_bswap32) && __has_builtin(__builtin_bswap64)
+#define NADINE_I_WREV4(T, x) ((T)(__builtin_bswap32((T)(x))))
+#define NADINE_I_WREV8(T, x) ((T)(__builtin_bswap64((T)(x))))
+#define NADINE_I_WREV_INTRINSIC 1
+#endif
+#endif
 /* standard C: reverse 2-char, 4-char, (C99+) 8-char int */
+#ifndef NADINE_I_WREV2
 #define NADINE_I_WREV2(T, x) ((T)(                                             \
             ((((T)(x) & 0x00FFU)) << 8U)                                       \
           | ((((T)(x) & 0xFF00U)) >> 8U)))
+#endif /* NADINE_I_WREV2 */
+#ifndef NADINE_I_WREV4
 #define NADINE_I_CW4(x) x##UL
 #define NADINE_I_WREV4(T, x) ((T)(                                             \
             ((((T)(x) & NADINE_I_CW4(0x000000FF))) << 24U)                     \
           | ((((T)(x) & NADINE_I_CW4(0x0000FF00))) <<  8U)                     \
           | ((((T)(x) & NADINE_I_CW4(0x00FF0000))) >>  8U)                     \
           | ((((T)(x) & NADINE_I_CW4(0xFF000000))) >> 24U)))
-#if NADINE_I_HAS_ULL
+#endif /* NADINE_I_WREV4 */
+#if !defined(NADINE_I_WREV8) && NADINE_I_HAS_ULL
 #define NADINE_I_CW8(x) x##ULL
 #define NADINE_I_WREV8(T, x) ((T)(                                             \
             ((((T)(x) & NADINE_I_CW8(0x00000000000000FF))) << 56U)             \
@@ -457,10 +1417,662 @@ NADINE_I_FN void nadine_i_memcpy(void *p, const void *s, size_t n) {
           | ((((T)(x) & NADINE_I_CW8(0x0000FF0000000000))) >> 24U)             \
           | ((((T)(x) & NADINE_I_CW8(0x00FF000000000000))) >> 40U)             \
           | ((((T)(x) & NADINE_I_CW8(0xFF00000000000000))) >> 56U)))
-#endif /* NADINE_I_HAS_ULL */
-#endif /* stdc */
+#endif /* NADINE_I_WREV8 */
 #endif /* CHAR_BIT == 8 */
 
+#if NADINE_I_MOVBE
+/* load or store a big-endian value in one MOVBE instruction. GCC and Clang
+   turn a swap of a plain load or store into one when targeting MOVBE */
+#if NADINE_I_MOVBE_MSVC
+NADINE_I_FNS NADINE_I_U32 nadine_i_loadbe2(const void *p) {
+    return _load_be_u16(p);
+}
+NADINE_I_FNS NADINE_I_U32 nadine_i_loadbe4(const void *p) {
+    return _load_be_u32(p);
+}
+NADINE_I_FNS NADINE_I_U64 nadine_i_loadbe8(const void *p) {
+    return _load_be_u64(p);
+}
+NADINE_I_FNS void nadine_i_storebe2(void *p, NADINE_I_U32 v) {
+    _store_be_u16(p, (unsigned short)v);
+}
+NADINE_I_FNS void nadine_i_storebe4(void *p, NADINE_I_U32 v) {
+    _store_be_u32(p, v);
+}
+NADINE_I_FNS void nadine_i_storebe8(void *p, NADINE_I_U64 v) {
+    _store_be_u64(p, v);
+}
+#else
+NADINE_I_FNS NADINE_I_U32 nadine_i_loadbe2(const void *p) {
+    unsigned short v;
+    nadine_i_memcpy(&v, p, sizeof(v));
+    return NADINE_I_WREV2(unsigned short, v);
+}
+NADINE_I_FNS NADINE_I_U32 nadine_i_loadbe4(const void *p) {
+    NADINE_I_U32 v;
+    nadine_i_memcpy(&v, p, sizeof(v));
+    return NADINE_I_WREV4(NADINE_I_U32, v);
+}
+NADINE_I_FNS NADINE_I_U64 nadine_i_loadbe8(const void *p) {
+    NADINE_I_U64 v;
+    nadine_i_memcpy(&v, p, sizeof(v));
+    return NADINE_I_WREV8(NADINE_I_U64, v);
+}
+NADINE_I_FNS void nadine_i_storebe2(void *p, NADINE_I_U32 v) {
+    unsigned short w = NADINE_I_WREV2(unsigned short, v);
+    nadine_i_memcpy(p, &w, sizeof(w));
+}
+NADINE_I_FNS void nadine_i_storebe4(void *p, NADINE_I_U32 v) {
+    v = NADINE_I_WREV4(NADINE_I_U32, v);
+    nadine_i_memcpy(p, &v, sizeof(v));
+}
+NADINE_I_FNS void nadine_i_storebe8(void *p, NADINE_I_U64 v) {
+    v = NADINE_I_WREV8(NADINE_I_U64, v);
+    nadine_i_memcpy(p, &v, sizeof(v));
+}
+#endif /* NADINE_I_MOVBE_MSVC */
+
+/* read/write a big-endian T of 2, 4 or 8 chars with MOVBE. x86 is always
+   little-endian, so big endian is exactly the reversed order */
+#define NADINE_I_MOVBE_READ(T, endian, s)                                      \
+    if ((endian) == NADINE_ENDIAN_BIG) {                                       \
+        switch (sizeof(T)) {                                                   \
+            case 2: NADINE_I_STAT(NADINE_PATH_SWAP);                           \
+                    return (T)nadine_i_loadbe2(s);                             \
+            case 4: NADINE_I_STAT(NADINE_PATH_SWAP);                           \
+                    return (T)nadine_i_loadbe4(s);                             \
+            case 8: NADINE_I_STAT(NADINE_PATH_SWAP);                           \
+                    return (T)nadine_i_loadbe8(s);                             \
+        }                                                                      \
+    }
+#define NADINE_I_MOVBE_WRITE(T, endian, d, v)                                  \
+    if ((endian) == NADINE_ENDIAN_BIG) {                                       \
+        switch (sizeof(T)) {                                                   \
+            case 2: NADINE_I_STAT(NADINE_PATH_SWAP);                           \
+                    nadine_i_storebe2(d, (NADINE_I_U32)(v));                   \
+                    return;                                                    \
+            case 4: NADINE_I_STAT(NADINE_PATH_SWAP);                           \
+                    nadine_i_storebe4(d, (NADINE_I_U32)(v));                   \
+                    return;                                                    \
+            case 8: NADINE_I_STAT(NADINE_PATH_SWAP);                           \
+                    nadine_i_storebe8(d, (NADINE_I_U64)(v));                   \
+                    return;                                                    \
+        }                                                                      \
+    }
+#else
+#define NADINE_I_MOVBE_READ(T, endian, s)
+#define NADINE_I_MOVBE_WRITE(T, endian, d, v)
+#endif /* NADINE_I_MOVBE */
+
+/* fused transformations of W-char values for XORed endians xf: reverse
+   (1), swap char pairs (2) or both (3). for 2 chars, swapping the pair is
+   reversing and doing both is nothing; for 4 chars, both is swapping the
+   16-bit halves, usually a single rotate */
+#ifdef NADINE_I_WREV4
+/* 0x00FF00FF... for type T */
+#define NADINE_I_PAIR_MASK(T) ((T)((T)~(T)0 / 0xFFFFU * 0xFFU))
+#define NADINE_I_WSWAP(T, x) ((T)(                                             \
+            (((T)(x) & NADINE_I_PAIR_MASK(T)) << 8U)                           \
+          | (((T)(x) >> 8U) & NADINE_I_PAIR_MASK(T))))
+#define NADINE_I_WROT4(T, x) ((T)(((T)(x) << 16U) | ((T)(x) >> 16U)))
+#define NADINE_I_WXF2(T, x, xf) ((xf) == 3 ? (T)(x) : NADINE_I_WREV2(T, x))
+#define NADINE_I_WXF4(T, x, xf) ((xf) == 1 ? NADINE_I_WREV4(T, x)              \
+                               : (xf) == 2 ? NADINE_I_WSWAP(T, x)              \
+                               :             NADINE_I_WROT4(T, x))
+#endif /* NADINE_I_WREV4 */
+#ifdef NADINE_I_WREV8
+#define NADINE_I_WXF8(T, x, xf) ((xf) == 1 ? NADINE_I_WREV8(T, x)              \
+                               : (xf) == 2 ? NADINE_I_WSWAP(T, x)              \
+                               :             NADINE_I_WSWAP(T,                 \
+                                                    NADINE_I_WREV8(T, x)))
+#endif /* NADINE_I_WREV8 */
+
+/* 16-char int: reverse both 8-char halves and exchange them. the shifts are
+   by half the width of T, so that they are valid for every T */
+#if defined(NADINE_I_WREV8) && defined(NADINE_I_U64) && NADINE_I_HAS_INT128
+#define NADINE_I_WREV16(T, x) ((T)(                                            \
+            ((T)NADINE_I_WREV8(NADINE_I_U64, (NADINE_I_U64)(x))                \
+                    << (sizeof(T) * CHAR_BIT / 2))                             \
+          | (T)NADINE_I_WREV8(NADINE_I_U64,                                    \
+                    (NADINE_I_U64)((T)(x) >> (sizeof(T) * CHAR_BIT / 2)))))
+#define NADINE_I_WXF16(T, x, xf) ((xf) == 1 ? NADINE_I_WREV16(T, x)            \
+                                : (xf) == 2 ? NADINE_I_WSWAP(T, x)             \
+                                :             NADINE_I_WSWAP(T,                \
+                                                    NADINE_I_WREV16(T, x)))
+#endif /* NADINE_I_WREV16 */
+
+/* SIMD kernels: copy array s[n] of size-char elements to d[n], transforming
+   every element for XORed endians xf (1, 2 or 3) in a single pass. d may be
+   equal to s, but may not otherwise overlap. return how many elements were
+   processed, from the start of the array */
+
+/* char k of an element of the result is char k ^ NADINE_I_SIMD_XOR of the
+   element in the source, since size is a power of two */
+#define NADINE_I_SIMD_XOR(size, xf)                                            \
+    ((((xf) & 1) ? (size) - 1 : 0) ^ (((xf) & 2) ? 1 : 0))
+
+/* set with nadine_set_nontemporal */
+static unsigned nadine_i_nontemporal = NADINE_NONTEMPORAL_AUTO;
+
+NADINE_I_FN void nadine_set_nontemporal(unsigned mode) {
+    nadine_i_nontemporal = mode;
+}
+
+#if NADINE_I_SIMD_SSE2
+/* no non-temporal stores: the kernels store with storeu from offset 0 */
+#define NADINE_I_NT_NONE ((size_t)-1)
+/* how far ahead of the loads to prefetch the source, in chars. into L2:
+   prefetchnta stops the hardware prefetchers from running ahead, which
+   made the loops several times slower */
+#define NADINE_I_NT_PREFETCH 1024
+
+/* whether a kernel copying bytes chars of size-char elements from b to a
+   should use non-temporal stores of align chars. if so, returns the offset
+   of the first aligned store, a multiple of size; one unaligned store at
+   offset 0 covers the chars before it. otherwise returns NADINE_I_NT_NONE */
+NADINE_I_FNS size_t nadine_i_nt_start(const unsigned char *a,
+                                      const unsigned char *b, size_t bytes,
+                                      size_t size, size_t align) {
+    size_t h;
+    if (a == b || nadine_i_nontemporal == NADINE_NONTEMPORAL_OFF
+                || (nadine_i_nontemporal == NADINE_NONTEMPORAL_AUTO
+                        && bytes < NADINE_NONTEMPORAL_MIN))
+        return NADINE_I_NT_NONE;
+    /* the integer value of a pointer is only used for its alignment */
+    h = (align - (size_t)a % align) % align;
+    return h % size || bytes < h + align ? NADINE_I_NT_NONE : h;
+}
+
+/* transform every element of v for XORed endians as in NADINE_I_SIMD_XOR.
+   no pshufb: swap 16-bit words first, then the chars within them */
+NADINE_I_FNS NADINE_I_TARGET("sse2")
+__m128i nadine_i_simd_xf_sse2(__m128i v, size_t x) {
+    if (x >> 1 == 1) {
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    } else if (x >> 1 >= 3) {
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        if (x >> 1 == 7)
+            v = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+    if (x & 1)
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    return v;
+}
+
+NADINE_I_FN NADINE_I_TARGET("sse2")
+size_t nadine_i_simd_rev_sse2(void *d, const void *s, size_t n, size_t size,
+                              unsigned xf) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)d;
+    const unsigned char *b = (const unsigned char *)s;
+    size_t i = 0, bytes = n * size, x, h;
+    if (size != 2 && size != 4 && size != 8 && size != 16) return 0;
+    x = NADINE_I_SIMD_XOR(size, xf);
+    h = nadine_i_nt_start(a, b, bytes, size, 16);
+    if (h != NADINE_I_NT_NONE) {
+        if (h) {
+            __m128i v = _mm_loadu_si128((const __m128i *)b);
+            _mm_storeu_si128((__m128i *)a, nadine_i_simd_xf_sse2(v, x));
+            i = h;
+        }
+        for (; i + 16 <= bytes; i += 16) {
+            __m128i v;
+            _mm_prefetch((const char *)(b + i + NADINE_I_NT_PREFETCH),
+                         _MM_HINT_T1);
+            v = _mm_loadu_si128((const __m128i *)(b + i));
+            _mm_stream_si128((__m128i *)(a + i), nadine_i_simd_xf_sse2(v, x));
+        }
+        _mm_sfence();
+        return i / size;
+    }
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(b + i));
+        _mm_storeu_si128((__m128i *)(a + i), nadine_i_simd_xf_sse2(v, x));
+    }
+    return i / size;
+}
+
+/* pshufb mask for transforming every size-char element for XORed endians
+   xf, or 0 if none */
+NADINE_I_FN NADINE_I_TARGET("sse2")
+int nadine_i_simd_rev_mask(__m128i *m, size_t size, unsigned xf) {
+    unsigned char k[16];
+    size_t j, x;
+    if (size != 2 && size != 4 && size != 8 && size != 16) return 0;
+    x = NADINE_I_SIMD_XOR(size, xf);
+    for (j = 0; j < 16; ++j) k[j] = (unsigned char)(j ^ x);
+    *m = _mm_loadu_si128((const __m128i *)k);
+    return 1;
+}
+#endif /* NADINE_I_SIMD_SSE2 */
+
+#if NADINE_I_SIMD_SSSE3
+NADINE_I_FN NADINE_I_TARGET("ssse3")
+size_t nadine_i_simd_rev_ssse3(void *d, const void *s, size_t n, size_t size,
+                               unsigned xf) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)d;
+    const unsigned char *b = (const unsigned char *)s;
+    size_t i = 0, bytes = n * size, h;
+    __m128i m;
+    if (!nadine_i_simd_rev_mask(&m, size, xf)) return 0;
+    h = nadine_i_nt_start(a, b, bytes, size, 16);
+    if (h != NADINE_I_NT_NONE) {
+        if (h) {
+            __m128i v = _mm_loadu_si128((const __m128i *)b);
+            _mm_storeu_si128((__m128i *)a, _mm_shuffle_epi8(v, m));
+            i = h;
+        }
+        for (; i + 16 <= bytes; i += 16) {
+            __m128i v;
+            _mm_prefetch((const char *)(b + i + NADINE_I_NT_PREFETCH),
+                         _MM_HINT_T1);
+            v = _mm_loadu_si128((const __m128i *)(b + i));
+            _mm_stream_si128((__m128i *)(a + i), _mm_shuffle_epi8(v, m));
+        }
+        _mm_sfence();
+        return i / size;
+    }
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(b + i));
+        v = _mm_shuffle_epi8(v, m);
+        _mm_storeu_si128((__m128i *)(a + i), v);
+    }
+    return i / size;
+}
+#endif /* NADINE_I_SIMD_SSSE3 */
+
+#if NADINE_I_SIMD_AVX2
+NADINE_I_FN NADINE_I_TARGET("avx2")
+size_t nadine_i_simd_rev_avx2(void *d, const void *s, size_t n, size_t size,
+                              unsigned xf) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)d;
+    const unsigned char *b = (const unsigned char *)s;
+    size_t i = 0, bytes = n * size, h;
+    __m128i m;
+    __m256i m2;
+    if (!nadine_i_simd_rev_mask(&m, size, xf)) return 0;
+    /* vpshufb shuffles within 128-bit lanes, so the same mask works */
+    m2 = _mm256_broadcastsi128_si256(m);
+    h = nadine_i_nt_start(a, b, bytes, size, 32);
+    if (h != NADINE_I_NT_NONE) {
+        if (h) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)b);
+            _mm256_storeu_si256((__m256i *)a, _mm256_shuffle_epi8(v, m2));
+            i = h;
+        }
+        for (; i + 32 <= bytes; i += 32) {
+            __m256i v;
+            _mm_prefetch((const char *)(b + i + NADINE_I_NT_PREFETCH),
+                         _MM_HINT_T1);
+            v = _mm256_loadu_si256((const __m256i *)(b + i));
+            _mm256_stream_si256((__m256i *)(a + i),
+                                _mm256_shuffle_epi8(v, m2));
+        }
+        _mm_sfence();
+    }
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(b + i));
+        v = _mm256_shuffle_epi8(v, m2);
+        _mm256_storeu_si256((__m256i *)(a + i), v);
+    }
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(b + i));
+        v = _mm_shuffle_epi8(v, m);
+        _mm_storeu_si128((__m128i *)(a + i), v);
+    }
+    return i / size;
+}
+#endif /* NADINE_I_SIMD_AVX2 */
+
+#if NADINE_I_SIMD_AVX512
+NADINE_I_FN NADINE_I_TARGET("avx512f,avx512bw")
+size_t nadine_i_simd_rev_avx512(void *d, const void *s, size_t n, size_t size,
+                                unsigned xf) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)d;
+    const unsigned char *b = (const unsigned char *)s;
+    size_t i = 0, bytes = n * size, h;
+    __m128i m;
+    __m512i m4;
+    if (!nadine_i_simd_rev_mask(&m, size, xf)) return 0;
+    m4 = _mm512_broadcast_i32x4(m);
+    h = nadine_i_nt_start(a, b, bytes, size, 64);
+    if (h != NADINE_I_NT_NONE) {
+        if (h) {
+            __m512i v = _mm512_loadu_si512((const void *)b);
+            _mm512_storeu_si512((void *)a, _mm512_shuffle_epi8(v, m4));
+            i = h;
+        }
+        for (; i + 64 <= bytes; i += 64) {
+            __m512i v;
+            _mm_prefetch((const char *)(b + i + NADINE_I_NT_PREFETCH),
+                         _MM_HINT_T1);
+            v = _mm512_loadu_si512((const void *)(b + i));
+            _mm512_stream_si512((__m512i *)(a + i),
+                                _mm512_shuffle_epi8(v, m4));
+        }
+        _mm_sfence();
+    }
+    for (; i + 64 <= bytes; i += 64) {
+        __m512i v = _mm512_loadu_si512((const void *)(b + i));
+        v = _mm512_shuffle_epi8(v, m4);
+        _mm512_storeu_si512((void *)(a + i), v);
+    }
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(b + i));
+        v = _mm_shuffle_epi8(v, m);
+        _mm_storeu_si128((__m128i *)(a + i), v);
+    }
+    return i / size;
+}
+#endif /* NADINE_I_SIMD_AVX512 */
+
+#if NADINE_I_SIMD_NEON
+NADINE_I_FN
+size_t nadine_i_simd_rev_neon(void *d, const void *s, size_t n, size_t size,
+                              unsigned xf) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)d;
+    const unsigned char *b = (const unsigned char *)s;
+    size_t i = 0, bytes = n * size, x;
+    if (size != 2 && size != 4 && size != 8 && size != 16) return 0;
+    x = NADINE_I_SIMD_XOR(size, xf);
+    for (; i + 16 <= bytes; i += 16) {
+        uint8x16_t v = vld1q_u8(b + i);
+        /* swap 16-bit words first, then the chars within them */
+        if (x >> 1 == 1)
+            v = vreinterpretq_u8_u16(vrev32q_u16(vreinterpretq_u16_u8(v)));
+        else if (x >> 1 >= 3)
+            v = vreinterpretq_u8_u16(vrev64q_u16(vreinterpretq_u16_u8(v)));
+        if (x >> 1 == 7)
+            v = vextq_u8(v, v, 8);
+        if (x & 1)
+            v = vrev16q_u8(v);
+        vst1q_u8(a + i, v);
+    }
+    return i / size;
+}
+#endif /* NADINE_I_SIMD_NEON */
+
+/* SIMD record kernels: shuffle the first 16 chars of every record of p[n]
+   (records being stride chars apart) with the 16-char mask, which gives
+   the source index for every char. only records followed by at least 16
+   chars in p[bytes] are processed. return how many records were processed,
+   from the start of the array */
+#if NADINE_I_SIMD_SSSE3
+NADINE_I_FN NADINE_I_TARGET("ssse3")
+size_t nadine_i_simd_shuf_ssse3(void *p, size_t bytes, size_t stride,
+                                size_t n, const unsigned char *mask) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)p;
+    __m128i m = _mm_loadu_si128((const __m128i *)mask);
+    size_t i = 0, o = 0;
+    for (; i < n && o + 16 <= bytes; ++i, o += stride) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(a + o));
+        _mm_storeu_si128((__m128i *)(a + o), _mm_shuffle_epi8(v, m));
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_SSSE3 */
+
+#if NADINE_I_SIMD_NEON
+NADINE_I_FN
+size_t nadine_i_simd_shuf_neon(void *p, size_t bytes, size_t stride,
+                               size_t n, const unsigned char *mask) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)p;
+    uint8x16_t m = vld1q_u8(mask);
+    size_t i = 0, o = 0;
+    for (; i < n && o + 16 <= bytes; ++i, o += stride) {
+        uint8x16_t v = vld1q_u8(a + o);
+#if NADINE_I_ARCH_ARM64
+        v = vqtbl1q_u8(v, m);
+#else
+        uint8x8x2_t t;
+        t.val[0] = vget_low_u8(v);
+        t.val[1] = vget_high_u8(v);
+        v = vcombine_u8(vtbl2_u8(t, vget_low_u8(m)),
+                        vtbl2_u8(t, vget_high_u8(m)));
+#endif
+        vst1q_u8(a + o, v);
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_NEON */
+
+#if NADINE_DISPATCH
+/* pick the best kernel supported by this CPU and OS */
+NADINE_I_FN unsigned nadine_i_simd_detect(void) {
+#if defined(NADINE_KERNEL)
+    return NADINE_KERNEL;
+#elif NADINE_I_ARCH_X86 && defined(_MSC_VER)
+    int info[4];
+    unsigned __int64 xcr0 = 0;
+    int ecx1, edx1, ebx7 = 0;
+    __cpuid(info, 0);
+    if (info[0] < 1) return NADINE_KERNEL_SCALAR;
+    if (info[0] >= 7) {
+        __cpuidex(info, 7, 0);
+        ebx7 = info[1];
+    }
+    __cpuid(info, 1);
+    ecx1 = info[2];
+    edx1 = info[3];
+    /* OSXSAVE: check which register states the OS preserves */
+    if (ecx1 & (1 << 27)) xcr0 = _xgetbv(0);
+    /* AVX-512F, AVX-512BW, opmask/ZMM/YMM/XMM state */
+    if ((ebx7 & (1 << 16)) && (ebx7 & (1 << 30)) && (xcr0 & 0xE6) == 0xE6)
+        return NADINE_KERNEL_AVX512;
+    /* AVX2, YMM/XMM state */
+    if ((ebx7 & (1 << 5)) && (xcr0 & 0x6) == 0x6)
+        return NADINE_KERNEL_AVX2;
+    if (ecx1 & (1 << 9))
+        return NADINE_KERNEL_SSSE3;
+    if (edx1 & (1 << 26))
+        return NADINE_KERNEL_SSE2;
+    return NADINE_KERNEL_SCALAR;
+#elif NADINE_I_ARCH_X86
+    /* also checks that the OS preserves the wider registers */
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw"))
+        return NADINE_KERNEL_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return NADINE_KERNEL_AVX2;
+    if (__builtin_cpu_supports("ssse3"))
+        return NADINE_KERNEL_SSSE3;
+    if (__builtin_cpu_supports("sse2"))
+        return NADINE_KERNEL_SSE2;
+    return NADINE_KERNEL_SCALAR;
+#elif NADINE_I_ARCH_ARM64
+    /* HWCAP_ASIMD */
+    return (getauxval(AT_HWCAP) & (1UL << 1))
+            ? NADINE_KERNEL_NEON : NADINE_KERNEL_SCALAR;
+#else
+    /* HWCAP_NEON */
+    return (getauxval(AT_HWCAP) & (1UL << 12))
+            ? NADINE_KERNEL_NEON : NADINE_KERNEL_SCALAR;
+#endif
+}
+
+/* instruction sets used beside the array kernels, detected on their own:
+   a CPU (or a VM) may have AVX2 but not F16C, and NADINE_KERNEL may pin a
+   kernel regardless of what the CPU has */
+#define NADINE_I_FEATURE_F16C 1U
+#define NADINE_I_FEATURE_SSE42 2U
+
+/* the NADINE_I_FEATURE_* flags of this CPU and OS */
+NADINE_I_FN unsigned nadine_i_simd_detect_features(void) {
+#if NADINE_I_ARCH_X86 && defined(_MSC_VER)
+    int info[4];
+    unsigned __int64 xcr0 = 0;
+    unsigned features = 0;
+    __cpuid(info, 0);
+    if (info[0] < 1) return 0;
+    __cpuid(info, 1);
+    /* OSXSAVE, and the YMM/XMM state for the AVX registers F16C uses */
+    if (info[2] & (1 << 27)) xcr0 = _xgetbv(0);
+    if ((info[2] & (1 << 28)) && (info[2] & (1 << 29))
+            && (xcr0 & 0x6) == 0x6)
+        features |= NADINE_I_FEATURE_F16C;
+    if (info[2] & (1 << 20))
+        features |= NADINE_I_FEATURE_SSE42;
+    return features;
+#elif NADINE_I_ARCH_X86
+    unsigned a, b, c = 0, d, features = 0;
+    __builtin_cpu_init();
+    /* older compilers do not know "f16c"; "avx" checks the YMM state */
+    if (__builtin_cpu_supports("avx") && __get_cpuid(1, &a, &b, &c, &d)
+            && (c & (1U << 29)))
+        features |= NADINE_I_FEATURE_F16C;
+    if (__builtin_cpu_supports("sse4.2"))
+        features |= NADINE_I_FEATURE_SSE42;
+    return features;
+#else
+    return 0;
+#endif
+}
+
+typedef size_t (*nadine_i_simd_rev_fn)(void *d, const void *s,
+                                       size_t n, size_t size, unsigned xf);
+
+NADINE_I_FN size_t nadine_i_simd_rev_none(void *d, const void *s,
+                                          size_t n, size_t size, unsigned xf) {
+    (void)d, (void)s, (void)n, (void)size, (void)xf;
+    return 0;
+}
+
+NADINE_I_FN size_t nadine_i_simd_rev_resolve(void *d, const void *s,
+                                             size_t n, size_t size,
+                                             unsigned xf);
+
+/* resolved on first use, or by nadine_init. threads resolving at once
+   store the same values; with GCC and Clang atomics, the function is
+   stored last with release semantics, so that a thread which loads it
+   also sees the kernel. elsewhere (MSVC, on x86) the plain stores of
+   aligned words are not torn, and x86 keeps them in order */
+#if defined(__ATOMIC_RELEASE)
+#define NADINE_I_LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define NADINE_I_STORE_RELEASE(x, v) __atomic_store_n(&(x), v, __ATOMIC_RELEASE)
+#else
+#define NADINE_I_LOAD_ACQUIRE(x) (x)
+#define NADINE_I_STORE_RELEASE(x, v) ((x) = (v))
+#endif
+static unsigned nadine_i_simd_kernel = NADINE_KERNEL_SCALAR;
+static unsigned nadine_i_simd_feature_flags = 0;
+static nadine_i_simd_rev_fn nadine_i_simd_rev_ptr = &nadine_i_simd_rev_resolve;
+
+NADINE_I_FN size_t nadine_i_simd_rev_resolve(void *d, const void *s,
+                                             size_t n, size_t size,
+                                             unsigned xf) {
+    unsigned kernel = nadine_i_simd_detect();
+    nadine_i_simd_rev_fn fn = &nadine_i_simd_rev_none;
+    switch (kernel) {
+#if NADINE_I_SIMD_SSE2
+    case NADINE_KERNEL_SSE2:    fn = &nadine_i_simd_rev_sse2;   break;
+    case NADINE_KERNEL_SSSE3:   fn = &nadine_i_simd_rev_ssse3;  break;
+    case NADINE_KERNEL_AVX2:    fn = &nadine_i_simd_rev_avx2;   break;
+    case NADINE_KERNEL_AVX512:  fn = &nadine_i_simd_rev_avx512; break;
+#endif
+#if NADINE_I_SIMD_NEON
+    case NADINE_KERNEL_NEON:    fn = &nadine_i_simd_rev_neon;   break;
+#endif
+    default:                    kernel = NADINE_KERNEL_SCALAR;  break;
+    }
+    NADINE_I_STORE_RELEASE(nadine_i_simd_kernel, kernel);
+    NADINE_I_STORE_RELEASE(nadine_i_simd_feature_flags,
+                           nadine_i_simd_detect_features());
+    NADINE_I_STORE_RELEASE(nadine_i_simd_rev_ptr, fn);
+    return fn(d, s, n, size, xf);
+}
+
+NADINE_I_FN size_t nadine_i_simd_rev(void *d, const void *s, size_t n,
+                                     size_t size, unsigned xf) {
+    return NADINE_I_LOAD_ACQUIRE(nadine_i_simd_rev_ptr)(d, s, n, size, xf);
+}
+
+NADINE_I_FN unsigned nadine_simd_kernel(void) {
+    if (NADINE_I_LOAD_ACQUIRE(nadine_i_simd_rev_ptr)
+            == &nadine_i_simd_rev_resolve)
+        nadine_i_simd_rev_resolve(NULL, NULL, 0, 1, 1);
+    return NADINE_I_LOAD_ACQUIRE(nadine_i_simd_kernel);
+}
+
+/* the NADINE_I_FEATURE_* flags, resolved with the kernel */
+NADINE_I_FNS unsigned nadine_i_simd_features(void) {
+    (void)nadine_simd_kernel();
+    return NADINE_I_LOAD_ACQUIRE(nadine_i_simd_feature_flags);
+}
+
+#else /* NADINE_DISPATCH */
+
+#if NADINE_I_SIMD
+NADINE_I_FN size_t nadine_i_simd_rev(void *d, const void *s, size_t n,
+                                     size_t size, unsigned xf) {
+#if NADINE_I_KERNEL == NADINE_KERNEL_AVX512
+    return nadine_i_simd_rev_avx512(d, s, n, size, xf);
+#elif NADINE_I_KERNEL == NADINE_KERNEL_AVX2
+    return nadine_i_simd_rev_avx2(d, s, n, size, xf);
+#elif NADINE_I_KERNEL == NADINE_KERNEL_SSSE3
+    return nadine_i_simd_rev_ssse3(d, s, n, size, xf);
+#elif NADINE_I_KERNEL == NADINE_KERNEL_SSE2
+    return nadine_i_simd_rev_sse2(d, s, n, size, xf);
+#elif NADINE_I_KERNEL == NADINE_KERNEL_NEON
+    return nadine_i_simd_rev_neon(d, s, n, size, xf);
+#else
+    (void)d, (void)s, (void)n, (void)size, (void)xf;
+    return 0;
+#endif
+}
+#endif /* NADINE_I_SIMD */
+
+NADINE_I_FN unsigned nadine_simd_kernel(void) {
+    return NADINE_I_KERNEL;
+}
+
+#endif /* NADINE_DISPATCH */
+
+/* shuffle records with the record kernel for the kernel in use */
+#if NADINE_I_SIMD
+NADINE_I_FN size_t nadine_i_simd_shuf(void *p, size_t bytes, size_t stride,
+                                      size_t n, const unsigned char *mask) {
+#if NADINE_DISPATCH
+    switch (nadine_simd_kernel()) {
+#if NADINE_I_SIMD_SSSE3
+    case NADINE_KERNEL_SSSE3:
+    case NADINE_KERNEL_AVX2:
+    case NADINE_KERNEL_AVX512:
+        return nadine_i_simd_shuf_ssse3(p, bytes, stride, n, mask);
+#endif
+#if NADINE_I_SIMD_NEON
+    case NADINE_KERNEL_NEON:
+        return nadine_i_simd_shuf_neon(p, bytes, stride, n, mask);
+#endif
+    }
+    return 0;
+#elif NADINE_I_SIMD_SSSE3 && NADINE_I_KERNEL >= NADINE_KERNEL_SSSE3           \
+        && NADINE_I_KERNEL <= NADINE_KERNEL_AVX512
+    return nadine_i_simd_shuf_ssse3(p, bytes, stride, n, mask);
+#elif NADINE_I_SIMD_NEON && NADINE_I_KERNEL == NADINE_KERNEL_NEON
+    return nadine_i_simd_shuf_neon(p, bytes, stride, n, mask);
+#else
+    (void)p, (void)bytes, (void)stride, (void)n, (void)mask;
+    return 0;
+#endif
+}
+#endif /* NADINE_I_SIMD */
+
+/* reverse 8-char words at a time in nadine_i_memrev. only worth it if
+   memcpy is the real one, which compilers turn into plain loads/stores */
+#if defined(NADINE_I_WREV8) && defined(NADINE_I_U64) && NADINE_MEMCPY
+#define NADINE_I_MEMREV_WORDS 1
+#else
+#define NADINE_I_MEMREV_WORDS 0
+#endif
+
 /* reverse unsigned char array p[n] */
 NADINE_I_FN void nadine_i_memrev(void *p, size_t n) {
     /* cast for C++ compatibility */
@@ -486,6 +2098,25 @@ NADINE_I_FN void nadine_i_memrev(void *p, size_t n) {
         return;
     }
 
+#if NADINE_I_MEMREV_WORDS
+    /* reverse whole 8-char words from both ends, exchanging them, until
+       there are less than two words left in the middle */
+    b = &a[n];
+    while (b - a >= 16) {
+        NADINE_I_U64 x, y;
+        b -= 8;
+        nadine_i_memcpy(&x, a, 8);
+        nadine_i_memcpy(&y, b, 8);
+        x = NADINE_I_WREV8(NADINE_I_U64, x);
+        y = NADINE_I_WREV8(NADINE_I_U64, y);
+        nadine_i_memcpy(a, &y, 8);
+        nadine_i_memcpy(b, &x, 8);
+        a += 8;
+    }
+    if (a == b) return;
+    n = (size_t)(b - a);
+#endif /* NADINE_I_MEMREV_WORDS */
+
     b = &a[n - 1];
     while (a < b) {
         NADINE_I_BSWAP(*a, *b);
@@ -504,12 +2135,59 @@ NADINE_I_FN void nadine_i_byteswap(void *p, size_t n) {
     }
 }
 
-/* applies needed transformations for XORed endians xf */
-NADINE_I_FN void nadine_i_xform(void *p, size_t n, unsigned xf) {
-    if (xf & 1) nadine_i_memrev(p, n);
-    if (xf & 2) nadine_i_byteswap(p, n);
+/* reverses the order of the char pairs in char array p[n], n even.
+   equal to nadine_i_memrev followed by nadine_i_byteswap, in one pass */
+NADINE_I_FN void nadine_i_pairrev(void *p, size_t n) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)p;
+    unsigned char *b = &a[n - 2];
+    while (a < b) {
+        NADINE_I_BSWAP(a[0], b[0]);
+        NADINE_I_BSWAP(a[1], b[1]);
+        a += 2, b -= 2;
+    }
+}
+
+/* applies needed transformations for XORed endians xf */
+NADINE_I_FN void nadine_i_xform(void *p, size_t n, unsigned xf) {
+    if (xf == 3 && !(n & 1)) {
+        nadine_i_pairrev(p, n);
+        return;
+    }
+    if (xf & 1) nadine_i_memrev(p, n);
+    if (xf & 2) nadine_i_byteswap(p, n);
+}
+
+/* the path nadine_convert_N takes for an unsigned integer type of size
+   chars and XORed endians xf */
+NADINE_I_FNS unsigned nadine_i_path(unsigned xf, size_t size) {
+    if (!xf || size == 1)
+        return NADINE_PATH_NATIVE;
+#if CHAR_BIT == 8
+    if (xf <= 3) {
+        if (size == 2 || size == 4)
+            return NADINE_PATH_SWAP;
+#ifdef NADINE_I_WREV8
+        if (size == 8)
+            return NADINE_PATH_SWAP;
+#endif
+#ifdef NADINE_I_WREV16
+        if (size == 16)
+            return NADINE_PATH_SWAP;
+#endif
+    }
+#endif /* CHAR_BIT == 8 */
+    return NADINE_PATH_XFORM;
 }
 
+#if NADINE_STATS
+/* calls per path, see nadine_get_stats */
+static unsigned long nadine_i_stats[NADINE_PATHS];
+#define NADINE_I_STAT(path) (void)(++nadine_i_stats[path])
+#else
+#define NADINE_I_STAT(path) (void)0
+#endif /* NADINE_STATS */
+
 #else
 
 #if !NADINE_MEMCPY
@@ -518,16 +2196,504 @@ extern void nadine_i_memcpy(void *p, const void *s, size_t n);
 
 extern void nadine_i_memrev(void *p, size_t n);
 extern void nadine_i_byteswap(void *p, size_t n);
+extern void nadine_i_pairrev(void *p, size_t n);
 extern void nadine_i_xform(void *p, size_t n, unsigned xf);
 
+#if NADINE_I_SIMD
+extern size_t nadine_i_simd_rev(void *d, const void *s, size_t n,
+                                size_t size, unsigned xf);
+#endif /* NADINE_I_SIMD */
+
+extern unsigned nadine_simd_kernel(void);
+extern void nadine_set_nontemporal(unsigned mode);
+
 #endif /* #if NADINE_STATIC || NADINE_IMPL */
 
+#if !NADINE_I_SIMD
+/* no SIMD: process no elements, leave everything to the scalar code */
+#define nadine_i_simd_rev(d, s, n, size, xf) ((size_t)0)
+#define nadine_i_simd_shuf(p, bytes, stride, n, mask) ((size_t)0)
+#endif /* !NADINE_I_SIMD */
+
+#ifdef NADINE_I_WREV8
+#define NADINE_I_MAYBE_WXF8(T, x, xf) return NADINE_I_WXF8(T, x, xf)
+#else /* NADINE_I_WREV8 */
+#define NADINE_I_MAYBE_WXF8(T, x, xf) 
+#endif /* NADINE_I_WREV8 */
+
+/* switch case for 8-char types, if we have NADINE_I_WREV8 */
 #ifdef NADINE_I_WREV8
-#define NADINE_I_MAYBE_WREV8(T, x) return NADINE_I_WREV8(T, x)
+#define NADINE_I_MAYBE_CASE8(x) case 8: x; return
 #else /* NADINE_I_WREV8 */
-#define NADINE_I_MAYBE_WREV8(T, x) 
+#define NADINE_I_MAYBE_CASE8(x) default: break
 #endif /* NADINE_I_WREV8 */
 
+/* the same for 16-char types, if we have NADINE_I_WREV16 */
+#ifdef NADINE_I_WREV16
+#define NADINE_I_MAYBE_WXF16(T, x, xf) return NADINE_I_WXF16(T, x, xf)
+#define NADINE_I_MAYBE_CASE16(x) case 16: x; return
+#else /* NADINE_I_WREV16 */
+#define NADINE_I_MAYBE_WXF16(T, x, xf) 
+#define NADINE_I_MAYBE_CASE16(x) 
+#endif /* NADINE_I_WREV16 */
+
+/* transform the rest of the array p[i..n) of W-char values of type T
+   for XORed endians xf (1, 2 or 3), with a loop for each xf */
+#define NADINE_I_WXF_ARRAY_LOOP(W, T, p, i, n, xf)                             \
+    for (; i < n; ++i) p[i] = NADINE_I_WXF##W(T, p[i], xf)
+#define NADINE_I_WXF_ARRAY(W, T, p, i, n, xf)                                  \
+    switch (xf) {                                                              \
+        case 1: NADINE_I_WXF_ARRAY_LOOP(W, T, p, i, n, 1); break;              \
+        case 2: NADINE_I_WXF_ARRAY_LOOP(W, T, p, i, n, 2); break;              \
+        case 3: NADINE_I_WXF_ARRAY_LOOP(W, T, p, i, n, 3); break;              \
+    }
+
+/* copy the rest of the char array s[i..n) of W-char values of type T
+   to char array d[i..n), transforming every value for XORed endians xf
+   (1, 2 or 3). v is a T temporary */
+#define NADINE_I_WXF_COPY_LOOP(W, T, v, d, s, i, n, xf)                        \
+    for (; i < n; ++i) {                                                       \
+        nadine_i_memcpy(&v, &s[i * sizeof(T)], sizeof(T));                     \
+        v = NADINE_I_WXF##W(T, v, xf);                                         \
+        nadine_i_memcpy(&d[i * sizeof(T)], &v, sizeof(T));                     \
+    }
+#define NADINE_I_WXF_COPY(W, T, v, d, s, i, n, xf)                             \
+    switch (xf) {                                                              \
+        case 1: NADINE_I_WXF_COPY_LOOP(W, T, v, d, s, i, n, 1); break;         \
+        case 2: NADINE_I_WXF_COPY_LOOP(W, T, v, d, s, i, n, 2); break;         \
+        case 3: NADINE_I_WXF_COPY_LOOP(W, T, v, d, s, i, n, 3); break;         \
+    }
+
+/* array function for nadine_i_parallel: count values at s converted into d */
+typedef void (*nadine_i_copy_fn)(unsigned endian, void *d,
+                                 const void *s, size_t count);
+
+#if NADINE_THREADS
+
+/* see nadine_set_parallel_runner */
+typedef void (*nadine_parallel_task)(void *argument, unsigned index);
+typedef void (*nadine_parallel_runner)(void *context,
+                                       nadine_parallel_task task,
+                                       void *argument, unsigned count);
+
+#if NADINE_STATIC || NADINE_IMPL
+
+/* most threads used by one call */
+#define NADINE_I_MAX_THREADS 64
+/* chunks of the destination start at multiples of this, if possible */
+#define NADINE_I_CACHE_LINE 64
+
+/* a call to nadine_i_parallel, split into n chunks */
+typedef struct nadine_i_job {
+    nadine_i_copy_fn fn;
+    unsigned endian;
+    unsigned n;
+    unsigned char *d;
+    const unsigned char *s;
+    size_t size;
+    size_t count;
+    /* values before the first cache line boundary of d, values per cache
+       line and whole cache lines; chunks are split at cache lines */
+    size_t lead, unit, lines;
+} nadine_i_job;
+
+/* a thread running one chunk of a job */
+typedef struct nadine_i_worker {
+    nadine_i_job *job;
+    unsigned index;
+} nadine_i_worker;
+
+/* set with nadine_set_parallel_runner */
+static nadine_parallel_runner nadine_i_runner = NULL;
+static void *nadine_i_runner_context = NULL;
+
+NADINE_I_FN void nadine_set_parallel_runner(nadine_parallel_runner runner,
+                                            void *context) {
+    nadine_i_runner = runner;
+    nadine_i_runner_context = context;
+}
+
+/* first value of chunk i. the lines are spread evenly over the chunks, and
+   the last chunk also gets the values after the last whole line */
+NADINE_I_FNS size_t nadine_i_job_start(const nadine_i_job *j, unsigned i) {
+    const size_t q = j->lines / j->n, r = j->lines % j->n;
+    if (!i) return 0;
+    if (i == j->n) return j->count;
+    return j->lead + (q * i + (i < r ? i : r)) * j->unit;
+}
+
+NADINE_I_FNS void nadine_i_job_run(void *argument, unsigned i) {
+    /* cast for C++ compatibility */
+    const nadine_i_job *j = (const nadine_i_job *)argument;
+    const size_t b = nadine_i_job_start(j, i);
+    const size_t e = nadine_i_job_start(j, i + 1);
+    if (e > b)
+        j->fn(j->endian, j->d + b * j->size, j->s + b * j->size, e - b);
+}
+
+#if defined(_WIN32)
+NADINE_I_FNS DWORD WINAPI nadine_i_worker_main(LPVOID argument) {
+    const nadine_i_worker *w = (const nadine_i_worker *)argument;
+    nadine_i_job_run(w->job, w->index);
+    return 0;
+}
+#else
+NADINE_I_FNS void *nadine_i_worker_main(void *argument) {
+    const nadine_i_worker *w = (const nadine_i_worker *)argument;
+    nadine_i_job_run(w->job, w->index);
+    return NULL;
+}
+#endif
+
+NADINE_I_FNS unsigned nadine_i_cpu_count(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (unsigned)info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (unsigned)n : 1;
+#else
+    return 1;
+#endif
+}
+
+#if NADINE_THREADS_PIN && defined(_WIN32)
+/* the mask of the (i % n)th of the n CPUs in mask, which is not 0 */
+NADINE_I_FNS DWORD_PTR nadine_i_pin_mask(DWORD_PTR mask, unsigned i) {
+    DWORD_PTR m;
+    unsigned n = 0;
+    for (m = mask; m; m &= m - 1) ++n;
+    for (i %= n; i; --i) mask &= mask - 1;
+    return mask & (~mask + 1);
+}
+#elif NADINE_THREADS_PIN && defined(__linux__) && defined(_GNU_SOURCE)
+/* the (i % n)th of the n CPUs in allowed, which is not empty */
+NADINE_I_FNS int nadine_i_pin_cpu(const cpu_set_t *allowed, unsigned i) {
+    int cpu;
+    i %= (unsigned)CPU_COUNT(allowed);
+    for (cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, allowed) && !i--) break;
+    return cpu;
+}
+#endif
+
+/* run the chunks of a job on threads of our own and wait for them. chunk i
+   always goes to thread i, which is pinned to the i-th CPU the process may
+   run on if NADINE_THREADS_PIN, so that repeated calls over the same array
+   touch the same memory from the same CPU. if a thread cannot be started,
+   its chunk is run here */
+NADINE_I_FNS void nadine_i_job_threads(nadine_i_job *j) {
+    nadine_i_worker workers[NADINE_I_MAX_THREADS];
+#if defined(_WIN32)
+    HANDLE threads[NADINE_I_MAX_THREADS];
+#else
+    pthread_t threads[NADINE_I_MAX_THREADS];
+    int started[NADINE_I_MAX_THREADS];
+#endif
+    /* without pinning, this thread takes the first chunk */
+    const unsigned first = NADINE_THREADS_PIN ? 0 : 1;
+#if NADINE_THREADS_PIN && defined(_WIN32)
+    DWORD_PTR allowed, system;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &allowed, &system))
+        allowed = 0;
+#elif NADINE_THREADS_PIN && defined(__linux__) && defined(_GNU_SOURCE)
+    cpu_set_t allowed;
+    const int pin = !sched_getaffinity(0, sizeof(allowed), &allowed)
+                        && CPU_COUNT(&allowed) > 0;
+#endif
+    unsigned i;
+
+    for (i = first; i < j->n; ++i) {
+        workers[i].job = j;
+        workers[i].index = i;
+#if defined(_WIN32)
+        threads[i] = CreateThread(NULL, 0, &nadine_i_worker_main,
+                                  &workers[i], CREATE_SUSPENDED, NULL);
+        if (!threads[i]) {
+            nadine_i_job_run(j, i);
+            continue;
+        }
+#if NADINE_THREADS_PIN
+        if (allowed)
+            SetThreadAffinityMask(threads[i], nadine_i_pin_mask(allowed, i));
+#endif
+        ResumeThread(threads[i]);
+#else
+        {
+            pthread_attr_t *pattr = NULL;
+#if NADINE_THREADS_PIN && defined(__linux__) && defined(_GNU_SOURCE)
+            pthread_attr_t attr;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (pin && !pthread_attr_init(&attr)) {
+                CPU_SET(nadine_i_pin_cpu(&allowed, i), &set);
+                pattr = &attr;
+                (void)pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+            }
+#endif
+            started[i] = !pthread_create(&threads[i], pattr,
+                                         &nadine_i_worker_main, &workers[i]);
+            if (pattr) pthread_attr_destroy(pattr);
+        }
+        if (!started[i]) nadine_i_job_run(j, i);
+#endif
+    }
+
+    if (first) nadine_i_job_run(j, 0);
+
+    for (i = first; i < j->n; ++i) {
+#if defined(_WIN32)
+        if (threads[i]) {
+            WaitForSingleObject(threads[i], INFINITE);
+            CloseHandle(threads[i]);
+        }
+#else
+        if (started[i]) pthread_join(threads[i], NULL);
+#endif
+    }
+}
+
+/* run fn on count values of size chars at s into d (may be s) with up to
+   nthreads threads, or on this thread if the values are too few */
+NADINE_I_FN void nadine_i_parallel(nadine_i_copy_fn fn, unsigned endian,
+                                   void *d, const void *s, size_t size,
+                                   size_t count, unsigned nthreads) {
+    nadine_i_job j;
+    size_t max = count / (NADINE_PARALLEL_MIN / size + 1);
+
+    if (!nthreads) nthreads = nadine_i_cpu_count();
+    if (nthreads > NADINE_I_MAX_THREADS) nthreads = NADINE_I_MAX_THREADS;
+    if (nthreads > max) nthreads = (unsigned)max;
+    if (nthreads <= 1) {
+        fn(endian, d, s, count);
+        return;
+    }
+
+    j.fn = fn;
+    j.endian = endian;
+    j.n = nthreads;
+    /* casts for C++ compatibility */
+    j.d = (unsigned char *)d;
+    j.s = (const unsigned char *)s;
+    j.size = size;
+    j.count = count;
+    j.lead = 0;
+    j.unit = 1;
+    if (!(NADINE_I_CACHE_LINE % size)) {
+        /* the integer value of a pointer is only used for its alignment */
+        const size_t mis = (size_t)j.d % NADINE_I_CACHE_LINE;
+        j.unit = NADINE_I_CACHE_LINE / size;
+        if (mis && !((NADINE_I_CACHE_LINE - mis) % size))
+            j.lead = (NADINE_I_CACHE_LINE - mis) / size;
+    }
+    /* with a small NADINE_PARALLEL_MIN, there may be fewer whole lines than
+       threads, or none at all */
+    j.lines = count > j.lead ? (count - j.lead) / j.unit : 0;
+    if (j.lines < j.n) {
+        if (j.lines <= 1) {
+            fn(endian, d, s, count);
+            return;
+        }
+        j.n = (unsigned)j.lines;
+    }
+
+    if (nadine_i_runner)
+        nadine_i_runner(nadine_i_runner_context, &nadine_i_job_run,
+                        &j, j.n);
+    else
+        nadine_i_job_threads(&j);
+}
+
+#else /* NADINE_STATIC || NADINE_IMPL */
+
+extern void nadine_set_parallel_runner(nadine_parallel_runner runner,
+                                       void *context);
+extern void nadine_i_parallel(nadine_i_copy_fn fn, unsigned endian,
+                              void *d, const void *s, size_t size,
+                              size_t count, unsigned nthreads);
+
+#endif /* NADINE_STATIC || NADINE_IMPL */
+
+/* parallel array functions, through nadine_i_parallel */
+#define NADINE_I_IMPL_PAR(T, N)                                                \
+    NADINE_I_FNS void nadine_i_par_convert_##N(unsigned endian, void *d,       \
+                                               const void *s, size_t count) {  \
+        (void)s;                                                               \
+        /* cast for C++ compatibility */                                       \
+        nadine_convert_array_##N(endian, (T *)d, count);                       \
+    }                                                                          \
+    NADINE_I_FNS void nadine_i_par_read_##N(unsigned endian, void *d,          \
+                                            const void *s, size_t count) {     \
+        nadine_read_array_##N(endian, (T *)d, s, count);                       \
+    }                                                                          \
+    NADINE_I_FNS void nadine_i_par_write_##N(unsigned endian, void *d,         \
+                                             const void *s, size_t count) {    \
+        nadine_write_array_##N(endian, d, (const T *)s, count);                \
+    }                                                                          \
+    NADINE_I_FNS void nadine_convert_array_parallel_##N(unsigned endian,       \
+                                                        T *p, size_t count,    \
+                                                        unsigned nthreads) {   \
+        nadine_i_parallel(&nadine_i_par_convert_##N, endian, p, p,             \
+                          sizeof(T), count, nthreads);                         \
+    }                                                                          \
+    NADINE_I_FNS void nadine_read_array_parallel_##N(unsigned endian,          \
+                                                     T *destination,           \
+                                                     const void *source,       \
+                                                     size_t count,             \
+                                                     unsigned nthreads) {      \
+        nadine_i_parallel(&nadine_i_par_read_##N, endian, destination,         \
+                          source, sizeof(T), count, nthreads);                 \
+    }                                                                          \
+    NADINE_I_FNS void nadine_write_array_parallel_##N(unsigned endian,         \
+                                                      void *destination,       \
+                                                      const T *source,         \
+                                                      size_t count,            \
+                                                      unsigned nthreads) {     \
+        nadine_i_parallel(&nadine_i_par_write_##N, endian, destination,        \
+                          source, sizeof(T), count, nthreads);                 \
+    }
+
+#else /* NADINE_THREADS */
+
+#define NADINE_I_IMPL_PAR(T, N)
+
+#endif /* NADINE_THREADS */
+
+/* sequential reader/writer over a char buffer */
+typedef struct nadine_cursor {
+    unsigned char *base;    /* start of the buffer */
+    unsigned char *pos;     /* current position */
+    unsigned char *end;     /* end of the buffer */
+    unsigned endian;        /* endianness of the values */
+} nadine_cursor;
+
+NADINE_I_FNS void nadine_cursor_init(nadine_cursor *c, const void *buffer,
+                                     size_t size, unsigned endian) {
+    /* cast for C++ compatibility */
+    c->base = c->pos = (unsigned char *)buffer;
+    c->end = c->base + size;
+    c->endian = endian;
+}
+
+NADINE_I_FNS size_t nadine_cursor_tell(const nadine_cursor *c) {
+    return (size_t)(c->pos - c->base);
+}
+
+NADINE_I_FNS size_t nadine_cursor_remaining(const nadine_cursor *c) {
+    return (size_t)(c->end - c->pos);
+}
+
+NADINE_I_FNS int nadine_cursor_require(const nadine_cursor *c, size_t n) {
+    return (size_t)(c->end - c->pos) >= n;
+}
+
+NADINE_I_FNS void nadine_cursor_skip(nadine_cursor *c, size_t n) {
+    c->pos += n;
+}
+
+/* buffer segment for nadine_iowriter */
+#if NADINE_SYS_UIO
+typedef struct iovec nadine_iov;
+#else
+typedef struct nadine_iov {
+    void *iov_base;         /* start of the segment */
+    size_t iov_len;         /* size of the segment */
+} nadine_iov;
+#endif /* NADINE_SYS_UIO */
+
+/* sequential writer over a chain of segments */
+typedef struct nadine_iowriter {
+    nadine_cursor cursor;   /* over the current segment */
+    nadine_iov *segments;   /* all segments */
+    size_t count;           /* number of segments */
+    size_t index;           /* index of the current segment */
+    size_t done;            /* chars in the segments before the current */
+    int ok;                 /* zero if something did not fit */
+} nadine_iowriter;
+
+/* move the writer to segment i */
+NADINE_I_FNS void nadine_i_iowriter_seek(nadine_iowriter *w, size_t i) {
+    w->index = i;
+    if (i < w->count) {
+        nadine_cursor_init(&w->cursor, w->segments[i].iov_base,
+                           w->segments[i].iov_len, w->cursor.endian);
+    } else {
+        w->cursor.base = w->cursor.pos = w->cursor.end = NULL;
+    }
+}
+
+NADINE_I_FNS void nadine_iowriter_init(nadine_iowriter *w,
+                                       nadine_iov *segments, size_t count,
+                                       unsigned endian) {
+    w->segments = segments;
+    w->count = count;
+    w->done = 0;
+    w->ok = 1;
+    w->cursor.endian = endian;
+    nadine_i_iowriter_seek(w, 0);
+}
+
+NADINE_I_FNS void nadine_iowriter_put(nadine_iowriter *w, const void *data,
+                                      size_t n) {
+    /* cast for C++ compatibility */
+    const unsigned char *s = (const unsigned char *)data;
+    while (n) {
+        size_t k = nadine_cursor_remaining(&w->cursor);
+        if (!k) {
+            if (w->index + 1 >= w->count) {
+                w->ok = 0;
+                return;
+            }
+            w->done += nadine_cursor_tell(&w->cursor);
+            nadine_i_iowriter_seek(w, w->index + 1);
+            continue;
+        }
+        if (k > n) k = n;
+        nadine_i_memcpy(w->cursor.pos, s, k);
+        nadine_cursor_skip(&w->cursor, k);
+        s += k, n -= k;
+    }
+}
+
+NADINE_I_FNS int nadine_iowriter_ok(const nadine_iowriter *w) {
+    return w->ok;
+}
+
+NADINE_I_FNS size_t nadine_iowriter_tell(const nadine_iowriter *w) {
+    return w->done + nadine_cursor_tell(&w->cursor);
+}
+
+NADINE_I_FNS size_t nadine_iowriter_finish(nadine_iowriter *w) {
+    const size_t n = nadine_cursor_tell(&w->cursor);
+    if (!n) return w->index;
+    w->segments[w->index].iov_len = n;
+    return w->index + 1;
+}
+
+/* cursor read/write functions. no bounds checks, see nadine_cursor_require.
+   the writer functions write directly through the cursor if the value fits
+   in the current segment */
+#define NADINE_I_IMPL_CURSOR(T, N)                                             \
+    NADINE_I_FNS T nadine_cursor_read_##N(nadine_cursor *c) {                  \
+        T v = nadine_read_##N(c->endian, c->pos);                              \
+        c->pos += sizeof(T);                                                   \
+        return v;                                                              \
+    }                                                                          \
+    NADINE_I_FNS void nadine_cursor_write_##N(nadine_cursor *c, T value) {     \
+        nadine_write_##N(c->endian, c->pos, value);                            \
+        c->pos += sizeof(T);                                                   \
+    }                                                                          \
+    NADINE_I_FNS void nadine_iowriter_write_##N(nadine_iowriter *w, T value) { \
+        unsigned char b[sizeof(T)];                                            \
+        if (nadine_cursor_require(&w->cursor, sizeof(T))) {                    \
+            nadine_cursor_write_##N(&w->cursor, value);                        \
+            return;                                                            \
+        }                                                                      \
+        nadine_write_##N(w->cursor.endian, b, value);                          \
+        nadine_iowriter_put(w, b, sizeof(T));                                  \
+    }
+
 /* convert_from_, convert_to_ aliases */
 #define NADINE_I_IMPL_CVTAL(T, N)                                              \
     NADINE_I_FNS T nadine_convert_from_##N(unsigned endian, T value) {         \
@@ -597,16 +2763,20 @@ extern void nadine_i_xform(void *p, size_t n, unsigned xf);
 
 #endif /* NADINE_I_TYPE_PUN_UNIONS */
 
+/* value of a cached native endianness that has not been detected yet */
+#define NADINE_I_NATIVE_UNSET (UINT_MAX - 1)
+
 /* define native endianness detection function for integer type T */
 #ifdef NADINE_NATIVE_ENDIAN_INT
 #define NADINE_I_IMPL_NN_UI(T, N)                                              \
     NADINE_I_FN unsigned nadine_endian_native_##N(void) {                      \
         return (NADINE_NATIVE_ENDIAN_INT);                                     \
     }
+#define NADINE_I_IMPL_NN_SI(T, N, TU, NU) NADINE_I_IMPL_NN_UI(T, N)
 #define NADINE_I_NATIVE_INT(T, N) (NADINE_NATIVE_ENDIAN_INT)
 #else /* NADINE_NATIVE_ENDIAN_INT */
-#define NADINE_I_IMPL_NN_UI(T, N)                                              \
-    NADINE_I_FN unsigned nadine_endian_native_##N(void) {                      \
+#define NADINE_I_DETECT_NN_UI(T, N)                                            \
+    NADINE_I_FNS unsigned nadine_i_detect_native_##N(void) {                   \
         NADINE_I_MAKE_TYPE_PUNNER(pun, T);                                     \
         /* int value 1 will only have the lowest byte set in IEEE 754 */       \
         NADINE_I_TYPE_PUN(pun, T, (T)1);                                       \
@@ -620,22 +2790,49 @@ extern void nadine_i_xform(void *p, size_t n, unsigned xf);
             return NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS;                \
         return NADINE_ENDIAN_UNKNOWN;  /* unsupported */                       \
     }
+#if NADINE_NATIVE_ENDIAN_CACHE
+/* detect once, and keep the result in nadine_i_native_##N */
+#define NADINE_I_IMPL_NN_UI(T, N)                                              \
+    NADINE_I_DETECT_NN_UI(T, N)                                                \
+    static unsigned nadine_i_native_##N = NADINE_I_NATIVE_UNSET;               \
+    NADINE_I_FN unsigned nadine_endian_native_##N(void) {                      \
+        if (nadine_i_native_##N == NADINE_I_NATIVE_UNSET)                      \
+            nadine_i_native_##N = nadine_i_detect_native_##N();                \
+        return nadine_i_native_##N;                                            \
+    }
+#else /* NADINE_NATIVE_ENDIAN_CACHE */
+#define NADINE_I_IMPL_NN_UI(T, N)                                              \
+    NADINE_I_DETECT_NN_UI(T, N)                                                \
+    NADINE_I_FN unsigned nadine_endian_native_##N(void) {                      \
+        return nadine_i_detect_native_##N();                                   \
+    }
+#endif /* NADINE_NATIVE_ENDIAN_CACHE */
+/* a signed type has the same representation as its unsigned type */
+#define NADINE_I_IMPL_NN_SI(T, N, TU, NU)                                      \
+    NADINE_I_FN unsigned nadine_endian_native_##N(void) {                      \
+        return nadine_endian_native_##NU();                                    \
+    }
 #if NADINE_I_C99
 /* on C99 with compound literals, optimize big/little-endian cases */
 /* int value 1 will only have the lowest byte set in IEEE 754 */
-#define NADINE_I_UNION_PUN_INT(N)                                              \
+#define NADINE_I_UNION_PUN_INT(T)                                              \
         (((union { T v; unsigned char b[sizeof(T)]; }){ (T)1 }).b)
 #define NADINE_I_NATIVE_INT(T, N) (                                            \
         (NADINE_I_UNION_PUN_INT(T)[0])             ? NADINE_ENDIAN_LITTLE :    \
         (NADINE_I_UNION_PUN_INT(T)[sizeof(T) - 1]) ? NADINE_ENDIAN_BIG    :    \
         nadine_endian_native_##N())
+#elif NADINE_NATIVE_ENDIAN_CACHE == 2
+/* detected by nadine_init */
+#define NADINE_I_NATIVE_INT(T, N) (nadine_i_native_##N)
+#elif NADINE_NATIVE_ENDIAN_CACHE
+#define NADINE_I_NATIVE_INT(T, N) (                                            \
+        nadine_i_native_##N != NADINE_I_NATIVE_UNSET                           \
+            ? nadine_i_native_##N : nadine_endian_native_##N())
 #else /* NADINE_I_C99 */
 #define NADINE_I_NATIVE_INT(T, N) nadine_endian_native_##N()
 #endif /* NADINE_I_C99 */
 #endif /* NADINE_NATIVE_ENDIAN_INT */
 
-#define NADINE_I_IMPL_NN_SI(T, N, TU, NU) NADINE_I_IMPL_NN_UI(T, N)
-
 /* define native endianness detection function for floating-point type T */
 #ifdef NADINE_NATIVE_ENDIAN_FLOAT
 #define NADINE_I_IMPL_NN_F(T, N)                                               \
@@ -644,8 +2841,8 @@ extern void nadine_i_xform(void *p, size_t n, unsigned xf);
     }
 #define NADINE_I_NATIVE_FLOAT(T, N) (NADINE_NATIVE_ENDIAN_FLOAT)
 #else /* NADINE_NATIVE_ENDIAN_FLOAT */
-#define NADINE_I_IMPL_NN_F(T, N)                                               \
-    NADINE_I_FN unsigned nadine_endian_native_##N(void) {                      \
+#define NADINE_I_DETECT_NN_F(T, N)                                             \
+    NADINE_I_FNS unsigned nadine_i_detect_native_##N(void) {                   \
         NADINE_I_MAKE_TYPE_PUNNER(pun, T);                                     \
         /* float value 2.0 will only have the highest byte set in IEEE 754 */  \
         NADINE_I_TYPE_PUN(pun, T, (T)2.0f);                                    \
@@ -659,15 +2856,39 @@ extern void nadine_i_xform(void *p, size_t n, unsigned xf);
             return NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS;             \
         return NADINE_ENDIAN_UNKNOWN;  /* unsupported */                       \
     }
+#if NADINE_NATIVE_ENDIAN_CACHE
+/* detect once, and keep the result in nadine_i_native_##N */
+#define NADINE_I_IMPL_NN_F(T, N)                                               \
+    NADINE_I_DETECT_NN_F(T, N)                                                 \
+    static unsigned nadine_i_native_##N = NADINE_I_NATIVE_UNSET;               \
+    NADINE_I_FN unsigned nadine_endian_native_##N(void) {                      \
+        if (nadine_i_native_##N == NADINE_I_NATIVE_UNSET)                      \
+            nadine_i_native_##N = nadine_i_detect_native_##N();                \
+        return nadine_i_native_##N;                                            \
+    }
+#else /* NADINE_NATIVE_ENDIAN_CACHE */
+#define NADINE_I_IMPL_NN_F(T, N)                                               \
+    NADINE_I_DETECT_NN_F(T, N)                                                 \
+    NADINE_I_FN unsigned nadine_endian_native_##N(void) {                      \
+        return nadine_i_detect_native_##N();                                   \
+    }
+#endif /* NADINE_NATIVE_ENDIAN_CACHE */
 #if NADINE_I_C99
 /* on C99 with compound literals, optimize big/little-endian cases */
 /* float value 2.0 will only have the highest byte set in IEEE 754 */
-#define NADINE_I_UNION_PUN_FLOAT(N)                                            \
+#define NADINE_I_UNION_PUN_FLOAT(T)                                            \
         (((union { T v; unsigned char b[sizeof(T)]; }){ (T)2.0 }).b)
 #define NADINE_I_NATIVE_FLOAT(T, N) (                                          \
         (NADINE_I_UNION_PUN_FLOAT(T)[sizeof(T) - 1]) ? NADINE_ENDIAN_LITTLE :  \
         (NADINE_I_UNION_PUN_FLOAT(T)[0])             ? NADINE_ENDIAN_BIG    :  \
         nadine_endian_native_##N())
+#elif NADINE_NATIVE_ENDIAN_CACHE == 2
+/* detected by nadine_init */
+#define NADINE_I_NATIVE_FLOAT(T, N) (nadine_i_native_##N)
+#elif NADINE_NATIVE_ENDIAN_CACHE
+#define NADINE_I_NATIVE_FLOAT(T, N) (                                          \
+        nadine_i_native_##N != NADINE_I_NATIVE_UNSET                           \
+            ? nadine_i_native_##N : nadine_endian_native_##N())
 #else /* NADINE_I_C99 */
 #define NADINE_I_NATIVE_FLOAT(T, N) nadine_endian_native_##N()
 #endif /* NADINE_I_C99 */
@@ -676,22 +2897,23 @@ extern void nadine_i_xform(void *p, size_t n, unsigned xf);
 /* define conversion function for unsigned integer type T */
 #define NADINE_I_IMPL_CVT_UI(T, N)                                             \
     NADINE_I_FN T nadine_convert_##N(unsigned endian, T value) {               \
-        const unsigned native = NADINE_I_NATIVE_INT(T, N);                     \
+        const unsigned xf = NADINE_I_NATIVE_INT(T, N) ^ endian;                \
+        NADINE_I_STAT(nadine_i_path(xf, sizeof(T)));                           \
         /* special case #1 */                                                  \
-        if (native == endian || sizeof(T) == 1) return value;                  \
-        /* special case #2: only need to reverse */                            \
-        if ((native ^ endian) == 1 && CHAR_BIT == 8) {                         \
+        if (!xf || sizeof(T) == 1) return value;                               \
+        /* special case #2: reverse and/or swap char pairs on the value */     \
+        if (xf <= 3 && CHAR_BIT == 8) {                                        \
             switch (sizeof(T)) {                                               \
-                case 2: return NADINE_I_WREV2(T, value);                       \
-                case 4: return NADINE_I_WREV4(T, value);                       \
-                case 8: NADINE_I_MAYBE_WREV8(T, value);                        \
+                case 2: return NADINE_I_WXF2(T, value, xf);                    \
+                case 4: return NADINE_I_WXF4(T, value, xf);                    \
+                case 8: NADINE_I_MAYBE_WXF8(T, value, xf);                     \
+                case 16: NADINE_I_MAYBE_WXF16(T, value, xf);                   \
             }                                                                  \
         }                                                                      \
         {                                                                      \
             NADINE_I_MAKE_TYPE_PUNNER(pun, T);                                 \
             NADINE_I_TYPE_PUN(pun, T, value);                                  \
-            nadine_i_xform(NADINE_I_TYPE_ACCESS(pun), sizeof(T),               \
-                            native ^ endian);                                  \
+            nadine_i_xform(NADINE_I_TYPE_ACCESS(pun), sizeof(T), xf);          \
             NADINE_I_TYPE_UNPUN(pun, T, value);                                \
             return value;                                                      \
         }                                                                      \
@@ -713,12 +2935,106 @@ extern void nadine_i_xform(void *p, size_t n, unsigned xf);
     NADINE_I_FN T nadine_convert_##N(unsigned endian, T value) {               \
         const unsigned native = NADINE_I_NATIVE_FLOAT(T, N);                   \
         NADINE_I_MAKE_TYPE_PUNNER(pun, T);                                     \
+        NADINE_I_STAT(native ^ endian ? NADINE_PATH_XFORM                      \
+                                      : NADINE_PATH_NATIVE);                   \
         NADINE_I_TYPE_PUN(pun, T, value);                                      \
         nadine_i_xform(NADINE_I_TYPE_ACCESS(pun), sizeof(T), native ^ endian); \
         NADINE_I_TYPE_UNPUN(pun, T, value);                                    \
         return value;                                                          \
     }
 
+/* char order x for a TU value stored in memory that, for a T value,
+   would be in char order endian. conversions of T can then be done as ones
+   of TU with x, since only the order of the chars matters */
+#define NADINE_I_FLOAT_XENDIAN(T, N, TU, NU, endian)                           \
+    ((endian) ^ NADINE_I_NATIVE_FLOAT(T, N) ^ NADINE_I_NATIVE_INT(TU, NU))
+
+/* define conversion function for floating-point type T through
+   unsigned integer type TU of the same size */
+#define NADINE_I_IMPL_CVT_FI(T, N, TU, NU)                                     \
+    NADINE_I_FN T nadine_convert_##N(unsigned endian, T value) {               \
+        const unsigned x = NADINE_I_FLOAT_XENDIAN(T, N, TU, NU, endian);       \
+        NADINE_I_MAKE_TYPE_ALIASER(u, T, TU);                                  \
+        NADINE_I_TYPE_ALIAS_DO(u, T, TU, value);                               \
+        NADINE_I_TYPE_ALIASED(u) = nadine_convert_##NU(x,                      \
+                    NADINE_I_TYPE_ALIASED(u));                                 \
+        NADINE_I_TYPE_ALIAS_UNDO(u, T, TU, value);                             \
+        return value;                                                          \
+    }
+
+/* define array conversion function for unsigned integer type T */
+#define NADINE_I_IMPL_CVTA_UI(T, N)                                            \
+    NADINE_I_FN void nadine_convert_array_##N(unsigned endian, T *p,           \
+                                              size_t count) {                  \
+        const unsigned xf = NADINE_I_NATIVE_INT(T, N) ^ endian;                \
+        size_t i = 0;                                                          \
+        NADINE_I_STAT(nadine_i_path(xf, sizeof(T)));                           \
+        /* special case #1 */                                                  \
+        if (!xf || sizeof(T) == 1) return;                                     \
+        /* special case #2: reverse and/or swap char pairs in one pass */      \
+        if (xf <= 3 && CHAR_BIT == 8) {                                        \
+            i = nadine_i_simd_rev(p, p, count, sizeof(T), xf);                 \
+            switch (sizeof(T)) {                                               \
+                case 2: NADINE_I_WXF_ARRAY(2, T, p, i, count, xf); return;     \
+                case 4: NADINE_I_WXF_ARRAY(4, T, p, i, count, xf); return;     \
+                NADINE_I_MAYBE_CASE8(                                          \
+                        NADINE_I_WXF_ARRAY(8, T, p, i, count, xf));            \
+                NADINE_I_MAYBE_CASE16(                                         \
+                        NADINE_I_WXF_ARRAY(16, T, p, i, count, xf));           \
+            }                                                                  \
+        }                                                                      \
+        for (; i < count; ++i)                                                 \
+            nadine_i_xform(&p[i], sizeof(T), xf);                              \
+    }
+
+/* define array conversion function for signed integer type T with unsigned TU */
+#define NADINE_I_IMPL_CVTA_SI(T, N, TU, NU)                                    \
+    NADINE_I_FN void nadine_convert_array_##N(unsigned endian, T *p,           \
+                                              size_t count) {                  \
+        /* signed and unsigned variants of a type may alias each other */      \
+        nadine_convert_array_##NU(endian, (TU *)p, count);                     \
+    }
+
+/* define array conversion function for floating-point type T */
+#define NADINE_I_IMPL_CVTA_F(T, N)                                             \
+    NADINE_I_FN void nadine_convert_array_##N(unsigned endian, T *p,           \
+                                              size_t count) {                  \
+        const unsigned xf = NADINE_I_NATIVE_FLOAT(T, N) ^ endian;              \
+        size_t i = 0;                                                          \
+        NADINE_I_STAT(nadine_i_path(xf, sizeof(T)));                           \
+        if (!xf) return;                                                       \
+        if (xf <= 3 && CHAR_BIT == 8)                                          \
+            i = nadine_i_simd_rev(p, p, count, sizeof(T), xf);                 \
+        for (p += i; i < count; ++i, ++p)                                      \
+            nadine_i_xform(p, sizeof(T), xf);                                  \
+    }
+
+/* define array conversion function for floating-point type T through
+   unsigned integer type TU of the same size */
+#define NADINE_I_IMPL_CVTA_FI(T, N, TU, NU)                                    \
+    NADINE_I_FN void nadine_convert_array_##N(unsigned endian, T *p,           \
+                                              size_t count) {                  \
+        const unsigned xf = NADINE_I_NATIVE_FLOAT(T, N) ^ endian;              \
+        /* cast for C++ compatibility */                                       \
+        unsigned char *a = (unsigned char *)p;                                 \
+        size_t i = 0;                                                          \
+        TU v;                                                                  \
+        NADINE_I_STAT(nadine_i_path(xf, sizeof(T)));                           \
+        if (!xf) return;                                                       \
+        if (xf <= 3 && CHAR_BIT == 8) {                                        \
+            i = nadine_i_simd_rev(p, p, count, sizeof(T), xf);                 \
+            /* T cannot be accessed as TU; go through memcpy */                \
+            switch (sizeof(T)) {                                               \
+                case 4: NADINE_I_WXF_COPY(4, TU, v, a, a, i, count, xf);       \
+                        return;                                                \
+                NADINE_I_MAYBE_CASE8(                                          \
+                        NADINE_I_WXF_COPY(8, TU, v, a, a, i, count, xf));      \
+            }                                                                  \
+        }                                                                      \
+        for (p += i; i < count; ++i, ++p)                                      \
+            nadine_i_xform(p, sizeof(T), xf);                                  \
+    }
+
 /* use shift-based read/write only when inlining, or if on a bi-endian arch */
 #if defined(NADINE_I_INLINE) || NADINE_I_BIENDIAN
 #define NADINE_I_USE_SHIFT_RW 1
@@ -736,6 +3052,13 @@ extern void nadine_i_xform(void *p, size_t n, unsigned xf);
         const unsigned char *src = (const unsigned char *)s;                   \
         size_t i, n = sizeof(T);                                               \
         T v = 0;                                                               \
+        /* too many shifts for 16-char types; convert the value instead */     \
+        if (n > 8) {                                                           \
+            nadine_i_memcpy(&v, s, n);                                         \
+            return nadine_convert_##N(endian, v);                              \
+        }                                                                      \
+        NADINE_I_MOVBE_READ(T, endian, s)                                      \
+        NADINE_I_STAT(NADINE_PATH_SHIFT);                                      \
         for (i = 0; i < n; ++i)                                                \
             v |= (T)(src[NADINE_I_INDEX(endian, i)]) << (CHAR_BIT * i);        \
         return v;                                                              \
@@ -744,37 +3067,115 @@ extern void nadine_i_xform(void *p, size_t n, unsigned xf);
         /* cast for C++ compatibility */                                       \
         unsigned char *dst = (unsigned char *)d;                               \
         size_t i, n = sizeof(T);                                               \
+        if (n > 8) {                                                           \
+            v = nadine_convert_##N(endian, v);                                 \
+            nadine_i_memcpy(d, &v, n);                                         \
+            return;                                                            \
+        }                                                                      \
+        NADINE_I_MOVBE_WRITE(T, endian, d, v)                                  \
+        NADINE_I_STAT(NADINE_PATH_SHIFT);                                      \
         for (i = 0; i < n; ++i)                                                \
             dst[NADINE_I_INDEX(endian, i)] =                                   \
                         (unsigned char)(v >> (CHAR_BIT * i));                  \
     }
 #else
+/* copy the value as is and convert it, to use the fused transformations */
 #define NADINE_I_IMPL_RW_UI(T, N)                                              \
     NADINE_I_FN T nadine_read_##N(unsigned endian, const void *s) {            \
-        const unsigned native = NADINE_I_NATIVE_INT(T, N);                     \
         T v;                                                                   \
-        NADINE_I_MAKE_TYPE_PUNNER(p, T);                                       \
-        nadine_i_memcpy(NADINE_I_TYPE_ACCESS(p), s, sizeof(T));                \
-        nadine_i_xform(NADINE_I_TYPE_ACCESS(p), sizeof(T), native ^ endian);   \
-        NADINE_I_TYPE_UNPUN(p, T, v);                                          \
-        return v;                                                              \
+        NADINE_I_MOVBE_READ(T, endian, s)                                      \
+        nadine_i_memcpy(&v, s, sizeof(T));                                     \
+        return nadine_convert_##N(endian, v);                                  \
     }                                                                          \
     NADINE_I_FN void nadine_write_##N(unsigned endian, void *d, T v) {         \
-        const unsigned native = NADINE_I_NATIVE_INT(T, N);                     \
-        NADINE_I_MAKE_TYPE_PUNNER(p, T);                                       \
-        NADINE_I_TYPE_PUN(p, T, v);                                            \
-        nadine_i_xform(NADINE_I_TYPE_ACCESS(p), sizeof(T), native ^ endian);   \
-        nadine_i_memcpy(d, NADINE_I_TYPE_ACCESS(p), sizeof(T));                \
+        NADINE_I_MOVBE_WRITE(T, endian, d, v)                                  \
+        v = nadine_convert_##N(endian, v);                                     \
+        nadine_i_memcpy(d, &v, sizeof(T));                                     \
     }
 #endif
 
+#if NADINE_I_USE_SHIFT_RW
+/* shifting into the sign bit is undefined; go through the unsigned type */
+#define NADINE_I_IMPL_RW_SI(T, N, TU, NU)                                      \
+    NADINE_I_FN T nadine_read_##N(unsigned endian, const void *s) {            \
+        T v;                                                                   \
+        NADINE_I_MAKE_TYPE_ALIASER(u, T, TU);                                  \
+        NADINE_I_TYPE_ALIASED(u) = nadine_read_##NU(endian, s);                \
+        NADINE_I_TYPE_ALIAS_UNDO(u, T, TU, v);                                 \
+        return v;                                                              \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_##N(unsigned endian, void *d, T v) {         \
+        NADINE_I_MAKE_TYPE_ALIASER(u, T, TU);                                  \
+        NADINE_I_TYPE_ALIAS_DO(u, T, TU, v);                                   \
+        nadine_write_##NU(endian, d, NADINE_I_TYPE_ALIASED(u));                \
+    }
+#else
 #define NADINE_I_IMPL_RW_SI(T, N, TU, NU) NADINE_I_IMPL_RW_UI(T, N)
+#endif
+
+/* define array read/write functions for unsigned integer type T */
+#define NADINE_I_IMPL_RWA_UI(T, N)                                             \
+    NADINE_I_FN void nadine_i_copy_array_##N(unsigned endian, void *d,         \
+                                             const void *s, size_t count) {    \
+        const unsigned xf = NADINE_I_NATIVE_INT(T, N) ^ endian;                \
+        /* cast for C++ compatibility */                                       \
+        unsigned char *dst = (unsigned char *)d;                               \
+        const unsigned char *src = (const unsigned char *)s;                   \
+        size_t i = 0;                                                          \
+        T v;                                                                   \
+        NADINE_I_STAT(nadine_i_path(xf, sizeof(T)));                           \
+        /* special case #1 */                                                  \
+        if (!xf || sizeof(T) == 1) {                                           \
+            nadine_i_memcpy(d, s, count * sizeof(T));                          \
+            return;                                                            \
+        }                                                                      \
+        /* special case #2: reverse and/or swap char pairs in one pass */      \
+        if (xf <= 3 && CHAR_BIT == 8) {                                        \
+            i = nadine_i_simd_rev(d, s, count, sizeof(T), xf);                 \
+            switch (sizeof(T)) {                                               \
+                case 2: NADINE_I_WXF_COPY(2, T, v, dst, src, i, count, xf);    \
+                        return;                                                \
+                case 4: NADINE_I_WXF_COPY(4, T, v, dst, src, i, count, xf);    \
+                        return;                                                \
+                NADINE_I_MAYBE_CASE8(                                          \
+                        NADINE_I_WXF_COPY(8, T, v, dst, src, i, count, xf));   \
+                NADINE_I_MAYBE_CASE16(                                         \
+                        NADINE_I_WXF_COPY(16, T, v, dst, src, i, count, xf));  \
+            }                                                                  \
+        }                                                                      \
+        for (; i < count; ++i) {                                               \
+            nadine_i_memcpy(&dst[i * sizeof(T)], &src[i * sizeof(T)],          \
+                            sizeof(T));                                        \
+            nadine_i_xform(&dst[i * sizeof(T)], sizeof(T), xf);                \
+        }                                                                      \
+    }                                                                          \
+    NADINE_I_FN void nadine_read_array_##N(unsigned endian, T *dst,            \
+                                           const void *src, size_t count) {    \
+        nadine_i_copy_array_##N(endian, dst, src, count);                      \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_array_##N(unsigned endian, void *dst,        \
+                                            const T *src, size_t count) {      \
+        nadine_i_copy_array_##N(endian, dst, src, count);                      \
+    }
+
+/* define array read/write functions for signed integer type T */
+#define NADINE_I_IMPL_RWA_SI(T, N, TU, NU)                                     \
+    NADINE_I_FN void nadine_read_array_##N(unsigned endian, T *dst,            \
+                                           const void *src, size_t count) {    \
+        nadine_i_copy_array_##NU(endian, dst, src, count);                     \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_array_##N(unsigned endian, void *dst,        \
+                                            const T *src, size_t count) {      \
+        nadine_i_copy_array_##NU(endian, dst, src, count);                     \
+    }
 
 #define NADINE_I_IMPL_RW_F(T, N)                                               \
     NADINE_I_FN T nadine_read_##N(unsigned endian, const void *s) {            \
         const unsigned native = NADINE_I_NATIVE_FLOAT(T, N);                   \
         T v;                                                                   \
         NADINE_I_MAKE_TYPE_PUNNER(p, T);                                       \
+        NADINE_I_STAT(native ^ endian ? NADINE_PATH_XFORM                      \
+                                      : NADINE_PATH_NATIVE);                   \
         nadine_i_memcpy(NADINE_I_TYPE_ACCESS(p), s, sizeof(T));                \
         nadine_i_xform(NADINE_I_TYPE_ACCESS(p), sizeof(T), native ^ endian);   \
         NADINE_I_TYPE_UNPUN(p, T, v);                                          \
@@ -783,46 +3184,281 @@ extern void nadine_i_xform(void *p, size_t n, unsigned xf);
     NADINE_I_FN void nadine_write_##N(unsigned endian, void *d, T v) {         \
         const unsigned native = NADINE_I_NATIVE_FLOAT(T, N);                   \
         NADINE_I_MAKE_TYPE_PUNNER(p, T);                                       \
+        NADINE_I_STAT(native ^ endian ? NADINE_PATH_XFORM                      \
+                                      : NADINE_PATH_NATIVE);                   \
         NADINE_I_TYPE_PUN(p, T, v);                                            \
         nadine_i_xform(NADINE_I_TYPE_ACCESS(p), sizeof(T), native ^ endian);   \
         nadine_i_memcpy(d, NADINE_I_TYPE_ACCESS(p), sizeof(T));                \
     }
 
+/* define array read/write functions for floating-point type T */
+#define NADINE_I_IMPL_RWA_F(T, N)                                              \
+    NADINE_I_FN void nadine_i_copy_array_##N(unsigned endian, void *d,         \
+                                             const void *s, size_t count) {    \
+        const unsigned xf = NADINE_I_NATIVE_FLOAT(T, N) ^ endian;              \
+        /* cast for C++ compatibility */                                       \
+        unsigned char *dst = (unsigned char *)d;                               \
+        const unsigned char *src = (const unsigned char *)s;                   \
+        size_t i = 0;                                                          \
+        NADINE_I_STAT(nadine_i_path(xf, sizeof(T)));                           \
+        if (!xf) {                                                             \
+            nadine_i_memcpy(d, s, count * sizeof(T));                          \
+            return;                                                            \
+        }                                                                      \
+        if (xf <= 3 && CHAR_BIT == 8)                                          \
+            i = nadine_i_simd_rev(d, s, count, sizeof(T), xf);                 \
+        for (; i < count; ++i) {                                               \
+            nadine_i_memcpy(&dst[i * sizeof(T)], &src[i * sizeof(T)],          \
+                            sizeof(T));                                        \
+            nadine_i_xform(&dst[i * sizeof(T)], sizeof(T), xf);                \
+        }                                                                      \
+    }                                                                          \
+    NADINE_I_FN void nadine_read_array_##N(unsigned endian, T *dst,            \
+                                           const void *src, size_t count) {    \
+        nadine_i_copy_array_##N(endian, dst, src, count);                      \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_array_##N(unsigned endian, void *dst,        \
+                                            const T *src, size_t count) {      \
+        nadine_i_copy_array_##N(endian, dst, src, count);                      \
+    }
 
-/* define the five basic functions for T when T is an unsigned integer type */
-#define NADINE_I_IMPL_UI(T, N)                                                 \
-    NADINE_I_IMPL_NN_UI(T, N)                                                  \
-    NADINE_I_IMPL_CVT_UI(T, N)                                                 \
-    NADINE_I_IMPL_CVTAL(T, N)                                                  \
-    NADINE_I_IMPL_RW_UI(T, N)
+/* define read/write functions for floating-point type T through
+   unsigned integer type TU of the same size */
+#define NADINE_I_IMPL_RW_FI(T, N, TU, NU)                                      \
+    NADINE_I_FN T nadine_read_##N(unsigned endian, const void *s) {            \
+        const unsigned x = NADINE_I_FLOAT_XENDIAN(T, N, TU, NU, endian);       \
+        T v;                                                                   \
+        NADINE_I_MAKE_TYPE_ALIASER(u, T, TU);                                  \
+        NADINE_I_TYPE_ALIASED(u) = nadine_read_##NU(x, s);                     \
+        NADINE_I_TYPE_ALIAS_UNDO(u, T, TU, v);                                 \
+        return v;                                                              \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_##N(unsigned endian, void *d, T v) {         \
+        const unsigned x = NADINE_I_FLOAT_XENDIAN(T, N, TU, NU, endian);       \
+        NADINE_I_MAKE_TYPE_ALIASER(u, T, TU);                                  \
+        NADINE_I_TYPE_ALIAS_DO(u, T, TU, v);                                   \
+        nadine_write_##NU(x, d, NADINE_I_TYPE_ALIASED(u));                     \
+    }
 
-/* define the five basic functions for T when T is a signed integer type */
-#define NADINE_I_IMPL_SI(T, N, TU, NU)                                         \
-    NADINE_I_IMPL_NN_SI(T, N, TU, NU)                                          \
-    NADINE_I_IMPL_CVT_SI(T, N, TU, NU)                                         \
-    NADINE_I_IMPL_CVTAL(T, N)                                                  \
-    NADINE_I_IMPL_RW_SI(T, N, TU, NU)
+/* define array read/write functions for floating-point type T through
+   unsigned integer type TU of the same size */
+#define NADINE_I_IMPL_RWA_FI(T, N, TU, NU)                                     \
+    NADINE_I_FN void nadine_read_array_##N(unsigned endian, T *dst,            \
+                                           const void *src, size_t count) {    \
+        nadine_i_copy_array_##NU(NADINE_I_FLOAT_XENDIAN(T, N, TU, NU, endian), \
+                                 dst, src, count);                             \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_array_##N(unsigned endian, void *dst,        \
+                                            const T *src, size_t count) {      \
+        nadine_i_copy_array_##NU(NADINE_I_FLOAT_XENDIAN(T, N, TU, NU, endian), \
+                                 dst, src, count);                             \
+    }
 
-/* define the five basic functions for T when T is a floating-point type */
-#define NADINE_I_IMPL_F(T, N)                                                  \
+/* define convert/read/write functions for T with a fixed endianness E,
+   named with the infix S. read and write copy the value as is and convert
+   it, so that with E known, the compiler sees a plain load/store + swap */
+#define NADINE_I_IMPL_FIXED_E(T, N, S, E)                                      \
+    NADINE_I_FN T nadine_convert_##S##_##N(T value) {                          \
+        return nadine_convert_##N(E, value);                                   \
+    }                                                                          \
+    NADINE_I_FN T nadine_read_##S##_##N(const void *s) {                       \
+        T v;                                                                   \
+        nadine_i_memcpy(&v, s, sizeof(T));                                     \
+        return nadine_convert_##N(E, v);                                       \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_##S##_##N(void *d, T v) {                    \
+        v = nadine_convert_##N(E, v);                                          \
+        nadine_i_memcpy(d, &v, sizeof(T));                                     \
+    }
+
+/* define read/write functions for T at addresses aligned for T: a plain
+   load/store + swap, through a type that may alias anything if possible */
+#define NADINE_I_IMPL_ALIGNED(T, N)                                            \
+    typedef T NADINE_I_MAY_ALIAS nadine_i_aliased_##N;                         \
+    NADINE_I_FN T nadine_read_aligned_##N(unsigned endian, const void *s) {    \
+        return nadine_convert_##N(endian, *(const nadine_i_aliased_##N *)s);   \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_aligned_##N(unsigned endian, void *d, T v) { \
+        *(nadine_i_aliased_##N *)d = nadine_convert_##N(endian, v);            \
+    }
+
+/* define fixed-endianness functions for T */
+#define NADINE_I_IMPL_FIXED(T, N)                                              \
+    NADINE_I_IMPL_FIXED_E(T, N, le, NADINE_ENDIAN_LITTLE)                      \
+    NADINE_I_IMPL_FIXED_E(T, N, be, NADINE_ENDIAN_BIG)                         \
+    NADINE_I_IMPL_FIXED_E(T, N, pdp,                                           \
+                          NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS)         \
+    NADINE_I_IMPL_FIXED_E(T, N, h316,                                          \
+                          NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS)
+
+/* define the basic functions for T when T is an unsigned integer type */
+#define NADINE_I_IMPL_UI(T, N)                                                 \
+    NADINE_I_IMPL_NN_UI(T, N)                                                  \
+    NADINE_I_IMPL_CVT_UI(T, N)                                                 \
+    NADINE_I_IMPL_CVTAL(T, N)                                                  \
+    NADINE_I_IMPL_CVTA_UI(T, N)                                                \
+    NADINE_I_IMPL_RW_UI(T, N)                                                  \
+    NADINE_I_IMPL_RWA_UI(T, N)                                                 \
+    NADINE_I_IMPL_FIXED(T, N)                                                  \
+    NADINE_I_IMPL_ALIGNED(T, N)                                                \
+    NADINE_I_IMPL_CURSOR(T, N)                                                 \
+    NADINE_I_IMPL_PAR(T, N)
+
+/* define the basic functions for T when T is a signed integer type */
+#define NADINE_I_IMPL_SI(T, N, TU, NU)                                         \
+    NADINE_I_IMPL_NN_SI(T, N, TU, NU)                                          \
+    NADINE_I_IMPL_CVT_SI(T, N, TU, NU)                                         \
+    NADINE_I_IMPL_CVTAL(T, N)                                                  \
+    NADINE_I_IMPL_CVTA_SI(T, N, TU, NU)                                        \
+    NADINE_I_IMPL_RW_SI(T, N, TU, NU)                                          \
+    NADINE_I_IMPL_RWA_SI(T, N, TU, NU)                                         \
+    NADINE_I_IMPL_FIXED(T, N)                                                  \
+    NADINE_I_IMPL_ALIGNED(T, N)                                                \
+    NADINE_I_IMPL_CURSOR(T, N)                                                 \
+    NADINE_I_IMPL_PAR(T, N)
+
+/* define the basic functions for T when T is a floating-point type */
+#define NADINE_I_IMPL_F(T, N)                                                  \
     NADINE_I_IMPL_NN_F(T, N)                                                   \
     NADINE_I_IMPL_CVT_F(T, N)                                                  \
     NADINE_I_IMPL_CVTAL(T, N)                                                  \
-    NADINE_I_IMPL_RW_F(T, N)
+    NADINE_I_IMPL_CVTA_F(T, N)                                                 \
+    NADINE_I_IMPL_RW_F(T, N)                                                   \
+    NADINE_I_IMPL_RWA_F(T, N)                                                  \
+    NADINE_I_IMPL_FIXED(T, N)                                                  \
+    NADINE_I_IMPL_ALIGNED(T, N)                                                \
+    NADINE_I_IMPL_CURSOR(T, N)                                                 \
+    NADINE_I_IMPL_PAR(T, N)
+
+/* define the basic functions for T when T is a floating-point type
+   with an unsigned integer type TU of the same size */
+#define NADINE_I_IMPL_FI(T, N, TU, NU)                                         \
+    NADINE_I_IMPL_NN_F(T, N)                                                   \
+    NADINE_I_IMPL_CVT_FI(T, N, TU, NU)                                         \
+    NADINE_I_IMPL_CVTAL(T, N)                                                  \
+    NADINE_I_IMPL_CVTA_FI(T, N, TU, NU)                                        \
+    NADINE_I_IMPL_RW_FI(T, N, TU, NU)                                          \
+    NADINE_I_IMPL_RWA_FI(T, N, TU, NU)                                         \
+    NADINE_I_IMPL_FIXED(T, N)                                                  \
+    NADINE_I_IMPL_ALIGNED(T, N)                                                \
+    NADINE_I_IMPL_CURSOR(T, N)                                                 \
+    NADINE_I_IMPL_PAR(T, N)
+
+/* define native endianness, conversion and read/write functions for T, a
+   struct of two words (lo, hi) of unsigned integer type TW. the words are
+   read and written in an order that depends only on the endianness, and
+   conversion is a read of the value as it is in memory */
+#define NADINE_I_IMPL_RW_W(T, N, TW, NW)                                       \
+    NADINE_I_FN unsigned nadine_endian_native_##N(void) {                      \
+        return nadine_endian_native_##NW();                                    \
+    }                                                                          \
+    NADINE_I_FN T nadine_read_##N(unsigned endian, const void *s) {            \
+        /* cast for C++ compatibility */                                       \
+        const unsigned char *src = (const unsigned char *)s;                   \
+        /* the high word comes first in big-endian orders */                   \
+        const size_t hi = (endian & 1) ? 0 : sizeof(TW);                       \
+        T v;                                                                   \
+        nadine_i_memcpy(&v.hi, &src[hi], sizeof(TW));                          \
+        nadine_i_memcpy(&v.lo, &src[sizeof(TW) - hi], sizeof(TW));             \
+        v.hi = nadine_convert_##NW(endian, v.hi);                              \
+        v.lo = nadine_convert_##NW(endian, v.lo);                              \
+        return v;                                                              \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_##N(unsigned endian, void *d, T v) {         \
+        /* cast for C++ compatibility */                                       \
+        unsigned char *dst = (unsigned char *)d;                               \
+        const size_t hi = (endian & 1) ? 0 : sizeof(TW);                       \
+        v.hi = nadine_convert_##NW(endian, v.hi);                              \
+        v.lo = nadine_convert_##NW(endian, v.lo);                              \
+        nadine_i_memcpy(&dst[hi], &v.hi, sizeof(TW));                          \
+        nadine_i_memcpy(&dst[sizeof(TW) - hi], &v.lo, sizeof(TW));             \
+    }                                                                          \
+    NADINE_I_FN T nadine_convert_##N(unsigned endian, T value) {               \
+        return nadine_read_##N(endian, &value);                                \
+    }
+
+/* define array functions for T, a struct of two words */
+#define NADINE_I_IMPL_RWA_W(T, N)                                              \
+    NADINE_I_FN void nadine_convert_array_##N(unsigned endian, T *p,           \
+                                              size_t count) {                  \
+        size_t i;                                                              \
+        for (i = 0; i < count; ++i)                                            \
+            p[i] = nadine_read_##N(endian, &p[i]);                             \
+    }                                                                          \
+    NADINE_I_FN void nadine_read_array_##N(unsigned endian, T *d,              \
+                                           const void *s, size_t count) {      \
+        /* cast for C++ compatibility */                                       \
+        const unsigned char *src = (const unsigned char *)s;                   \
+        size_t i;                                                              \
+        for (i = 0; i < count; ++i)                                            \
+            d[i] = nadine_read_##N(endian, &src[i * sizeof(T)]);               \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_array_##N(unsigned endian, void *d,          \
+                                            const T *s, size_t count) {        \
+        /* cast for C++ compatibility */                                       \
+        unsigned char *dst = (unsigned char *)d;                               \
+        size_t i;                                                              \
+        for (i = 0; i < count; ++i)                                            \
+            nadine_write_##N(endian, &dst[i * sizeof(T)], s[i]);               \
+    }
+
+/* define aligned read/write functions for T, a struct of two words. the
+   words are copied one at a time anyway, and a struct type cannot be made
+   to alias anything after its definition */
+#define NADINE_I_IMPL_ALIGNED_W(T, N)                                          \
+    NADINE_I_FN T nadine_read_aligned_##N(unsigned endian, const void *s) {    \
+        return nadine_read_##N(endian, s);                                     \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_aligned_##N(unsigned endian, void *d, T v) { \
+        nadine_write_##N(endian, d, v);                                        \
+    }
+
+/* define the basic functions for T when T is a struct of two words (lo, hi)
+   of unsigned integer type TW */
+#define NADINE_I_IMPL_W(T, N, TW, NW)                                          \
+    NADINE_I_IMPL_RW_W(T, N, TW, NW)                                           \
+    NADINE_I_IMPL_CVTAL(T, N)                                                  \
+    NADINE_I_IMPL_RWA_W(T, N)                                                  \
+    NADINE_I_IMPL_FIXED(T, N)                                                  \
+    NADINE_I_IMPL_ALIGNED_W(T, N)                                              \
+    NADINE_I_IMPL_CURSOR(T, N)                                                 \
+    NADINE_I_IMPL_PAR(T, N)
 
 #else /* NADINE_STATIC || NADINE_IMPL */
 
-/* declare the five basic functions for T */
+/* declare convert/read/write functions for T with a fixed endianness */
+#define NADINE_I_DECLARE_FIXED_E(T, N, S)                                      \
+    extern T nadine_convert_##S##_##N(T value);                                \
+    extern T nadine_read_##S##_##N(const void *source);                        \
+    extern void nadine_write_##S##_##N(void *destination, T value);
+
+/* declare the basic functions for T */
 #define NADINE_I_DECLARE(T, N)                                                 \
     extern T nadine_convert_##N(unsigned endian, T value);                     \
+    extern void nadine_convert_array_##N(unsigned endian, T *p, size_t count); \
     extern T nadine_read_##N(unsigned endian, const void *source);             \
     extern void nadine_write_##N(unsigned endian, void *destination, T value); \
+    extern void nadine_read_array_##N(unsigned endian, T *destination,         \
+                                      const void *source, size_t count);       \
+    extern void nadine_write_array_##N(unsigned endian, void *destination,     \
+                                       const T *source, size_t count);         \
     extern unsigned nadine_endian_native_##N(void);                            \
-    NADINE_I_IMPL_CVTAL(T, N)
+    extern T nadine_read_aligned_##N(unsigned endian, const void *source);     \
+    extern void nadine_write_aligned_##N(unsigned endian, void *destination,   \
+                                         T value);                             \
+    NADINE_I_DECLARE_FIXED_E(T, N, le)                                         \
+    NADINE_I_DECLARE_FIXED_E(T, N, be)                                         \
+    NADINE_I_DECLARE_FIXED_E(T, N, pdp)                                        \
+    NADINE_I_DECLARE_FIXED_E(T, N, h316)                                       \
+    NADINE_I_IMPL_CVTAL(T, N)                                                  \
+    NADINE_I_IMPL_CURSOR(T, N)                                                 \
+    NADINE_I_IMPL_PAR(T, N)
 
 #define NADINE_I_IMPL_UI(T, N) NADINE_I_DECLARE(T, N)
 #define NADINE_I_IMPL_SI(T, N, TU, NU) NADINE_I_DECLARE(T, N)
 #define NADINE_I_IMPL_F(T, N) NADINE_I_DECLARE(T, N)
+#define NADINE_I_IMPL_FI(T, N, TU, NU) NADINE_I_DECLARE(T, N)
+#define NADINE_I_IMPL_W(T, N, TW, NW) NADINE_I_DECLARE(T, N)
 
 #endif /* NADINE_STATIC || NADINE_IMPL */
 
@@ -850,10 +3486,3203 @@ NADINE_I_IMPL_I(int64_t, int64, uint64_t, uint64)
 #endif
 #endif
 
+#if NADINE_INT128
+#if NADINE_I_HAS_INT128
+#if __GNUC__ >= 3
+/* __int128 is an extension; do not complain about it with -pedantic */
+__extension__ typedef unsigned __int128 nadine_uint128;
+__extension__ typedef __int128 nadine_int128;
+#else
+typedef unsigned __int128 nadine_uint128;
+typedef __int128 nadine_int128;
+#endif
+NADINE_I_IMPL_I(nadine_int128, int128, nadine_uint128, uint128)
+#else /* NADINE_I_HAS_INT128 */
+/* the words are in the native order if it is known to be big-endian, so
+   that the struct has the same representation as a 128-bit integer */
+#if defined(NADINE_NATIVE_ENDIAN_INT)                                          \
+        && ((NADINE_NATIVE_ENDIAN_INT) & NADINE_ENDIAN_BIG)
+typedef struct nadine_uint128 { NADINE_I_U64 hi, lo; } nadine_uint128;
+typedef struct nadine_int128 { NADINE_I_U64 hi, lo; } nadine_int128;
+#else
+typedef struct nadine_uint128 { NADINE_I_U64 lo, hi; } nadine_uint128;
+typedef struct nadine_int128 { NADINE_I_U64 lo, hi; } nadine_int128;
+#endif
+NADINE_I_IMPL_W(nadine_uint128, uint128, NADINE_I_U64, NADINE_I_U64_N)
+NADINE_I_IMPL_W(nadine_int128, int128, NADINE_I_U64, NADINE_I_U64_N)
+#endif /* NADINE_I_HAS_INT128 */
+#endif /* NADINE_INT128 */
+
+#if CHAR_BIT == 8
+/* packed 24-bit and 48-bit integers, held in 32-bit and 64-bit types */
+#ifdef NADINE_I_U32
+typedef NADINE_I_U32 nadine_uint24;
+typedef NADINE_I_S32 nadine_int24;
+#else
+typedef unsigned long nadine_uint24;
+typedef long nadine_int24;
+#endif
+#ifdef NADINE_I_U64
+typedef NADINE_I_U64 nadine_uint48;
+typedef NADINE_I_S64 nadine_int48;
+#endif
+
+#if NADINE_STATIC || NADINE_IMPL
+
+/* index of char k (0 = least significant) of an n-char packed integer
+   stored with endian: big or little-endian, then with the chars swapped in
+   pairs for NADINE_ENDIAN_SWAPCHARS (leaving the last one if n is odd), the
+   same as nadine_convert_records does for fields of n chars */
+NADINE_I_FNS size_t nadine_i_packed_index(unsigned endian, size_t n,
+                                          size_t k) {
+    size_t i = (endian & NADINE_ENDIAN_BIG) ? n - 1 - k : k;
+    if ((endian & NADINE_ENDIAN_SWAPCHARS) && (i ^ 1) < n) i ^= 1;
+    return i;
+}
+
+/* SIMD 24-bit kernels: read packed 24-bit integers s[n] with endian into
+   32-bit integers d[n], sign-extended if sign is nonzero. every 4-char lane
+   gets the 3 chars of its value at the top with a shuffle, and a shift
+   brings them down. return how many values were read, from the start of
+   the array */
+#if NADINE_I_SIMD && defined(NADINE_I_U32)
+/* the shuffle mask for 4 values, for both pshufb and tbl. the values must
+   be little-endian, which is checked by the callers */
+NADINE_I_FNS void nadine_i_simd_u24_mask(unsigned char *m, unsigned endian) {
+    size_t j, k;
+    for (j = 0; j < 4; ++j) {
+        m[4 * j] = 0x80;
+        for (k = 0; k < 3; ++k)
+            m[4 * j + 1 + k] = (unsigned char)
+                    (3 * j + nadine_i_packed_index(endian, 3, k));
+    }
+}
+#endif /* NADINE_I_SIMD && defined(NADINE_I_U32) */
+
+#if NADINE_I_SIMD_SSSE3 && defined(NADINE_I_U32)
+NADINE_I_FN NADINE_I_TARGET("ssse3")
+size_t nadine_i_simd_u24_ssse3(NADINE_I_U32 *d, const void *s, size_t n,
+                               unsigned endian, int sign) {
+    /* cast for C++ compatibility */
+    const unsigned char *b = (const unsigned char *)s;
+    unsigned char k[16];
+    size_t i = 0;
+    __m128i m;
+    nadine_i_simd_u24_mask(k, endian);
+    m = _mm_loadu_si128((const __m128i *)k);
+    /* 16 chars are loaded for every 12 used */
+    for (; i + 4 <= n && i * 3 + 16 <= n * 3; i += 4) {
+        __m128i v = _mm_shuffle_epi8(
+                _mm_loadu_si128((const __m128i *)(b + i * 3)), m);
+        v = sign ? _mm_srai_epi32(v, 8) : _mm_srli_epi32(v, 8);
+        _mm_storeu_si128((__m128i *)(d + i), v);
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_SSSE3 && defined(NADINE_I_U32) */
+
+#if NADINE_I_SIMD_AVX2 && defined(NADINE_I_U32)
+NADINE_I_FN NADINE_I_TARGET("avx2")
+size_t nadine_i_simd_u24_avx2(NADINE_I_U32 *d, const void *s, size_t n,
+                              unsigned endian, int sign) {
+    /* cast for C++ compatibility */
+    const unsigned char *b = (const unsigned char *)s;
+    unsigned char k[16];
+    size_t i = 0;
+    __m256i m, p;
+    nadine_i_simd_u24_mask(k, endian);
+    m = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)k));
+    /* move chars 12 to 27 into the upper lane, since vpshufb shuffles
+       within 128-bit lanes */
+    p = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+    for (; i + 8 <= n && i * 3 + 32 <= n * 3; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(b + i * 3));
+        v = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(v, p), m);
+        v = sign ? _mm256_srai_epi32(v, 8) : _mm256_srli_epi32(v, 8);
+        _mm256_storeu_si256((__m256i *)(d + i), v);
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_AVX2 && defined(NADINE_I_U32) */
+
+#if NADINE_I_SIMD_NEON && defined(NADINE_I_U32)
+NADINE_I_FN
+size_t nadine_i_simd_u24_neon(NADINE_I_U32 *d, const void *s, size_t n,
+                              unsigned endian, int sign) {
+    /* cast for C++ compatibility */
+    const unsigned char *b = (const unsigned char *)s;
+    unsigned char k[16];
+    size_t i = 0;
+    uint8x16_t m;
+    nadine_i_simd_u24_mask(k, endian);
+    m = vld1q_u8(k);
+    for (; i + 4 <= n && i * 3 + 16 <= n * 3; i += 4) {
+        uint8x16_t v = vld1q_u8(b + i * 3);
+#if NADINE_I_ARCH_ARM64
+        v = vqtbl1q_u8(v, m);
+#else
+        uint8x8x2_t t;
+        t.val[0] = vget_low_u8(v);
+        t.val[1] = vget_high_u8(v);
+        v = vcombine_u8(vtbl2_u8(t, vget_low_u8(m)),
+                        vtbl2_u8(t, vget_high_u8(m)));
+#endif
+        if (sign)
+            vst1q_s32((int32_t *)(d + i),
+                      vshrq_n_s32(vreinterpretq_s32_u8(v), 8));
+        else
+            vst1q_u32((uint32_t *)(d + i),
+                      vshrq_n_u32(vreinterpretq_u32_u8(v), 8));
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_NEON && defined(NADINE_I_U32) */
+
+/* read with the 24-bit kernel for the kernel in use */
+NADINE_I_FNS size_t nadine_i_simd_u24(void *d, const void *s, size_t n,
+                                      unsigned endian, int sign) {
+#if NADINE_I_SIMD && defined(NADINE_I_U32)
+    /* cast for C++ compatibility */
+    NADINE_I_U32 *a = (NADINE_I_U32 *)d;
+    if (nadine_endian_native_unsigned_long() != NADINE_ENDIAN_LITTLE)
+        return 0;
+#if NADINE_DISPATCH
+    switch (nadine_simd_kernel()) {
+#if NADINE_I_SIMD_SSSE3
+    case NADINE_KERNEL_SSSE3:
+        return nadine_i_simd_u24_ssse3(a, s, n, endian, sign);
+    case NADINE_KERNEL_AVX2:
+    case NADINE_KERNEL_AVX512:
+        return nadine_i_simd_u24_avx2(a, s, n, endian, sign);
+#endif
+#if NADINE_I_SIMD_NEON
+    case NADINE_KERNEL_NEON:
+        return nadine_i_simd_u24_neon(a, s, n, endian, sign);
+#endif
+    }
+#elif NADINE_I_SIMD_AVX2 && NADINE_I_KERNEL >= NADINE_KERNEL_AVX2            \
+        && NADINE_I_KERNEL <= NADINE_KERNEL_AVX512
+    return nadine_i_simd_u24_avx2(a, s, n, endian, sign);
+#elif NADINE_I_SIMD_SSSE3 && NADINE_I_KERNEL == NADINE_KERNEL_SSSE3
+    return nadine_i_simd_u24_ssse3(a, s, n, endian, sign);
+#elif NADINE_I_SIMD_NEON && NADINE_I_KERNEL == NADINE_KERNEL_NEON
+    return nadine_i_simd_u24_neon(a, s, n, endian, sign);
+#endif
+    (void)a;
+#endif /* NADINE_I_SIMD && defined(NADINE_I_U32) */
+    (void)d, (void)s, (void)n, (void)endian, (void)sign;
+    return 0;
+}
+
+NADINE_I_FN nadine_uint24 nadine_read_uint24(unsigned endian, const void *s) {
+    /* cast for C++ compatibility */
+    const unsigned char *src = (const unsigned char *)s;
+    unsigned long v = 0;
+    size_t k;
+    for (k = 3; k--; )
+        v = v << 8 | src[nadine_i_packed_index(endian, 3, k)];
+    return (nadine_uint24)v;
+}
+
+NADINE_I_FN nadine_int24 nadine_read_int24(unsigned endian, const void *s) {
+    unsigned long v = nadine_read_uint24(endian, s);
+    /* sign extension without relying on two's complement casts */
+    return (nadine_int24)((long)(v ^ 0x800000UL) - 0x800000L);
+}
+
+NADINE_I_FN void nadine_write_uint24(unsigned endian, void *d,
+                                     nadine_uint24 value) {
+    /* cast for C++ compatibility */
+    unsigned char *dst = (unsigned char *)d;
+    unsigned long v = (unsigned long)value;
+    size_t k;
+    for (k = 0; k < 3; ++k, v >>= 8)
+        dst[nadine_i_packed_index(endian, 3, k)] = (unsigned char)(v & 0xFF);
+}
+
+NADINE_I_FN void nadine_write_int24(unsigned endian, void *d,
+                                    nadine_int24 value) {
+    nadine_write_uint24(endian, d, (nadine_uint24)value);
+}
+
+NADINE_I_FN void nadine_read_array_uint24(unsigned endian, nadine_uint24 *d,
+                                          const void *s, size_t count) {
+    /* cast for C++ compatibility */
+    const unsigned char *src = (const unsigned char *)s;
+    size_t i = nadine_i_simd_u24(d, s, count, endian, 0);
+    for (; i < count; ++i)
+        d[i] = nadine_read_uint24(endian, &src[i * 3]);
+}
+
+NADINE_I_FN void nadine_read_array_int24(unsigned endian, nadine_int24 *d,
+                                         const void *s, size_t count) {
+    /* cast for C++ compatibility */
+    const unsigned char *src = (const unsigned char *)s;
+    size_t i = nadine_i_simd_u24(d, s, count, endian, 1);
+    for (; i < count; ++i)
+        d[i] = nadine_read_int24(endian, &src[i * 3]);
+}
+
+NADINE_I_FN void nadine_write_array_uint24(unsigned endian, void *d,
+                                           const nadine_uint24 *s,
+                                           size_t count) {
+    /* cast for C++ compatibility */
+    unsigned char *dst = (unsigned char *)d;
+    size_t i;
+    for (i = 0; i < count; ++i)
+        nadine_write_uint24(endian, &dst[i * 3], s[i]);
+}
+
+NADINE_I_FN void nadine_write_array_int24(unsigned endian, void *d,
+                                          const nadine_int24 *s,
+                                          size_t count) {
+    /* cast for C++ compatibility */
+    unsigned char *dst = (unsigned char *)d;
+    size_t i;
+    for (i = 0; i < count; ++i)
+        nadine_write_int24(endian, &dst[i * 3], s[i]);
+}
+
+#ifdef NADINE_I_U64
+NADINE_I_FN nadine_uint48 nadine_read_uint48(unsigned endian, const void *s) {
+    /* cast for C++ compatibility */
+    const unsigned char *src = (const unsigned char *)s;
+    NADINE_I_U64 v = 0;
+    size_t k;
+    for (k = 6; k--; )
+        v = v << 8 | src[nadine_i_packed_index(endian, 6, k)];
+    return v;
+}
+
+NADINE_I_FN nadine_int48 nadine_read_int48(unsigned endian, const void *s) {
+    const NADINE_I_U64 top = (NADINE_I_U64)1 << 47;
+    NADINE_I_U64 v = nadine_read_uint48(endian, s);
+    return (nadine_int48)(v ^ top) - (nadine_int48)top;
+}
+
+NADINE_I_FN void nadine_write_uint48(unsigned endian, void *d,
+                                     nadine_uint48 value) {
+    /* cast for C++ compatibility */
+    unsigned char *dst = (unsigned char *)d;
+    size_t k;
+    for (k = 0; k < 6; ++k, value >>= 8)
+        dst[nadine_i_packed_index(endian, 6, k)] =
+                (unsigned char)(value & 0xFF);
+}
+
+NADINE_I_FN void nadine_write_int48(unsigned endian, void *d,
+                                    nadine_int48 value) {
+    nadine_write_uint48(endian, d, (nadine_uint48)value);
+}
+
+NADINE_I_FN void nadine_read_array_uint48(unsigned endian, nadine_uint48 *d,
+                                          const void *s, size_t count) {
+    /* cast for C++ compatibility */
+    const unsigned char *src = (const unsigned char *)s;
+    size_t i;
+    for (i = 0; i < count; ++i)
+        d[i] = nadine_read_uint48(endian, &src[i * 6]);
+}
+
+NADINE_I_FN void nadine_read_array_int48(unsigned endian, nadine_int48 *d,
+                                         const void *s, size_t count) {
+    /* cast for C++ compatibility */
+    const unsigned char *src = (const unsigned char *)s;
+    size_t i;
+    for (i = 0; i < count; ++i)
+        d[i] = nadine_read_int48(endian, &src[i * 6]);
+}
+
+NADINE_I_FN void nadine_write_array_uint48(unsigned endian, void *d,
+                                           const nadine_uint48 *s,
+                                           size_t count) {
+    /* cast for C++ compatibility */
+    unsigned char *dst = (unsigned char *)d;
+    size_t i;
+    for (i = 0; i < count; ++i)
+        nadine_write_uint48(endian, &dst[i * 6], s[i]);
+}
+
+NADINE_I_FN void nadine_write_array_int48(unsigned endian, void *d,
+                                          const nadine_int48 *s,
+                                          size_t count) {
+    /* cast for C++ compatibility */
+    unsigned char *dst = (unsigned char *)d;
+    size_t i;
+    for (i = 0; i < count; ++i)
+        nadine_write_int48(endian, &dst[i * 6], s[i]);
+}
+#endif /* NADINE_I_U64 */
+
+#else /* NADINE_STATIC || NADINE_IMPL */
+
+/* declare the functions for packed integer type T */
+#define NADINE_I_DECLARE_PACKED(T, N)                                          \
+    extern T nadine_read_##N(unsigned endian, const void *source);             \
+    extern void nadine_write_##N(unsigned endian, void *destination, T value); \
+    extern void nadine_read_array_##N(unsigned endian, T *destination,         \
+                                      const void *source, size_t count);       \
+    extern void nadine_write_array_##N(unsigned endian, void *destination,     \
+                                       const T *source, size_t count);
+
+NADINE_I_DECLARE_PACKED(nadine_uint24, uint24)
+NADINE_I_DECLARE_PACKED(nadine_int24, int24)
+#ifdef NADINE_I_U64
+NADINE_I_DECLARE_PACKED(nadine_uint48, uint48)
+NADINE_I_DECLARE_PACKED(nadine_int48, int48)
+#endif /* NADINE_I_U64 */
+
+#endif /* NADINE_STATIC || NADINE_IMPL */
+
+#ifdef NADINE_I_U64
+/* the most bits nadine_bitreader_peek etc. take at a time */
+#define NADINE_BITS_MAX 57
+
+/* bitstream reader over a char buffer. the accumulator holds the next
+   `bits' bits at its top (MSB-first) or bottom (LSB-first); the chars
+   after its valid bits may also be there, as they were loaded */
+typedef struct nadine_bitreader {
+    const unsigned char *base;  /* start of the buffer */
+    const unsigned char *pos;   /* next char to load */
+    const unsigned char *end;   /* end of the buffer */
+    NADINE_I_U64 acc;           /* accumulator */
+    unsigned bits;              /* number of valid bits in acc */
+    unsigned endian;            /* NADINE_ENDIAN_BIG for MSB-first */
+    size_t pad;                 /* zero chars loaded past the end */
+} nadine_bitreader;
+
+/* bitstream writer over a char buffer, with the pending bits held in the
+   accumulator like in nadine_bitreader */
+typedef struct nadine_bitwriter {
+    unsigned char *base;        /* start of the buffer */
+    unsigned char *pos;         /* next char to store */
+    unsigned char *end;         /* end of the buffer */
+    NADINE_I_U64 acc;           /* accumulator */
+    unsigned bits;              /* number of pending bits in acc */
+    unsigned endian;            /* NADINE_ENDIAN_BIG for MSB-first */
+    int ok;                     /* zero if something did not fit */
+} nadine_bitwriter;
+
+/* define the bitstream functions on top of 64-bit unsigned type T */
+#define NADINE_I_IMPL_BITS(T, N)                                               \
+    NADINE_I_FNS void nadine_bitreader_init(nadine_bitreader *r,               \
+                                            const void *buffer, size_t size,   \
+                                            unsigned endian) {                 \
+        /* cast for C++ compatibility */                                       \
+        r->base = r->pos = (const unsigned char *)buffer;                      \
+        r->end = r->base + size;                                               \
+        r->acc = 0;                                                            \
+        r->bits = 0;                                                           \
+        r->endian = endian & NADINE_ENDIAN_BIG;                                \
+        r->pad = 0;                                                            \
+    }                                                                          \
+    /* whole chars from the end of the buffer: pad with zeros past it */       \
+    NADINE_I_FNS void nadine_i_bitreader_tail(nadine_bitreader *r) {           \
+        while (r->bits <= 56) {                                                \
+            T c = 0;                                                           \
+            if (r->pos < r->end)                                               \
+                c = *r->pos++;                                                 \
+            else                                                               \
+                ++r->pad;                                                      \
+            r->acc |= r->endian ? c << (56 - r->bits) : c << r->bits;          \
+            r->bits += 8;                                                      \
+        }                                                                      \
+    }                                                                          \
+    NADINE_I_FNS void nadine_bitreader_refill(nadine_bitreader *r) {           \
+        if (r->bits > 56) return;                                              \
+        if ((size_t)(r->end - r->pos) >= 8) {                                  \
+            /* load 8 chars and keep as many whole ones as fit; the rest       \
+               are loaded again at the same place by the next refill */        \
+            const T v = r->endian ? nadine_read_be_##N(r->pos)                 \
+                                  : nadine_read_le_##N(r->pos);                \
+            const unsigned n = (64 - r->bits) >> 3;                            \
+            r->acc |= r->endian ? v >> r->bits : v << r->bits;                 \
+            r->pos += n;                                                       \
+            r->bits += n << 3;                                                 \
+        } else {                                                               \
+            nadine_i_bitreader_tail(r);                                        \
+        }                                                                      \
+    }                                                                          \
+    NADINE_I_FNS T nadine_bitreader_peek(const nadine_bitreader *r,            \
+                                         unsigned n) {                         \
+        return r->endian ? r->acc >> (64 - n)                                  \
+                         : r->acc & (((T)1 << n) - 1);                         \
+    }                                                                          \
+    NADINE_I_FNS void nadine_bitreader_consume(nadine_bitreader *r,            \
+                                               unsigned n) {                   \
+        if (r->endian)                                                         \
+            r->acc <<= n;                                                      \
+        else                                                                   \
+            r->acc >>= n;                                                      \
+        r->bits -= n;                                                          \
+    }                                                                          \
+    NADINE_I_FNS T nadine_bitreader_read(nadine_bitreader *r, unsigned n) {    \
+        T v;                                                                   \
+        nadine_bitreader_refill(r);                                            \
+        v = nadine_bitreader_peek(r, n);                                       \
+        nadine_bitreader_consume(r, n);                                        \
+        return v;                                                              \
+    }                                                                          \
+    NADINE_I_FNS size_t nadine_bitreader_tell(const nadine_bitreader *r) {     \
+        return ((size_t)(r->pos - r->base) + r->pad) * 8 - r->bits;            \
+    }                                                                          \
+    NADINE_I_FNS void nadine_bitreader_align(nadine_bitreader *r) {            \
+        nadine_bitreader_consume(r, r->bits & 7);                              \
+    }                                                                          \
+    NADINE_I_FNS int nadine_bitreader_ok(const nadine_bitreader *r) {          \
+        /* the zero chars past the end are the last ones loaded */             \
+        return r->pad * 8 <= r->bits;                                          \
+    }                                                                          \
+    NADINE_I_FNS void nadine_bitwriter_init(nadine_bitwriter *w, void *buffer, \
+                                            size_t size, unsigned endian) {    \
+        /* cast for C++ compatibility */                                       \
+        w->base = w->pos = (unsigned char *)buffer;                            \
+        w->end = w->base + size;                                               \
+        w->acc = 0;                                                            \
+        w->bits = 0;                                                           \
+        w->endian = endian & NADINE_ENDIAN_BIG;                                \
+        w->ok = 1;                                                             \
+    }                                                                          \
+    /* store the whole chars in the accumulator */                             \
+    NADINE_I_FNS void nadine_i_bitwriter_flush(nadine_bitwriter *w) {          \
+        const unsigned k = w->bits & ~7U;                                      \
+        if ((size_t)(w->end - w->pos) >= 8) {                                  \
+            /* store all 8; the chars past the whole ones are stored again */  \
+            if (w->endian)                                                     \
+                nadine_write_be_##N(w->pos, w->acc);                           \
+            else                                                               \
+                nadine_write_le_##N(w->pos, w->acc);                           \
+            w->pos += k >> 3;                                                  \
+        } else {                                                               \
+            unsigned i;                                                        \
+            for (i = 0; i < k; i += 8) {                                       \
+                if (w->pos == w->end) {                                        \
+                    w->ok = 0;                                                 \
+                    break;                                                     \
+                }                                                              \
+                *w->pos++ = (unsigned char)(w->endian ? w->acc >> (56 - i)     \
+                                                      : w->acc >> i);          \
+            }                                                                  \
+        }                                                                      \
+        if (k == 64)                                                           \
+            w->acc = 0;                                                        \
+        else if (w->endian)                                                    \
+            w->acc <<= k;                                                      \
+        else                                                                   \
+            w->acc >>= k;                                                      \
+        w->bits -= k;                                                          \
+    }                                                                          \
+    NADINE_I_FNS void nadine_bitwriter_put(nadine_bitwriter *w, T value,       \
+                                           unsigned n) {                       \
+        value &= ((T)1 << n) - 1;                                              \
+        w->acc |= w->endian ? value << (64 - w->bits - n) : value << w->bits;  \
+        w->bits += n;                                                          \
+        nadine_i_bitwriter_flush(w);                                           \
+    }                                                                          \
+    NADINE_I_FNS size_t nadine_bitwriter_tell(const nadine_bitwriter *w) {     \
+        return (size_t)(w->pos - w->base) * 8 + w->bits;                       \
+    }                                                                          \
+    NADINE_I_FNS void nadine_bitwriter_align(nadine_bitwriter *w) {            \
+        if (w->bits) nadine_bitwriter_put(w, 0, 8 - w->bits);                  \
+    }                                                                          \
+    NADINE_I_FNS int nadine_bitwriter_ok(const nadine_bitwriter *w) {          \
+        return w->ok;                                                          \
+    }                                                                          \
+    NADINE_I_FNS size_t nadine_bitwriter_finish(nadine_bitwriter *w) {         \
+        nadine_bitwriter_align(w);                                             \
+        return (size_t)(w->pos - w->base);                                     \
+    }
+
+/* expand N before it is pasted */
+#define NADINE_I_IMPL_BITS_E(T, N) NADINE_I_IMPL_BITS(T, N)
+NADINE_I_IMPL_BITS_E(NADINE_I_U64, NADINE_I_U64_N)
+#endif /* NADINE_I_U64 */
+#endif /* CHAR_BIT == 8 */
+
 #if NADINE_FLOAT
+/* find unsigned integer types of the same size to convert floats through */
+#if CHAR_BIT == 8 && FLT_MANT_DIG == 24 && FLT_MAX_EXP == 128
+#if NADINE_STDINT && defined(UINT32_MAX) && defined(INT32_MAX)
+#define NADINE_I_FLOAT_UINT uint32_t
+#define NADINE_I_FLOAT_UINT_N uint32
+#elif UINT_MAX == 0xFFFFFFFFUL
+#define NADINE_I_FLOAT_UINT unsigned int
+#define NADINE_I_FLOAT_UINT_N unsigned_int
+#elif ULONG_MAX == 0xFFFFFFFFUL
+#define NADINE_I_FLOAT_UINT unsigned long
+#define NADINE_I_FLOAT_UINT_N unsigned_long
+#endif
+#endif /* binary32 */
+#if CHAR_BIT == 8 && defined(NADINE_I_U64)
+#define NADINE_I_DOUBLE_UINT NADINE_I_U64
+#define NADINE_I_DOUBLE_UINT_N NADINE_I_U64_N
+#endif /* CHAR_BIT == 8 */
+
+#ifdef NADINE_I_FLOAT_UINT
+NADINE_I_STATIC_ASSERT("float must have the size of a 32-bit integer",
+                       sizeof(float) == sizeof(NADINE_I_FLOAT_UINT));
+NADINE_I_IMPL_FI(float, float, NADINE_I_FLOAT_UINT, NADINE_I_FLOAT_UINT_N)
+#else
 NADINE_I_IMPL_F(float, float)
+#endif
+#ifdef NADINE_I_DOUBLE_UINT
+NADINE_I_STATIC_ASSERT("double must have the size of a 64-bit integer",
+                       sizeof(double) == sizeof(NADINE_I_DOUBLE_UINT));
+NADINE_I_IMPL_FI(double, double, NADINE_I_DOUBLE_UINT, NADINE_I_DOUBLE_UINT_N)
+#else
 NADINE_I_IMPL_F(double, double)
 #endif
+#endif /* NADINE_FLOAT */
+
+#if NADINE_STATIC || NADINE_IMPL
+NADINE_I_FN void nadine_init(void) {
+    /* detect and cache the native endianness of every type that needs it */
+#ifndef NADINE_NATIVE_ENDIAN_INT
+    (void)nadine_endian_native_unsigned_short();
+    (void)nadine_endian_native_unsigned_int();
+    (void)nadine_endian_native_unsigned_long();
+#if NADINE_I_HAS_ULL
+    (void)nadine_endian_native_unsigned_long_long();
+#endif
+#if NADINE_STDINT
+#if defined(UINT16_MAX) && defined(INT16_MAX)
+    (void)nadine_endian_native_uint16();
+#endif
+#if defined(UINT32_MAX) && defined(INT32_MAX)
+    (void)nadine_endian_native_uint32();
+#endif
+#if defined(UINT64_MAX) && defined(INT64_MAX)
+    (void)nadine_endian_native_uint64();
+#endif
+#endif /* NADINE_STDINT */
+#if NADINE_INT128 && NADINE_I_HAS_INT128
+    (void)nadine_endian_native_uint128();
+#endif
+#endif /* NADINE_NATIVE_ENDIAN_INT */
+#if NADINE_FLOAT && !defined(NADINE_NATIVE_ENDIAN_FLOAT)
+    (void)nadine_endian_native_float();
+    (void)nadine_endian_native_double();
+#endif
+    /* and the SIMD kernel, with NADINE_DISPATCH */
+    (void)nadine_simd_kernel();
+}
+#else /* NADINE_STATIC || NADINE_IMPL */
+extern void nadine_init(void);
+#endif /* NADINE_STATIC || NADINE_IMPL */
+
+/* maximum number of types described by nadine_config */
+#define NADINE_CONFIG_MAX_TYPES 16
+
+/* conversion paths of a type, as reported by nadine_config */
+typedef struct nadine_type_info {
+    const char *name;       /* type name as in the function names (N) */
+    size_t size;            /* size of the type in chars */
+    unsigned native;        /* nadine_endian_native_N() */
+    unsigned convert[4];    /* path of nadine_convert_N for each endian */
+    unsigned rw[4];         /* path of nadine_read_N and nadine_write_N */
+} nadine_type_info;
+
+/* how the library was compiled and which paths it takes */
+typedef struct nadine_config_info {
+    unsigned flags;                 /* NADINE_CONFIG_* flags */
+    unsigned kernel;                /* nadine_simd_kernel() */
+    unsigned native_endian_cache;   /* NADINE_NATIVE_ENDIAN_CACHE */
+    unsigned type_count;            /* number of entries in types */
+    nadine_type_info types[NADINE_CONFIG_MAX_TYPES];
+} nadine_config_info;
+
+/* calls per conversion path, see nadine_get_stats */
+typedef struct nadine_stats {
+    unsigned long calls[NADINE_PATHS];
+} nadine_stats;
+
+#if NADINE_STATIC || NADINE_IMPL
+/* describe a type of size chars that is converted in units of unit chars,
+   which are swapped in one step if fused, or go through nadine_i_xform if
+   not. shift is whether read/write assemble units of up to 8 chars with
+   shifts */
+NADINE_I_FNS void nadine_i_config_type(nadine_type_info *t, const char *name,
+                                       size_t size, size_t unit,
+                                       unsigned native, int fused, int shift) {
+    unsigned e;
+    t->name = name;
+    t->size = size;
+    t->native = native;
+    for (e = 0; e < 4; ++e) {
+        const unsigned xf = native ^ e;
+        t->convert[e] = fused ? nadine_i_path(xf, unit)
+                      : xf ? NADINE_PATH_XFORM : NADINE_PATH_NATIVE;
+        t->rw[e] = shift && unit <= 8 ? NADINE_PATH_SHIFT : t->convert[e];
+#if NADINE_I_MOVBE
+        if (fused && e == NADINE_ENDIAN_BIG
+                  && (unit == 2 || unit == 4 || unit == 8))
+            t->rw[e] = NADINE_PATH_SWAP;
+#endif
+    }
+}
+
+#define NADINE_I_CONFIG_INT(T, N, TU, NU)                                      \
+    nadine_i_config_type(t++, #N, sizeof(T), sizeof(TU),                       \
+                         NADINE_I_NATIVE_INT(TU, NU), 1, NADINE_I_USE_SHIFT_RW)
+
+NADINE_I_FN void nadine_config(nadine_config_info *info) {
+    nadine_type_info *t = info->types;
+    info->flags = 0;
+#ifdef NADINE_I_WREV_INTRINSIC
+    info->flags |= NADINE_CONFIG_SWAP_INTRINSIC;
+#endif
+#if NADINE_I_USE_SHIFT_RW
+    info->flags |= NADINE_CONFIG_SHIFT_RW;
+#endif
+#if NADINE_I_TYPE_PUN_UNIONS
+    info->flags |= NADINE_CONFIG_PUN_UNIONS;
+#endif
+#if NADINE_MEMCPY
+    info->flags |= NADINE_CONFIG_MEMCPY;
+#endif
+#ifdef NADINE_NATIVE_ENDIAN_INT
+    info->flags |= NADINE_CONFIG_NATIVE_INT;
+#endif
+#if NADINE_FLOAT && defined(NADINE_NATIVE_ENDIAN_FLOAT)
+    info->flags |= NADINE_CONFIG_NATIVE_FLOAT;
+#endif
+#if NADINE_SIMD
+    info->flags |= NADINE_CONFIG_SIMD;
+#endif
+#if NADINE_DISPATCH
+    info->flags |= NADINE_CONFIG_DISPATCH;
+#endif
+#if NADINE_STATS
+    info->flags |= NADINE_CONFIG_STATS;
+#endif
+#if NADINE_I_MOVBE
+    info->flags |= NADINE_CONFIG_MOVBE;
+#endif
+    info->kernel = nadine_simd_kernel();
+    info->native_endian_cache = NADINE_NATIVE_ENDIAN_CACHE;
+
+    /* the signed types take the paths of the unsigned ones */
+    NADINE_I_CONFIG_INT(unsigned short, unsigned_short,
+                        unsigned short, unsigned_short);
+    NADINE_I_CONFIG_INT(unsigned int, unsigned_int,
+                        unsigned int, unsigned_int);
+    NADINE_I_CONFIG_INT(unsigned long, unsigned_long,
+                        unsigned long, unsigned_long);
+#if NADINE_I_HAS_ULL
+    NADINE_I_CONFIG_INT(unsigned long long, unsigned_long_long,
+                        unsigned long long, unsigned_long_long);
+#endif
+#if NADINE_STDINT
+#if defined(UINT16_MAX) && defined(INT16_MAX)
+    NADINE_I_CONFIG_INT(uint16_t, uint16, uint16_t, uint16);
+#endif
+#if defined(UINT32_MAX) && defined(INT32_MAX)
+    NADINE_I_CONFIG_INT(uint32_t, uint32, uint32_t, uint32);
+#endif
+#if defined(UINT64_MAX) && defined(INT64_MAX)
+    NADINE_I_CONFIG_INT(uint64_t, uint64, uint64_t, uint64);
+#endif
+#endif /* NADINE_STDINT */
+#if NADINE_INT128
+#if NADINE_I_HAS_INT128
+    NADINE_I_CONFIG_INT(nadine_uint128, uint128, nadine_uint128, uint128);
+#else
+    /* converted a 64-bit word at a time */
+    NADINE_I_CONFIG_INT(nadine_uint128, uint128, NADINE_I_U64, NADINE_I_U64_N);
+#endif
+#endif /* NADINE_INT128 */
+#if NADINE_FLOAT
+#ifdef NADINE_I_FLOAT_UINT
+    nadine_i_config_type(t++, "float", sizeof(float), sizeof(float),
+                         NADINE_I_NATIVE_FLOAT(float, float), 1,
+                         NADINE_I_USE_SHIFT_RW);
+#else
+    nadine_i_config_type(t++, "float", sizeof(float), sizeof(float),
+                         NADINE_I_NATIVE_FLOAT(float, float), 0, 0);
+#endif
+#ifdef NADINE_I_DOUBLE_UINT
+    nadine_i_config_type(t++, "double", sizeof(double), sizeof(double),
+                         NADINE_I_NATIVE_FLOAT(double, double), 1,
+                         NADINE_I_USE_SHIFT_RW);
+#else
+    nadine_i_config_type(t++, "double", sizeof(double), sizeof(double),
+                         NADINE_I_NATIVE_FLOAT(double, double), 0, 0);
+#endif
+#endif /* NADINE_FLOAT */
+    info->type_count = (unsigned)(t - info->types);
+}
+
+#if NADINE_STATS
+NADINE_I_FN void nadine_get_stats(nadine_stats *stats) {
+    unsigned i;
+    for (i = 0; i < NADINE_PATHS; ++i)
+        stats->calls[i] = nadine_i_stats[i];
+}
+
+NADINE_I_FN void nadine_reset_stats(void) {
+    unsigned i;
+    for (i = 0; i < NADINE_PATHS; ++i)
+        nadine_i_stats[i] = 0;
+}
+#endif /* NADINE_STATS */
+#else /* NADINE_STATIC || NADINE_IMPL */
+extern void nadine_config(nadine_config_info *info);
+#if NADINE_STATS
+extern void nadine_get_stats(nadine_stats *stats);
+extern void nadine_reset_stats(void);
+#endif /* NADINE_STATS */
+#endif /* NADINE_STATIC || NADINE_IMPL */
+
+/* codecs: the functions of every type for one endianness, resolved once */
+
+/* expand x if the types exist */
+#if NADINE_I_HAS_ULL
+#define NADINE_I_CODEC_IF_ULL(x) x
+#else
+#define NADINE_I_CODEC_IF_ULL(x)
+#endif
+#if NADINE_STDINT && defined(UINT16_MAX) && defined(INT16_MAX)
+#define NADINE_I_CODEC_IF_16(x) x
+#else
+#define NADINE_I_CODEC_IF_16(x)
+#endif
+#if NADINE_STDINT && defined(UINT32_MAX) && defined(INT32_MAX)
+#define NADINE_I_CODEC_IF_32(x) x
+#else
+#define NADINE_I_CODEC_IF_32(x)
+#endif
+#if NADINE_STDINT && defined(UINT64_MAX) && defined(INT64_MAX)
+#define NADINE_I_CODEC_IF_64(x) x
+#else
+#define NADINE_I_CODEC_IF_64(x)
+#endif
+#if NADINE_INT128
+#define NADINE_I_CODEC_IF_128(x) x
+#else
+#define NADINE_I_CODEC_IF_128(x)
+#endif
+#if NADINE_FLOAT
+#define NADINE_I_CODEC_IF_FLOAT(x) x
+#else
+#define NADINE_I_CODEC_IF_FLOAT(x)
+#endif
+
+/* X(T, N, S) for every type T named N, with the endian infix S */
+#define NADINE_I_CODEC_TYPES(X, S)                                             \
+    X(unsigned short, unsigned_short, S)                                       \
+    X(short, short, S)                                                         \
+    X(unsigned int, unsigned_int, S)                                           \
+    X(int, int, S)                                                             \
+    X(unsigned long, unsigned_long, S)                                         \
+    X(long, long, S)                                                           \
+    NADINE_I_CODEC_IF_ULL(X(unsigned long long, unsigned_long_long, S)         \
+                          X(long long, long_long, S))                          \
+    NADINE_I_CODEC_IF_16(X(uint16_t, uint16, S) X(int16_t, int16, S))          \
+    NADINE_I_CODEC_IF_32(X(uint32_t, uint32, S) X(int32_t, int32, S))          \
+    NADINE_I_CODEC_IF_64(X(uint64_t, uint64, S) X(int64_t, int64, S))          \
+    NADINE_I_CODEC_IF_128(X(nadine_uint128, uint128, S)                        \
+                          X(nadine_int128, int128, S))                         \
+    NADINE_I_CODEC_IF_FLOAT(X(float, float, S) X(double, double, S))
+
+/* the members of nadine_codec for T */
+#define NADINE_I_CODEC_MEMBERS(T, N, S)                                        \
+    T (*convert_##N)(T value);                                                 \
+    T (*read_##N)(const void *source);                                         \
+    void (*write_##N)(void *destination, T value);                             \
+    void (*convert_array_##N)(T *p, size_t count);                             \
+    void (*read_array_##N)(T *destination, const void *source, size_t count);  \
+    void (*write_array_##N)(void *destination, const T *source,                \
+                            size_t count);
+
+/* functions of every type for one endianness, from nadine_codec_for */
+typedef struct nadine_codec {
+    unsigned endian;        /* the endianness of the functions */
+    NADINE_I_CODEC_TYPES(NADINE_I_CODEC_MEMBERS, le)
+} nadine_codec;
+
+#if NADINE_STATIC || NADINE_IMPL
+/* the endian for an infix */
+#define NADINE_I_CODEC_E_le NADINE_ENDIAN_LITTLE
+#define NADINE_I_CODEC_E_be NADINE_ENDIAN_BIG
+#define NADINE_I_CODEC_E_h316 (NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS)
+#define NADINE_I_CODEC_E_pdp (NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS)
+
+/* define the array functions of T with the fixed endianness of infix S */
+#define NADINE_I_IMPL_CODEC_ARRAYS(T, N, S)                                    \
+    NADINE_I_FNS void nadine_i_convert_array_##S##_##N(T *p, size_t count) {   \
+        nadine_convert_array_##N(NADINE_I_CODEC_E_##S, p, count);              \
+    }                                                                          \
+    NADINE_I_FNS void nadine_i_read_array_##S##_##N(T *d, const void *s,       \
+                                                    size_t count) {            \
+        nadine_read_array_##N(NADINE_I_CODEC_E_##S, d, s, count);              \
+    }                                                                          \
+    NADINE_I_FNS void nadine_i_write_array_##S##_##N(void *d, const T *s,      \
+                                                     size_t count) {           \
+        nadine_write_array_##N(NADINE_I_CODEC_E_##S, d, s, count);             \
+    }
+
+NADINE_I_CODEC_TYPES(NADINE_I_IMPL_CODEC_ARRAYS, le)
+NADINE_I_CODEC_TYPES(NADINE_I_IMPL_CODEC_ARRAYS, be)
+NADINE_I_CODEC_TYPES(NADINE_I_IMPL_CODEC_ARRAYS, h316)
+NADINE_I_CODEC_TYPES(NADINE_I_IMPL_CODEC_ARRAYS, pdp)
+
+/* the initializer of the members of nadine_codec for T */
+#define NADINE_I_CODEC_INIT(T, N, S)                                           \
+    &nadine_convert_##S##_##N, &nadine_read_##S##_##N,                         \
+    &nadine_write_##S##_##N, &nadine_i_convert_array_##S##_##N,                \
+    &nadine_i_read_array_##S##_##N, &nadine_i_write_array_##S##_##N,
+
+NADINE_I_FN const nadine_codec *nadine_codec_for(unsigned endian) {
+    /* indexed by endian */
+    static const nadine_codec codecs[4] = {
+        { NADINE_I_CODEC_E_le,
+          NADINE_I_CODEC_TYPES(NADINE_I_CODEC_INIT, le) },
+        { NADINE_I_CODEC_E_be,
+          NADINE_I_CODEC_TYPES(NADINE_I_CODEC_INIT, be) },
+        { NADINE_I_CODEC_E_h316,
+          NADINE_I_CODEC_TYPES(NADINE_I_CODEC_INIT, h316) },
+        { NADINE_I_CODEC_E_pdp,
+          NADINE_I_CODEC_TYPES(NADINE_I_CODEC_INIT, pdp) },
+    };
+    return endian < 4 ? &codecs[endian] : NULL;
+}
+#else /* NADINE_STATIC || NADINE_IMPL */
+extern const nadine_codec *nadine_codec_for(unsigned endian);
+#endif /* NADINE_STATIC || NADINE_IMPL */
+
+/* sortable keys: big-endian with the sign bit of integers flipped, and
+   every bit of negative floats */
+
+/* values encoded at a time by the array key functions, on the stack */
+#define NADINE_I_KEY_CHUNK 1024
+
+#if NADINE_STATIC || NADINE_IMPL
+
+/* the highest bit of TU */
+#define NADINE_I_KEY_TOP(TU) ((TU)((TU)1 << (sizeof(TU) * CHAR_BIT - 1)))
+
+/* encode and decode the bits u of a TU key, by kind */
+#define NADINE_I_KEY_ENC_UI(TU, u) (u)
+#define NADINE_I_KEY_DEC_UI(TU, u) (u)
+#define NADINE_I_KEY_ENC_SI(TU, u) ((TU)((u) ^ NADINE_I_KEY_TOP(TU)))
+#define NADINE_I_KEY_DEC_SI(TU, u) ((TU)((u) ^ NADINE_I_KEY_TOP(TU)))
+/* the sign bit is set in negative floats, and clear in their keys */
+#define NADINE_I_KEY_ENC_F(TU, u)                                              \
+    ((TU)((u) ^ ((TU)(0 - ((u) >> (sizeof(TU) * CHAR_BIT - 1)))                \
+                 | NADINE_I_KEY_TOP(TU))))
+#define NADINE_I_KEY_DEC_F(TU, u)                                              \
+    ((TU)((u) ^ ((TU)(((u) >> (sizeof(TU) * CHAR_BIT - 1)) - 1)                \
+                 | NADINE_I_KEY_TOP(TU))))
+
+/* the bits of the T value held in u, copied from memory, by kind, and
+   back. only floats may be in another order than the integers */
+#define NADINE_I_KEY_BITS_UI(T, N, NU, u) (u)
+#define NADINE_I_KEY_BITS_SI(T, N, NU, u) (u)
+#define NADINE_I_KEY_BITS_F(T, N, NU, u)                                       \
+    nadine_convert_##NU(NADINE_I_NATIVE_FLOAT(T, N), u)
+
+/* define key functions for T of kind K (UI, SI or F), through unsigned
+   integer type TU of the same size */
+#define NADINE_I_IMPL_KEY(T, N, TU, NU, K)                                     \
+    NADINE_I_FN void nadine_write_key_##N(void *d, T value) {                  \
+        TU u;                                                                  \
+        nadine_i_memcpy(&u, &value, sizeof(TU));                               \
+        u = NADINE_I_KEY_BITS_##K(T, N, NU, u);                                \
+        nadine_write_be_##NU(d, NADINE_I_KEY_ENC_##K(TU, u));                  \
+    }                                                                          \
+    NADINE_I_FN T nadine_read_key_##N(const void *s) {                         \
+        TU u = nadine_read_be_##NU(s);                                         \
+        T v;                                                                   \
+        u = NADINE_I_KEY_DEC_##K(TU, u);                                       \
+        u = NADINE_I_KEY_BITS_##K(T, N, NU, u);                                \
+        nadine_i_memcpy(&v, &u, sizeof(TU));                                   \
+        return v;                                                              \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_array_key_##N(void *d, const T *s,           \
+                                                size_t count) {                \
+        /* cast for C++ compatibility */                                       \
+        unsigned char *dst = (unsigned char *)d;                               \
+        TU buf[NADINE_I_KEY_CHUNK];                                            \
+        while (count) {                                                        \
+            size_t n = count, i;                                               \
+            if (n > NADINE_I_KEY_CHUNK) n = NADINE_I_KEY_CHUNK;                \
+            nadine_i_memcpy(buf, s, n * sizeof(TU));                           \
+            for (i = 0; i < n; ++i) {                                          \
+                TU u = NADINE_I_KEY_BITS_##K(T, N, NU, buf[i]);                \
+                buf[i] = NADINE_I_KEY_ENC_##K(TU, u);                          \
+            }                                                                  \
+            nadine_write_array_##NU(NADINE_ENDIAN_BIG, dst, buf, n);           \
+            dst += n * sizeof(TU), s += n, count -= n;                         \
+        }                                                                      \
+    }                                                                          \
+    NADINE_I_FN void nadine_read_array_key_##N(T *d, const void *s,            \
+                                               size_t count) {                 \
+        /* cast for C++ compatibility */                                       \
+        const unsigned char *src = (const unsigned char *)s;                   \
+        TU buf[NADINE_I_KEY_CHUNK];                                            \
+        while (count) {                                                        \
+            size_t n = count, i;                                               \
+            if (n > NADINE_I_KEY_CHUNK) n = NADINE_I_KEY_CHUNK;                \
+            nadine_read_array_##NU(NADINE_ENDIAN_BIG, buf, src, n);            \
+            for (i = 0; i < n; ++i) {                                          \
+                TU u = NADINE_I_KEY_DEC_##K(TU, buf[i]);                       \
+                buf[i] = NADINE_I_KEY_BITS_##K(T, N, NU, u);                   \
+            }                                                                  \
+            nadine_i_memcpy(d, buf, n * sizeof(TU));                           \
+            d += n, src += n * sizeof(TU), count -= n;                         \
+        }                                                                      \
+    }
+
+/* define key functions for T, a struct of two words, flipping the chars
+   c of the first char of the key */
+#define NADINE_I_IMPL_KEY_W(T, N, c)                                           \
+    NADINE_I_FN void nadine_write_key_##N(void *d, T value) {                  \
+        nadine_write_be_##N(d, value);                                         \
+        *(unsigned char *)d ^= (c);                                            \
+    }                                                                          \
+    NADINE_I_FN T nadine_read_key_##N(const void *s) {                         \
+        unsigned char k[sizeof(T)];                                            \
+        nadine_i_memcpy(k, s, sizeof(T));                                      \
+        k[0] ^= (c);                                                           \
+        return nadine_read_be_##N(k);                                          \
+    }                                                                          \
+    NADINE_I_FN void nadine_write_array_key_##N(void *d, const T *s,           \
+                                                size_t count) {                \
+        /* cast for C++ compatibility */                                       \
+        unsigned char *dst = (unsigned char *)d;                               \
+        size_t i;                                                              \
+        for (i = 0; i < count; ++i)                                            \
+            nadine_write_key_##N(dst + i * sizeof(T), s[i]);                   \
+    }                                                                          \
+    NADINE_I_FN void nadine_read_array_key_##N(T *d, const void *s,            \
+                                               size_t count) {                 \
+        /* cast for C++ compatibility */                                       \
+        const unsigned char *src = (const unsigned char *)s;                   \
+        size_t i;                                                              \
+        for (i = 0; i < count; ++i)                                            \
+            d[i] = nadine_read_key_##N(src + i * sizeof(T));                   \
+    }
+
+#else /* NADINE_STATIC || NADINE_IMPL */
+
+#define NADINE_I_IMPL_KEY_W(T, N, c)                                           \
+    extern void nadine_write_key_##N(void *destination, T value);              \
+    extern T nadine_read_key_##N(const void *source);                          \
+    extern void nadine_write_array_key_##N(void *destination, const T *source, \
+                                           size_t count);                      \
+    extern void nadine_read_array_key_##N(T *destination, const void *source,  \
+                                          size_t count);
+#define NADINE_I_IMPL_KEY(T, N, TU, NU, K) NADINE_I_IMPL_KEY_W(T, N, 0)
+
+#endif /* NADINE_STATIC || NADINE_IMPL */
+
+/* expand NU before it is pasted */
+#define NADINE_I_IMPL_KEY_E(T, N, TU, NU, K) NADINE_I_IMPL_KEY(T, N, TU, NU, K)
+
+/* the sign bit of the first char of a signed key */
+#define NADINE_I_KEY_SIGN ((unsigned char)(1U << (CHAR_BIT - 1)))
+
+#define NADINE_I_IMPL_KEY_I(TS, NS, TU, NU)                                    \
+    NADINE_I_IMPL_KEY(TU, NU, TU, NU, UI)                                      \
+    NADINE_I_IMPL_KEY(TS, NS, TU, NU, SI)
+
+NADINE_I_IMPL_KEY_I(short, short, unsigned short, unsigned_short)
+NADINE_I_IMPL_KEY_I(int, int, unsigned int, unsigned_int)
+NADINE_I_IMPL_KEY_I(long, long, unsigned long, unsigned_long)
+#if NADINE_I_HAS_ULL
+NADINE_I_IMPL_KEY_I(long long, long_long, unsigned long long,
+                    unsigned_long_long)
+#endif
+#if NADINE_STDINT
+#if defined(UINT16_MAX) && defined(INT16_MAX)
+NADINE_I_IMPL_KEY_I(int16_t, int16, uint16_t, uint16)
+#endif
+#if defined(UINT32_MAX) && defined(INT32_MAX)
+NADINE_I_IMPL_KEY_I(int32_t, int32, uint32_t, uint32)
+#endif
+#if defined(UINT64_MAX) && defined(INT64_MAX)
+NADINE_I_IMPL_KEY_I(int64_t, int64, uint64_t, uint64)
+#endif
+#endif /* NADINE_STDINT */
+#if NADINE_INT128
+#if NADINE_I_HAS_INT128
+NADINE_I_IMPL_KEY_I(nadine_int128, int128, nadine_uint128, uint128)
+#else
+NADINE_I_IMPL_KEY_W(nadine_uint128, uint128, 0)
+NADINE_I_IMPL_KEY_W(nadine_int128, int128, NADINE_I_KEY_SIGN)
+#endif
+#endif /* NADINE_INT128 */
+#if NADINE_FLOAT
+#ifdef NADINE_I_FLOAT_UINT
+NADINE_I_IMPL_KEY_E(float, float, NADINE_I_FLOAT_UINT, NADINE_I_FLOAT_UINT_N,
+                    F)
+#endif
+#ifdef NADINE_I_DOUBLE_UINT
+NADINE_I_IMPL_KEY_E(double, double, NADINE_I_DOUBLE_UINT,
+                    NADINE_I_DOUBLE_UINT_N, F)
+#endif
+#endif /* NADINE_FLOAT */
+
+/* check half-precision floats */
+#ifndef NADINE_FLOAT16
+#if defined(NADINE_I_FLOAT_UINT) && USHRT_MAX == 0xFFFFU
+#define NADINE_FLOAT16 1
+#else
+#define NADINE_FLOAT16 0
+#endif
+#endif /* #ifndef NADINE_FLOAT16 */
+#if NADINE_FLOAT16 && (!defined(NADINE_I_FLOAT_UINT) || USHRT_MAX != 0xFFFFU)
+#error NADINE_FLOAT16=1 requires binary32 floats and a 16-bit unsigned short
+#endif
+
+#if NADINE_FLOAT16
+/* F16C converts 8 halves at a time. it is used if the CPU has it with
+   NADINE_DISPATCH, or else with the AVX2 and AVX-512 kernels, which the
+   compiler must be targeting with it */
+#if NADINE_I_SIMD_AVX2 && (NADINE_DISPATCH || defined(__F16C__)               \
+                           || (defined(_MSC_VER) && defined(__AVX2__)))
+#define NADINE_I_SIMD_F16C 1
+#endif
+/* AArch64 always has the half-precision conversions */
+#if NADINE_I_SIMD_NEON && NADINE_I_ARCH_ARM64
+#define NADINE_I_SIMD_FCVT 1
+#endif
+
+#if NADINE_STATIC || NADINE_IMPL
+
+/* bits of a binary16 value to the bits of the equal binary32 value */
+NADINE_I_FNS unsigned long nadine_i_half_to_float(unsigned long h) {
+    unsigned long s = (h & 0x8000UL) << 16, e = (h >> 10) & 0x1F;
+    unsigned long m = h & 0x3FF;
+    /* infinity or NaN. NaNs become quiet, like with F16C and NEON */
+    if (e == 0x1F)
+        return s | 0x7F800000UL | (m << 13) | (m ? 0x400000UL : 0);
+    if (e) return s | ((e + 112) << 23) | (m << 13);
+    if (!m) return s;
+    /* subnormal: normalize */
+    e = 113;
+    while (!(m & 0x400)) m <<= 1, --e;
+    return s | (e << 23) | ((m & 0x3FF) << 13);
+}
+
+/* bits of a binary32 value to the bits of a binary16 value,
+   rounded to nearest, ties to even */
+NADINE_I_FNS unsigned long nadine_i_float_to_half(unsigned long x) {
+    unsigned long s = (x >> 16) & 0x8000UL, e = (x >> 23) & 0xFF;
+    unsigned long m = x & 0x7FFFFFUL, r, half;
+    unsigned shift;
+    if (e == 0xFF)
+        return s | 0x7C00 | (m ? 0x200 | (m >> 13) : 0);
+    if (e > 142) return s | 0x7C00;
+    if (e >= 113) {
+        /* normal. a carry out of the mantissa goes into the exponent,
+           and from there into infinity, as it should */
+        r = ((e - 112) << 10) | (m >> 13);
+        m &= 0x1FFF;
+        if (m > 0x1000 || (m == 0x1000 && (r & 1))) ++r;
+        return s | r;
+    }
+    if (e < 102) return s;
+    /* subnormal */
+    m |= 0x800000UL;
+    shift = (unsigned)(126 - e);
+    r = m >> shift;
+    m &= (1UL << shift) - 1;
+    half = 1UL << (shift - 1);
+    if (m > half || (m == half && (r & 1))) ++r;
+    return s | r;
+}
+
+/* bits of a binary32 value to the bits of a bfloat16 value,
+   rounded to nearest, ties to even */
+NADINE_I_FNS unsigned long nadine_i_float_to_bfloat(unsigned long x) {
+    /* quiet NaNs instead of letting them round into infinity */
+    if ((x & 0x7FFFFFFFUL) > 0x7F800000UL)
+        return ((x >> 16) | 0x40) & 0xFFFF;
+    return ((x + 0x7FFF + ((x >> 16) & 1)) >> 16) & 0xFFFF;
+}
+
+NADINE_I_FNS float nadine_i_float_from_bits(unsigned long x) {
+    float v;
+    NADINE_I_MAKE_TYPE_ALIASER(u, float, NADINE_I_FLOAT_UINT);
+    NADINE_I_TYPE_ALIASED(u) = (NADINE_I_FLOAT_UINT)x;
+    NADINE_I_TYPE_ALIAS_UNDO(u, float, NADINE_I_FLOAT_UINT, v);
+    return v;
+}
+
+NADINE_I_FNS unsigned long nadine_i_float_bits(float v) {
+    NADINE_I_MAKE_TYPE_ALIASER(u, float, NADINE_I_FLOAT_UINT);
+    NADINE_I_TYPE_ALIAS_DO(u, float, NADINE_I_FLOAT_UINT, v);
+    return (unsigned long)NADINE_I_TYPE_ALIASED(u);
+}
+
+/* SIMD half kernels: convert halves s[n] to floats d[n], or floats s[n] to
+   halves d[n], with the chars of every half transformed for XORed endians
+   xf in the same pass. return how many values were processed, from the
+   start of the array */
+#if NADINE_I_SIMD_F16C
+NADINE_I_FN NADINE_I_TARGET("avx,f16c")
+size_t nadine_i_simd_half_read_f16c(float *d, const void *s, size_t n,
+                                    unsigned xf) {
+    /* cast for C++ compatibility */
+    const unsigned char *b = (const unsigned char *)s;
+    size_t i = 0;
+    int swap;
+    if (xf > 3) return 0;
+    swap = NADINE_I_SIMD_XOR(2, xf) != 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(b + i * 2));
+        if (swap)
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm256_storeu_ps(d + i, _mm256_cvtph_ps(v));
+    }
+    return i;
+}
+
+NADINE_I_FN NADINE_I_TARGET("avx,f16c")
+size_t nadine_i_simd_half_write_f16c(void *d, const float *s, size_t n,
+                                     unsigned xf) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)d;
+    size_t i = 0;
+    int swap;
+    if (xf > 3) return 0;
+    swap = NADINE_I_SIMD_XOR(2, xf) != 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm256_cvtps_ph(_mm256_loadu_ps(s + i),
+                                    _MM_FROUND_TO_NEAREST_INT);
+        if (swap)
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_si128((__m128i *)(a + i * 2), v);
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_F16C */
+
+#if NADINE_I_SIMD_FCVT
+NADINE_I_FN
+size_t nadine_i_simd_half_read_neon(float *d, const void *s, size_t n,
+                                    unsigned xf) {
+    /* cast for C++ compatibility */
+    const unsigned char *b = (const unsigned char *)s;
+    size_t i = 0;
+    int swap;
+    if (xf > 3) return 0;
+    swap = NADINE_I_SIMD_XOR(2, xf) != 0;
+    for (; i + 8 <= n; i += 8) {
+        uint8x16_t v = vld1q_u8(b + i * 2);
+        uint16x8_t h;
+        if (swap) v = vrev16q_u8(v);
+        h = vreinterpretq_u16_u8(v);
+        vst1q_f32(d + i, vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(h))));
+        vst1q_f32(d + i + 4,
+                  vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(h))));
+    }
+    return i;
+}
+
+NADINE_I_FN
+size_t nadine_i_simd_half_write_neon(void *d, const float *s, size_t n,
+                                     unsigned xf) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)d;
+    size_t i = 0;
+    int swap;
+    if (xf > 3) return 0;
+    swap = NADINE_I_SIMD_XOR(2, xf) != 0;
+    for (; i + 8 <= n; i += 8) {
+        float16x4_t lo = vcvt_f16_f32(vld1q_f32(s + i));
+        float16x4_t hi = vcvt_f16_f32(vld1q_f32(s + i + 4));
+        uint8x16_t v = vreinterpretq_u8_u16(vcombine_u16(
+                vreinterpret_u16_f16(lo), vreinterpret_u16_f16(hi)));
+        if (swap) v = vrev16q_u8(v);
+        vst1q_u8(a + i * 2, v);
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_FCVT */
+
+#if NADINE_DISPATCH
+#define NADINE_I_HALF_KERNEL nadine_simd_kernel()
+#else
+#define NADINE_I_HALF_KERNEL NADINE_I_KERNEL
+#endif
+
+/* run the half kernel for the kernel in use, if there is one */
+NADINE_I_FNS size_t nadine_i_simd_half_read(float *d, const void *s,
+                                            size_t n, unsigned xf) {
+#if NADINE_I_SIMD_F16C && NADINE_DISPATCH
+    if (nadine_i_simd_features() & NADINE_I_FEATURE_F16C)
+        return nadine_i_simd_half_read_f16c(d, s, n, xf);
+#elif NADINE_I_SIMD_F16C
+    if (NADINE_I_KERNEL == NADINE_KERNEL_AVX2
+            || NADINE_I_KERNEL == NADINE_KERNEL_AVX512)
+        return nadine_i_simd_half_read_f16c(d, s, n, xf);
+#elif NADINE_I_SIMD_FCVT
+    if (NADINE_I_HALF_KERNEL == NADINE_KERNEL_NEON)
+        return nadine_i_simd_half_read_neon(d, s, n, xf);
+#endif
+    (void)d, (void)s, (void)n, (void)xf;
+    return 0;
+}
+
+NADINE_I_FNS size_t nadine_i_simd_half_write(void *d, const float *s,
+                                             size_t n, unsigned xf) {
+#if NADINE_I_SIMD_F16C && NADINE_DISPATCH
+    if (nadine_i_simd_features() & NADINE_I_FEATURE_F16C)
+        return nadine_i_simd_half_write_f16c(d, s, n, xf);
+#elif NADINE_I_SIMD_F16C
+    if (NADINE_I_KERNEL == NADINE_KERNEL_AVX2
+            || NADINE_I_KERNEL == NADINE_KERNEL_AVX512)
+        return nadine_i_simd_half_write_f16c(d, s, n, xf);
+#elif NADINE_I_SIMD_FCVT
+    if (NADINE_I_HALF_KERNEL == NADINE_KERNEL_NEON)
+        return nadine_i_simd_half_write_neon(d, s, n, xf);
+#endif
+    (void)d, (void)s, (void)n, (void)xf;
+    return 0;
+}
+
+NADINE_I_FN float nadine_read_float16(unsigned endian, const void *s) {
+    return nadine_i_float_from_bits(
+            nadine_i_half_to_float(nadine_read_unsigned_short(endian, s)));
+}
+
+NADINE_I_FN void nadine_write_float16(unsigned endian, void *d, float v) {
+    nadine_write_unsigned_short(endian, d, (unsigned short)
+            nadine_i_float_to_half(nadine_i_float_bits(v)));
+}
+
+NADINE_I_FN void nadine_read_array_float16(unsigned endian, float *d,
+                                           const void *s, size_t count) {
+    size_t i = nadine_i_simd_half_read(d, s, count,
+                        endian ^ nadine_endian_native_unsigned_short());
+    /* cast for C++ compatibility. the pointers are advanced rather than
+       indexed with i, which GCC warns may overflow after the kernel */
+    const unsigned char *src = (const unsigned char *)s + i * 2;
+    for (count -= i, d += i; count; --count, ++d, src += 2)
+        *d = nadine_read_float16(endian, src);
+}
+
+NADINE_I_FN void nadine_write_array_float16(unsigned endian, void *d,
+                                            const float *s, size_t count) {
+    size_t i = nadine_i_simd_half_write(d, s, count,
+                        endian ^ nadine_endian_native_unsigned_short());
+    /* cast for C++ compatibility; advanced as in the above */
+    unsigned char *dst = (unsigned char *)d + i * 2;
+    for (count -= i, s += i; count; --count, ++s, dst += 2)
+        nadine_write_float16(endian, dst, *s);
+}
+
+NADINE_I_FN float nadine_read_bfloat16(unsigned endian, const void *s) {
+    unsigned long x = nadine_read_unsigned_short(endian, s);
+    return nadine_i_float_from_bits(x << 16);
+}
+
+NADINE_I_FN void nadine_write_bfloat16(unsigned endian, void *d, float v) {
+    nadine_write_unsigned_short(endian, d, (unsigned short)
+            nadine_i_float_to_bfloat(nadine_i_float_bits(v)));
+}
+
+NADINE_I_FN void nadine_read_array_bfloat16(unsigned endian, float *d,
+                                            const void *s, size_t count) {
+    /* cast for C++ compatibility */
+    const unsigned char *src = (const unsigned char *)s;
+    size_t i;
+    for (i = 0; i < count; ++i, src += 2)
+        d[i] = nadine_read_bfloat16(endian, src);
+}
+
+NADINE_I_FN void nadine_write_array_bfloat16(unsigned endian, void *d,
+                                             const float *s, size_t count) {
+    /* cast for C++ compatibility */
+    unsigned char *dst = (unsigned char *)d;
+    size_t i;
+    for (i = 0; i < count; ++i, dst += 2)
+        nadine_write_bfloat16(endian, dst, s[i]);
+}
+
+#else /* NADINE_STATIC || NADINE_IMPL */
+
+extern float nadine_read_float16(unsigned endian, const void *source);
+extern void nadine_write_float16(unsigned endian, void *destination,
+                                 float value);
+extern void nadine_read_array_float16(unsigned endian, float *destination,
+                                      const void *source, size_t count);
+extern void nadine_write_array_float16(unsigned endian, void *destination,
+                                       const float *source, size_t count);
+extern float nadine_read_bfloat16(unsigned endian, const void *source);
+extern void nadine_write_bfloat16(unsigned endian, void *destination,
+                                  float value);
+extern void nadine_read_array_bfloat16(unsigned endian, float *destination,
+                                       const void *source, size_t count);
+extern void nadine_write_array_bfloat16(unsigned endian, void *destination,
+                                        const float *source, size_t count);
+
+#endif /* NADINE_STATIC || NADINE_IMPL */
+#endif /* NADINE_FLOAT16 */
+
+#if CHAR_BIT == 8
+/* CRC32C instructions: SSE4.2 on x86 (checked at run time with
+   NADINE_DISPATCH), and the CRC extension on ARMv8 */
+#if NADINE_I_SIMD_AVX2 || (NADINE_I_SIMD_SSE2 && defined(__SSE4_2__))
+#define NADINE_I_SIMD_CRC32C_X86 1
+#elif NADINE_I_SIMD_NEON && defined(__ARM_FEATURE_CRC32)                      \
+        && !defined(__ARM_BIG_ENDIAN)
+#define NADINE_I_SIMD_CRC32C_ARM 1
+#endif
+
+/* chars converted at a time by the checksumming array functions, so that
+   the checksum is taken while the chars are still in the cache */
+#define NADINE_I_CHECKSUM_CHUNK 4096
+
+#if NADINE_STATIC || NADINE_IMPL
+
+/* CRC32C (Castagnoli) of every char value, reflected */
+static const unsigned long nadine_i_crc32c_table[256] = {
+    0x00000000UL, 0xF26B8303UL, 0xE13B70F7UL, 0x1350F3F4UL,
+    0xC79A971FUL, 0x35F1141CUL, 0x26A1E7E8UL, 0xD4CA64EBUL,
+    0x8AD958CFUL, 0x78B2DBCCUL, 0x6BE22838UL, 0x9989AB3BUL,
+    0x4D43CFD0UL, 0xBF284CD3UL, 0xAC78BF27UL, 0x5E133C24UL,
+    0x105EC76FUL, 0xE235446CUL, 0xF165B798UL, 0x030E349BUL,
+    0xD7C45070UL, 0x25AFD373UL, 0x36FF2087UL, 0xC494A384UL,
+    0x9A879FA0UL, 0x68EC1CA3UL, 0x7BBCEF57UL, 0x89D76C54UL,
+    0x5D1D08BFUL, 0xAF768BBCUL, 0xBC267848UL, 0x4E4DFB4BUL,
+    0x20BD8EDEUL, 0xD2D60DDDUL, 0xC186FE29UL, 0x33ED7D2AUL,
+    0xE72719C1UL, 0x154C9AC2UL, 0x061C6936UL, 0xF477EA35UL,
+    0xAA64D611UL, 0x580F5512UL, 0x4B5FA6E6UL, 0xB93425E5UL,
+    0x6DFE410EUL, 0x9F95C20DUL, 0x8CC531F9UL, 0x7EAEB2FAUL,
+    0x30E349B1UL, 0xC288CAB2UL, 0xD1D83946UL, 0x23B3BA45UL,
+    0xF779DEAEUL, 0x05125DADUL, 0x1642AE59UL, 0xE4292D5AUL,
+    0xBA3A117EUL, 0x4851927DUL, 0x5B016189UL, 0xA96AE28AUL,
+    0x7DA08661UL, 0x8FCB0562UL, 0x9C9BF696UL, 0x6EF07595UL,
+    0x417B1DBCUL, 0xB3109EBFUL, 0xA0406D4BUL, 0x522BEE48UL,
+    0x86E18AA3UL, 0x748A09A0UL, 0x67DAFA54UL, 0x95B17957UL,
+    0xCBA24573UL, 0x39C9C670UL, 0x2A993584UL, 0xD8F2B687UL,
+    0x0C38D26CUL, 0xFE53516FUL, 0xED03A29BUL, 0x1F682198UL,
+    0x5125DAD3UL, 0xA34E59D0UL, 0xB01EAA24UL, 0x42752927UL,
+    0x96BF4DCCUL, 0x64D4CECFUL, 0x77843D3BUL, 0x85EFBE38UL,
+    0xDBFC821CUL, 0x2997011FUL, 0x3AC7F2EBUL, 0xC8AC71E8UL,
+    0x1C661503UL, 0xEE0D9600UL, 0xFD5D65F4UL, 0x0F36E6F7UL,
+    0x61C69362UL, 0x93AD1061UL, 0x80FDE395UL, 0x72966096UL,
+    0xA65C047DUL, 0x5437877EUL, 0x4767748AUL, 0xB50CF789UL,
+    0xEB1FCBADUL, 0x197448AEUL, 0x0A24BB5AUL, 0xF84F3859UL,
+    0x2C855CB2UL, 0xDEEEDFB1UL, 0xCDBE2C45UL, 0x3FD5AF46UL,
+    0x7198540DUL, 0x83F3D70EUL, 0x90A324FAUL, 0x62C8A7F9UL,
+    0xB602C312UL, 0x44694011UL, 0x5739B3E5UL, 0xA55230E6UL,
+    0xFB410CC2UL, 0x092A8FC1UL, 0x1A7A7C35UL, 0xE811FF36UL,
+    0x3CDB9BDDUL, 0xCEB018DEUL, 0xDDE0EB2AUL, 0x2F8B6829UL,
+    0x82F63B78UL, 0x709DB87BUL, 0x63CD4B8FUL, 0x91A6C88CUL,
+    0x456CAC67UL, 0xB7072F64UL, 0xA457DC90UL, 0x563C5F93UL,
+    0x082F63B7UL, 0xFA44E0B4UL, 0xE9141340UL, 0x1B7F9043UL,
+    0xCFB5F4A8UL, 0x3DDE77ABUL, 0x2E8E845FUL, 0xDCE5075CUL,
+    0x92A8FC17UL, 0x60C37F14UL, 0x73938CE0UL, 0x81F80FE3UL,
+    0x55326B08UL, 0xA759E80BUL, 0xB4091BFFUL, 0x466298FCUL,
+    0x1871A4D8UL, 0xEA1A27DBUL, 0xF94AD42FUL, 0x0B21572CUL,
+    0xDFEB33C7UL, 0x2D80B0C4UL, 0x3ED04330UL, 0xCCBBC033UL,
+    0xA24BB5A6UL, 0x502036A5UL, 0x4370C551UL, 0xB11B4652UL,
+    0x65D122B9UL, 0x97BAA1BAUL, 0x84EA524EUL, 0x7681D14DUL,
+    0x2892ED69UL, 0xDAF96E6AUL, 0xC9A99D9EUL, 0x3BC21E9DUL,
+    0xEF087A76UL, 0x1D63F975UL, 0x0E330A81UL, 0xFC588982UL,
+    0xB21572C9UL, 0x407EF1CAUL, 0x532E023EUL, 0xA145813DUL,
+    0x758FE5D6UL, 0x87E466D5UL, 0x94B49521UL, 0x66DF1622UL,
+    0x38CC2A06UL, 0xCAA7A905UL, 0xD9F75AF1UL, 0x2B9CD9F2UL,
+    0xFF56BD19UL, 0x0D3D3E1AUL, 0x1E6DCDEEUL, 0xEC064EEDUL,
+    0xC38D26C4UL, 0x31E6A5C7UL, 0x22B65633UL, 0xD0DDD530UL,
+    0x0417B1DBUL, 0xF67C32D8UL, 0xE52CC12CUL, 0x1747422FUL,
+    0x49547E0BUL, 0xBB3FFD08UL, 0xA86F0EFCUL, 0x5A048DFFUL,
+    0x8ECEE914UL, 0x7CA56A17UL, 0x6FF599E3UL, 0x9D9E1AE0UL,
+    0xD3D3E1ABUL, 0x21B862A8UL, 0x32E8915CUL, 0xC083125FUL,
+    0x144976B4UL, 0xE622F5B7UL, 0xF5720643UL, 0x07198540UL,
+    0x590AB964UL, 0xAB613A67UL, 0xB831C993UL, 0x4A5A4A90UL,
+    0x9E902E7BUL, 0x6CFBAD78UL, 0x7FAB5E8CUL, 0x8DC0DD8FUL,
+    0xE330A81AUL, 0x115B2B19UL, 0x020BD8EDUL, 0xF0605BEEUL,
+    0x24AA3F05UL, 0xD6C1BC06UL, 0xC5914FF2UL, 0x37FACCF1UL,
+    0x69E9F0D5UL, 0x9B8273D6UL, 0x88D28022UL, 0x7AB90321UL,
+    0xAE7367CAUL, 0x5C18E4C9UL, 0x4F48173DUL, 0xBD23943EUL,
+    0xF36E6F75UL, 0x0105EC76UL, 0x12551F82UL, 0xE03E9C81UL,
+    0x34F4F86AUL, 0xC69F7B69UL, 0xD5CF889DUL, 0x27A40B9EUL,
+    0x79B737BAUL, 0x8BDCB4B9UL, 0x988C474DUL, 0x6AE7C44EUL,
+    0xBE2DA0A5UL, 0x4C4623A6UL, 0x5F16D052UL, 0xAD7D5351UL
+};
+
+/* CRC32C kernels: continue the CRC32C crc (not inverted) over p[n] */
+NADINE_I_FNS unsigned long nadine_i_crc32c_scalar(unsigned long crc,
+                                                  const unsigned char *p,
+                                                  size_t n) {
+    for (; n; --n, ++p)
+        crc = nadine_i_crc32c_table[(crc ^ *p) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+#if NADINE_I_SIMD_CRC32C_X86
+NADINE_I_FN NADINE_I_TARGET("sse4.2")
+unsigned long nadine_i_crc32c_sse42(unsigned long crc, const unsigned char *p,
+                                    size_t n) {
+#if defined(__x86_64__) || defined(_M_X64)
+    NADINE_I_U64 w;
+    for (; n >= 8; n -= 8, p += 8) {
+        nadine_i_memcpy(&w, p, 8);
+        crc = (unsigned long)_mm_crc32_u64(crc, w);
+    }
+#else
+    NADINE_I_U32 w;
+    for (; n >= 4; n -= 4, p += 4) {
+        nadine_i_memcpy(&w, p, 4);
+        crc = (unsigned long)_mm_crc32_u32((unsigned)crc, w);
+    }
+#endif
+    for (; n; --n, ++p)
+        crc = (unsigned long)_mm_crc32_u8((unsigned)crc, *p);
+    return crc;
+}
+#endif /* NADINE_I_SIMD_CRC32C_X86 */
+
+#if NADINE_I_SIMD_CRC32C_ARM
+NADINE_I_FN
+unsigned long nadine_i_crc32c_arm(unsigned long crc, const unsigned char *p,
+                                  size_t n) {
+#if NADINE_I_ARCH_ARM64
+    NADINE_I_U64 w;
+    for (; n >= 8; n -= 8, p += 8) {
+        nadine_i_memcpy(&w, p, 8);
+        crc = __crc32cd((NADINE_I_U32)crc, w);
+    }
+#else
+    NADINE_I_U32 w;
+    for (; n >= 4; n -= 4, p += 4) {
+        nadine_i_memcpy(&w, p, 4);
+        crc = __crc32cw((NADINE_I_U32)crc, w);
+    }
+#endif
+    for (; n; --n, ++p)
+        crc = __crc32cb((NADINE_I_U32)crc, *p);
+    return crc;
+}
+#endif /* NADINE_I_SIMD_CRC32C_ARM */
+
+/* CRC32C with the instructions for the kernel in use */
+NADINE_I_FNS unsigned long nadine_i_crc32c(unsigned long crc,
+                                           const unsigned char *p, size_t n) {
+#if NADINE_DISPATCH && NADINE_I_SIMD_CRC32C_X86
+    if (nadine_i_simd_features() & NADINE_I_FEATURE_SSE42)
+        return nadine_i_crc32c_sse42(crc, p, n);
+#elif NADINE_I_SIMD_CRC32C_X86 && NADINE_I_KERNEL != NADINE_KERNEL_SCALAR     \
+        && (defined(__SSE4_2__) || NADINE_I_KERNEL >= NADINE_KERNEL_AVX2)
+    return nadine_i_crc32c_sse42(crc, p, n);
+#elif NADINE_I_SIMD_CRC32C_ARM && NADINE_I_KERNEL == NADINE_KERNEL_NEON
+    return nadine_i_crc32c_arm(crc, p, n);
+#endif
+    return nadine_i_crc32c_scalar(crc, p, n);
+}
+
+/* SIMD 16-bit sum kernels: add the native 16-bit values p[n] to *sum in
+   32-bit lanes. n must be at most NADINE_I_CHECKSUM_CHUNK / 2, so that the
+   lanes do not overflow. return how many values were added, from the start
+   of the array */
+#if NADINE_I_SIMD_SSE2
+NADINE_I_FN NADINE_I_TARGET("sse2")
+size_t nadine_i_simd_sum16_sse2(const void *p, size_t n, unsigned long *sum) {
+    /* cast for C++ compatibility */
+    const unsigned char *b = (const unsigned char *)p;
+    const __m128i lo = _mm_set1_epi32(0xFFFF);
+    __m128i a = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(b + i * 2));
+        a = _mm_add_epi32(a, _mm_and_si128(v, lo));
+        a = _mm_add_epi32(a, _mm_srli_epi32(v, 16));
+    }
+    a = _mm_add_epi32(a, _mm_srli_si128(a, 8));
+    a = _mm_add_epi32(a, _mm_srli_si128(a, 4));
+    *sum += (unsigned long)(unsigned)_mm_cvtsi128_si32(a);
+    return i;
+}
+#endif /* NADINE_I_SIMD_SSE2 */
+
+#if NADINE_I_SIMD_AVX2
+NADINE_I_FN NADINE_I_TARGET("avx2")
+size_t nadine_i_simd_sum16_avx2(const void *p, size_t n, unsigned long *sum) {
+    /* cast for C++ compatibility */
+    const unsigned char *b = (const unsigned char *)p;
+    const __m256i lo = _mm256_set1_epi32(0xFFFF);
+    __m256i a = _mm256_setzero_si256();
+    __m128i h;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(b + i * 2));
+        a = _mm256_add_epi32(a, _mm256_and_si256(v, lo));
+        a = _mm256_add_epi32(a, _mm256_srli_epi32(v, 16));
+    }
+    h = _mm_add_epi32(_mm256_castsi256_si128(a),
+                      _mm256_extracti128_si256(a, 1));
+    h = _mm_add_epi32(h, _mm_srli_si128(h, 8));
+    h = _mm_add_epi32(h, _mm_srli_si128(h, 4));
+    *sum += (unsigned long)(unsigned)_mm_cvtsi128_si32(h);
+    return i;
+}
+#endif /* NADINE_I_SIMD_AVX2 */
+
+#if NADINE_I_SIMD_NEON
+NADINE_I_FN
+size_t nadine_i_simd_sum16_neon(const void *p, size_t n, unsigned long *sum) {
+    /* cast for C++ compatibility */
+    const uint16_t *b = (const uint16_t *)p;
+    uint32x4_t a = vdupq_n_u32(0);
+    uint64x2_t s;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        a = vpadalq_u16(a, vld1q_u16(b + i));
+    s = vpaddlq_u32(a);
+    *sum += (unsigned long)(vgetq_lane_u64(s, 0) + vgetq_lane_u64(s, 1));
+    return i;
+}
+#endif /* NADINE_I_SIMD_NEON */
+
+/* add with the 16-bit sum kernel for the kernel in use */
+NADINE_I_FNS size_t nadine_i_simd_sum16(const void *p, size_t n,
+                                        unsigned long *sum) {
+#if NADINE_DISPATCH
+    switch (nadine_simd_kernel()) {
+#if NADINE_I_SIMD_SSE2
+    case NADINE_KERNEL_SSE2:
+    case NADINE_KERNEL_SSSE3:
+        return nadine_i_simd_sum16_sse2(p, n, sum);
+    case NADINE_KERNEL_AVX2:
+    case NADINE_KERNEL_AVX512:
+        return nadine_i_simd_sum16_avx2(p, n, sum);
+#endif
+#if NADINE_I_SIMD_NEON
+    case NADINE_KERNEL_NEON:
+        return nadine_i_simd_sum16_neon(p, n, sum);
+#endif
+    }
+#elif NADINE_I_SIMD_AVX2 && NADINE_I_KERNEL >= NADINE_KERNEL_AVX2            \
+        && NADINE_I_KERNEL <= NADINE_KERNEL_AVX512
+    return nadine_i_simd_sum16_avx2(p, n, sum);
+#elif NADINE_I_SIMD_SSE2 && (NADINE_I_KERNEL == NADINE_KERNEL_SSE2           \
+                             || NADINE_I_KERNEL == NADINE_KERNEL_SSSE3)
+    return nadine_i_simd_sum16_sse2(p, n, sum);
+#elif NADINE_I_SIMD_NEON && NADINE_I_KERNEL == NADINE_KERNEL_NEON
+    return nadine_i_simd_sum16_neon(p, n, sum);
+#endif
+    (void)p, (void)n, (void)sum;
+    return 0;
+}
+
+/* define read-and-sum array function for 16-bit unsigned type T */
+#define NADINE_I_IMPL_SUM16(T, N)                                              \
+    NADINE_I_FN unsigned nadine_read_array_sum_##N(unsigned endian, T *d,      \
+                                                   const void *s,              \
+                                                   size_t count,               \
+                                                   unsigned sum) {             \
+        /* cast for C++ compatibility */                                       \
+        const unsigned char *src = (const unsigned char *)s;                   \
+        unsigned long acc = (sum & 0xFFFFUL) + (sum >> 8 >> 8);                \
+        while (count) {                                                        \
+            size_t n = count, i;                                               \
+            if (n > NADINE_I_CHECKSUM_CHUNK / 2)                               \
+                n = NADINE_I_CHECKSUM_CHUNK / 2;                               \
+            nadine_read_array_##N(endian, d, src, n);                          \
+            i = nadine_i_simd_sum16(d, n, &acc);                               \
+            for (; i < n; ++i)                                                 \
+                acc += d[i];                                                   \
+            acc = (acc & 0xFFFFUL) + (acc >> 16);                              \
+            d += n, src += n * 2, count -= n;                                  \
+        }                                                                      \
+        acc = (acc & 0xFFFFUL) + (acc >> 16);                                  \
+        return (unsigned)((acc & 0xFFFFUL) + (acc >> 16));                     \
+    }
+
+/* define read-and-CRC32C array function for T */
+#define NADINE_I_IMPL_CRC32C(T, N)                                             \
+    NADINE_I_FN unsigned long nadine_read_array_crc32c_##N(unsigned endian,    \
+                                                           T *d,               \
+                                                           const void *s,      \
+                                                           size_t count,       \
+                                                           unsigned long crc) {\
+        /* cast for C++ compatibility */                                       \
+        const unsigned char *src = (const unsigned char *)s;                   \
+        crc = ~crc & 0xFFFFFFFFUL;                                             \
+        while (count) {                                                        \
+            size_t n = count;                                                  \
+            if (n > NADINE_I_CHECKSUM_CHUNK / sizeof(T))                       \
+                n = NADINE_I_CHECKSUM_CHUNK / sizeof(T);                       \
+            nadine_read_array_##N(endian, d, src, n);                          \
+            crc = nadine_i_crc32c(crc, src, n * sizeof(T));                    \
+            d += n, src += n * sizeof(T), count -= n;                          \
+        }                                                                      \
+        return ~crc & 0xFFFFFFFFUL;                                            \
+    }
+
+#else /* NADINE_STATIC || NADINE_IMPL */
+
+#define NADINE_I_IMPL_SUM16(T, N)                                              \
+    extern unsigned nadine_read_array_sum_##N(unsigned endian,                 \
+                                              T *destination,                  \
+                                              const void *source,              \
+                                              size_t count, unsigned sum);
+#define NADINE_I_IMPL_CRC32C(T, N)                                             \
+    extern unsigned long nadine_read_array_crc32c_##N(unsigned endian,         \
+                                                      T *destination,          \
+                                                      const void *source,      \
+                                                      size_t count,            \
+                                                      unsigned long crc);
+
+#endif /* NADINE_STATIC || NADINE_IMPL */
+
+#if USHRT_MAX == 0xFFFFU
+NADINE_I_IMPL_SUM16(unsigned short, unsigned_short)
+#endif
+#if NADINE_STDINT && defined(UINT16_MAX)
+NADINE_I_IMPL_SUM16(uint16_t, uint16)
+#endif
+
+NADINE_I_IMPL_CRC32C(short, short)
+NADINE_I_IMPL_CRC32C(unsigned short, unsigned_short)
+NADINE_I_IMPL_CRC32C(int, int)
+NADINE_I_IMPL_CRC32C(unsigned int, unsigned_int)
+NADINE_I_IMPL_CRC32C(long, long)
+NADINE_I_IMPL_CRC32C(unsigned long, unsigned_long)
+#if NADINE_I_HAS_ULL
+NADINE_I_IMPL_CRC32C(long long, long_long)
+NADINE_I_IMPL_CRC32C(unsigned long long, unsigned_long_long)
+#endif
+#if NADINE_STDINT
+#if defined(UINT16_MAX) && defined(INT16_MAX)
+NADINE_I_IMPL_CRC32C(int16_t, int16)
+NADINE_I_IMPL_CRC32C(uint16_t, uint16)
+#endif
+#if defined(UINT32_MAX) && defined(INT32_MAX)
+NADINE_I_IMPL_CRC32C(int32_t, int32)
+NADINE_I_IMPL_CRC32C(uint32_t, uint32)
+#endif
+#if defined(UINT64_MAX) && defined(INT64_MAX)
+NADINE_I_IMPL_CRC32C(int64_t, int64)
+NADINE_I_IMPL_CRC32C(uint64_t, uint64)
+#endif
+#endif /* NADINE_STDINT */
+#if NADINE_INT128
+NADINE_I_IMPL_CRC32C(nadine_int128, int128)
+NADINE_I_IMPL_CRC32C(nadine_uint128, uint128)
+#endif
+#if NADINE_FLOAT
+NADINE_I_IMPL_CRC32C(float, float)
+NADINE_I_IMPL_CRC32C(double, double)
+#endif
+#endif /* CHAR_BIT == 8 */
+
+/* values converted at a time by nadine_minmax_N, on the stack */
+#define NADINE_I_MINMAX_CHUNK 1024
+
+#if NADINE_STATIC || NADINE_IMPL
+
+/* SIMD find kernels: compare the elements of p[n], size chars each, with
+   the size chars at key. return the index of the first one equal to key,
+   or how many were compared, if none was. size must be 2, 4 or 8 */
+#if NADINE_I_SIMD && CHAR_BIT == 8
+NADINE_I_FNS void nadine_i_simd_find_key(unsigned char *k, size_t w,
+                                         const unsigned char *key,
+                                         size_t size) {
+    size_t j;
+    for (j = 0; j < w; ++j)
+        k[j] = key[j % size];
+}
+#endif /* NADINE_I_SIMD && CHAR_BIT == 8 */
+
+#if NADINE_I_SIMD_SSE2 && CHAR_BIT == 8
+NADINE_I_FN NADINE_I_TARGET("sse2")
+size_t nadine_i_simd_find_sse2(const void *p, size_t n, size_t size,
+                               const unsigned char *key) {
+    /* cast for C++ compatibility */
+    const unsigned char *b = (const unsigned char *)p;
+    const unsigned full = (1U << size) - 1, step = 16 / (unsigned)size;
+    unsigned char k[16];
+    size_t i = 0, j;
+    __m128i kv;
+    nadine_i_simd_find_key(k, 16, key, size);
+    kv = _mm_loadu_si128((const __m128i *)k);
+    for (; i + step <= n; i += step) {
+        /* one bit for every equal char */
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128((const __m128i *)(b + i * size)), kv));
+        if (m)
+            for (j = 0; j < step; ++j)
+                if ((m >> (j * size) & full) == full) return i + j;
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_SSE2 && CHAR_BIT == 8 */
+
+#if NADINE_I_SIMD_AVX2 && CHAR_BIT == 8
+NADINE_I_FN NADINE_I_TARGET("avx2")
+size_t nadine_i_simd_find_avx2(const void *p, size_t n, size_t size,
+                               const unsigned char *key) {
+    /* cast for C++ compatibility */
+    const unsigned char *b = (const unsigned char *)p;
+    const unsigned long full = (1UL << size) - 1;
+    const unsigned step = 32 / (unsigned)size;
+    unsigned char k[32];
+    size_t i = 0, j;
+    __m256i kv;
+    nadine_i_simd_find_key(k, 32, key, size);
+    kv = _mm256_loadu_si256((const __m256i *)k);
+    for (; i + step <= n; i += step) {
+        unsigned long m = (unsigned long)(unsigned)_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(_mm256_loadu_si256(
+                        (const __m256i *)(b + i * size)), kv));
+        if (m)
+            for (j = 0; j < step; ++j)
+                if ((m >> (j * size) & full) == full) return i + j;
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_AVX2 && CHAR_BIT == 8 */
+
+#if NADINE_I_SIMD_NEON && CHAR_BIT == 8
+NADINE_I_FN
+size_t nadine_i_simd_find_neon(const void *p, size_t n, size_t size,
+                               const unsigned char *key) {
+    /* cast for C++ compatibility */
+    const unsigned char *b = (const unsigned char *)p;
+    const uint64_t full = ((uint64_t)1 << (size * 4)) - 1;
+    const size_t step = 16 / size;
+    unsigned char k[16];
+    size_t i = 0, j;
+    uint8x16_t kv;
+    nadine_i_simd_find_key(k, 16, key, size);
+    kv = vld1q_u8(k);
+    for (; i + step <= n; i += step) {
+        /* narrow to 4 bits for every equal char */
+        uint8x16_t e = vceqq_u8(vld1q_u8(b + i * size), kv);
+        uint64_t m = vget_lane_u64(vreinterpret_u64_u8(
+                vshrn_n_u16(vreinterpretq_u16_u8(e), 4)), 0);
+        if (m)
+            for (j = 0; j < step; ++j)
+                if ((m >> (j * size * 4) & full) == full) return i + j;
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_NEON && CHAR_BIT == 8 */
+
+/* find with the find kernel for the kernel in use */
+NADINE_I_FNS size_t nadine_i_simd_find(const void *p, size_t n, size_t size,
+                                       const unsigned char *key) {
+#if NADINE_I_SIMD && CHAR_BIT == 8
+    if (size != 2 && size != 4 && size != 8)
+        return 0;
+#if NADINE_DISPATCH
+    switch (nadine_simd_kernel()) {
+#if NADINE_I_SIMD_SSE2
+    case NADINE_KERNEL_SSE2:
+    case NADINE_KERNEL_SSSE3:
+        return nadine_i_simd_find_sse2(p, n, size, key);
+    case NADINE_KERNEL_AVX2:
+    case NADINE_KERNEL_AVX512:
+        return nadine_i_simd_find_avx2(p, n, size, key);
+#endif
+#if NADINE_I_SIMD_NEON
+    case NADINE_KERNEL_NEON:
+        return nadine_i_simd_find_neon(p, n, size, key);
+#endif
+    }
+#elif NADINE_I_SIMD_AVX2 && NADINE_I_KERNEL >= NADINE_KERNEL_AVX2            \
+        && NADINE_I_KERNEL <= NADINE_KERNEL_AVX512
+    return nadine_i_simd_find_avx2(p, n, size, key);
+#elif NADINE_I_SIMD_SSE2 && (NADINE_I_KERNEL == NADINE_KERNEL_SSE2           \
+                             || NADINE_I_KERNEL == NADINE_KERNEL_SSSE3)
+    return nadine_i_simd_find_sse2(p, n, size, key);
+#elif NADINE_I_SIMD_NEON && NADINE_I_KERNEL == NADINE_KERNEL_NEON
+    return nadine_i_simd_find_neon(p, n, size, key);
+#endif
+#endif /* NADINE_I_SIMD && CHAR_BIT == 8 */
+    (void)p, (void)n, (void)size, (void)key;
+    return 0;
+}
+
+/* define search functions for integer type T */
+/* set lo to the index of the first of the count values of T at b (count >
+   0) that is not less than key, with R reading a value. the values before
+   lo are less than key, and the rest from lo + n on are not. the halving
+   has no branch to mispredict */
+#define NADINE_I_BSEARCH(R, T, b, count, key, lo)                              \
+    {                                                                          \
+        size_t n = count;                                                      \
+        while (n > 1) {                                                        \
+            size_t half = n / 2;                                               \
+            lo = R(b + (lo + half) * sizeof(T)) < key ? lo + half : lo;        \
+            n -= half;                                                         \
+        }                                                                      \
+        lo += R(b + lo * sizeof(T)) < key;                                     \
+    }
+
+#define NADINE_I_IMPL_SEARCH(T, N)                                             \
+    NADINE_I_FN size_t nadine_bsearch_##N(unsigned endian, const void *base,   \
+                                          size_t count, T key) {               \
+        /* cast for C++ compatibility */                                       \
+        const unsigned char *b = (const unsigned char *)base;                  \
+        size_t lo = 0;                                                         \
+        if (!count) return 0;                                                  \
+        /* the values are compared as numbers, so every probe is read. one     \
+           loop per endianness makes that a plain load (and swap) */           \
+        switch (endian & 3) {                                                  \
+        case NADINE_ENDIAN_LITTLE:                                             \
+            NADINE_I_BSEARCH(nadine_read_le_##N, T, b, count, key, lo);        \
+            break;                                                             \
+        case NADINE_ENDIAN_BIG:                                                \
+            NADINE_I_BSEARCH(nadine_read_be_##N, T, b, count, key, lo);        \
+            break;                                                             \
+        case NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS:                   \
+            NADINE_I_BSEARCH(nadine_read_h316_##N, T, b, count, key, lo);      \
+            break;                                                             \
+        default:                                                               \
+            NADINE_I_BSEARCH(nadine_read_pdp_##N, T, b, count, key, lo);       \
+            break;                                                             \
+        }                                                                      \
+        return lo;                                                             \
+    }                                                                          \
+    NADINE_I_FN size_t nadine_find_##N(unsigned endian, const void *base,      \
+                                       size_t count, T key) {                  \
+        /* cast for C++ compatibility */                                       \
+        const unsigned char *b = (const unsigned char *)base;                  \
+        unsigned char k[sizeof(T)];                                            \
+        size_t i;                                                              \
+        /* compare the chars as stored with those of the key */                \
+        nadine_write_##N(endian, k, key);                                      \
+        i = nadine_i_simd_find(b, count, sizeof(T), k);                        \
+        for (; i < count; ++i)                                                 \
+            if (nadine_read_##N(endian, b + i * sizeof(T)) == key) break;      \
+        return i;                                                              \
+    }                                                                          \
+    NADINE_I_FN int nadine_minmax_##N(unsigned endian, const void *base,       \
+                                      size_t count, T *min, T *max) {          \
+        /* cast for C++ compatibility */                                       \
+        const unsigned char *b = (const unsigned char *)base;                  \
+        T buf[NADINE_I_MINMAX_CHUNK], lo, hi;                                  \
+        if (!count) return 0;                                                  \
+        lo = hi = nadine_read_##N(endian, b);                                  \
+        while (count) {                                                        \
+            size_t n = count, i;                                               \
+            if (n > NADINE_I_MINMAX_CHUNK) n = NADINE_I_MINMAX_CHUNK;          \
+            nadine_read_array_##N(endian, buf, b, n);                          \
+            for (i = 0; i < n; ++i) {                                          \
+                lo = buf[i] < lo ? buf[i] : lo;                                \
+                hi = buf[i] > hi ? buf[i] : hi;                                \
+            }                                                                  \
+            b += n * sizeof(T), count -= n;                                    \
+        }                                                                      \
+        if (min) *min = lo;                                                    \
+        if (max) *max = hi;                                                    \
+        return 1;                                                              \
+    }
+
+#else /* NADINE_STATIC || NADINE_IMPL */
+
+#define NADINE_I_IMPL_SEARCH(T, N)                                             \
+    extern size_t nadine_bsearch_##N(unsigned endian, const void *base,        \
+                                     size_t count, T key);                     \
+    extern size_t nadine_find_##N(unsigned endian, const void *base,           \
+                                  size_t count, T key);                        \
+    extern int nadine_minmax_##N(unsigned endian, const void *base,            \
+                                 size_t count, T *min, T *max);
+
+#endif /* NADINE_STATIC || NADINE_IMPL */
+
+NADINE_I_IMPL_SEARCH(short, short)
+NADINE_I_IMPL_SEARCH(unsigned short, unsigned_short)
+NADINE_I_IMPL_SEARCH(int, int)
+NADINE_I_IMPL_SEARCH(unsigned int, unsigned_int)
+NADINE_I_IMPL_SEARCH(long, long)
+NADINE_I_IMPL_SEARCH(unsigned long, unsigned_long)
+#if NADINE_I_HAS_ULL
+NADINE_I_IMPL_SEARCH(long long, long_long)
+NADINE_I_IMPL_SEARCH(unsigned long long, unsigned_long_long)
+#endif
+#if NADINE_STDINT
+#if defined(UINT16_MAX) && defined(INT16_MAX)
+NADINE_I_IMPL_SEARCH(int16_t, int16)
+NADINE_I_IMPL_SEARCH(uint16_t, uint16)
+#endif
+#if defined(UINT32_MAX) && defined(INT32_MAX)
+NADINE_I_IMPL_SEARCH(int32_t, int32)
+NADINE_I_IMPL_SEARCH(uint32_t, uint32)
+#endif
+#if defined(UINT64_MAX) && defined(INT64_MAX)
+NADINE_I_IMPL_SEARCH(int64_t, int64)
+NADINE_I_IMPL_SEARCH(uint64_t, uint64)
+#endif
+#endif /* NADINE_STDINT */
+
+/* sample conversions between stored int16 or int32 arrays and native
+   float or int32 ones. ops for the sample kernels, named source to
+   destination; the stored side is the int16 or int32 one */
+#define NADINE_I_SAMPLE_S16_F32 0 /* read int16 as float */
+#define NADINE_I_SAMPLE_S32_F32 1 /* read int32 as float */
+#define NADINE_I_SAMPLE_S16_S32 2 /* read int16 as int32 */
+#define NADINE_I_SAMPLE_F32_S16 3 /* write float as int16 */
+#define NADINE_I_SAMPLE_F32_S32 4 /* write float as int32 */
+#define NADINE_I_SAMPLE_S32_S16 5 /* write int32 as int16 */
+
+#if CHAR_BIT == 8 && NADINE_STDINT && defined(INT16_MAX) && defined(INT32_MAX)
+#if NADINE_STATIC || NADINE_IMPL
+
+/* SIMD sample kernels: convert s[n] to d[n] for op, swapping the stored
+   side for XORed endians xf (0 to 3) and multiplying by scale on the float
+   side. floats convert to integers rounding to nearest (ties to even),
+   saturating, and NaN to 0. return how many elements were converted, from
+   the start of the array */
+#if NADINE_I_SIMD_SSE2
+/* round the floats of v to int32, saturating, and NaN to 0 */
+NADINE_I_FNS NADINE_I_TARGET("sse2")
+__m128i nadine_i_simd_sample_s32_sse2(__m128 v) {
+    const __m128 hi = _mm_set1_ps(2147483648.0f);
+    __m128i r;
+    v = _mm_and_ps(v, _mm_cmpeq_ps(v, v));
+    /* cvtps gives 0x80000000 out of range, which is right below -2^31:
+       flip it to INT32_MAX from 2^31 up */
+    r = _mm_cvtps_epi32(v);
+    return _mm_xor_si128(r, _mm_castps_si128(_mm_cmpge_ps(v, hi)));
+}
+
+/* the same, clamping to int16 first */
+NADINE_I_FNS NADINE_I_TARGET("sse2")
+__m128i nadine_i_simd_sample_s16_sse2(__m128 v) {
+    const __m128 lo = _mm_set1_ps(-32768.0f), hi = _mm_set1_ps(32767.0f);
+    v = _mm_and_ps(v, _mm_cmpeq_ps(v, v));
+    return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(v, lo), hi));
+}
+
+NADINE_I_FN NADINE_I_TARGET("sse2")
+size_t nadine_i_simd_sample_sse2(unsigned op, void *d, const void *s,
+                                 size_t n, unsigned xf, float scale) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)d;
+    const unsigned char *b = (const unsigned char *)s;
+    const size_t x2 = NADINE_I_SIMD_XOR(2, xf), x4 = NADINE_I_SIMD_XOR(4, xf);
+    const __m128 k = _mm_set1_ps(scale);
+    size_t i = 0;
+    switch (op) {
+    case NADINE_I_SAMPLE_S16_F32:
+    case NADINE_I_SAMPLE_S16_S32:
+        for (; i + 8 <= n; i += 8) {
+            __m128i v = nadine_i_simd_xf_sse2(
+                    _mm_loadu_si128((const __m128i *)(b + i * 2)), x2);
+            /* sign-extend by putting the values in the high halves */
+            __m128i p = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            __m128i q = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+            if (op == NADINE_I_SAMPLE_S16_S32) {
+                _mm_storeu_si128((__m128i *)(a + i * 4), p);
+                _mm_storeu_si128((__m128i *)(a + i * 4 + 16), q);
+                continue;
+            }
+            _mm_storeu_ps((float *)(a + i * 4),
+                          _mm_mul_ps(_mm_cvtepi32_ps(p), k));
+            _mm_storeu_ps((float *)(a + i * 4 + 16),
+                          _mm_mul_ps(_mm_cvtepi32_ps(q), k));
+        }
+        break;
+    case NADINE_I_SAMPLE_S32_F32:
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = nadine_i_simd_xf_sse2(
+                    _mm_loadu_si128((const __m128i *)(b + i * 4)), x4);
+            _mm_storeu_ps((float *)(a + i * 4),
+                          _mm_mul_ps(_mm_cvtepi32_ps(v), k));
+        }
+        break;
+    case NADINE_I_SAMPLE_F32_S16:
+        for (; i + 8 <= n; i += 8) {
+            __m128i p = nadine_i_simd_sample_s16_sse2(_mm_mul_ps(
+                    _mm_loadu_ps((const float *)(b + i * 4)), k));
+            __m128i q = nadine_i_simd_sample_s16_sse2(_mm_mul_ps(
+                    _mm_loadu_ps((const float *)(b + i * 4 + 16)), k));
+            _mm_storeu_si128((__m128i *)(a + i * 2), nadine_i_simd_xf_sse2(
+                    _mm_packs_epi32(p, q), x2));
+        }
+        break;
+    case NADINE_I_SAMPLE_F32_S32:
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = nadine_i_simd_sample_s32_sse2(_mm_mul_ps(
+                    _mm_loadu_ps((const float *)(b + i * 4)), k));
+            _mm_storeu_si128((__m128i *)(a + i * 4),
+                             nadine_i_simd_xf_sse2(v, x4));
+        }
+        break;
+    case NADINE_I_SAMPLE_S32_S16:
+        for (; i + 8 <= n; i += 8) {
+            __m128i v = _mm_packs_epi32(
+                    _mm_loadu_si128((const __m128i *)(b + i * 4)),
+                    _mm_loadu_si128((const __m128i *)(b + i * 4 + 16)));
+            _mm_storeu_si128((__m128i *)(a + i * 2),
+                             nadine_i_simd_xf_sse2(v, x2));
+        }
+        break;
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_SSE2 */
+
+#if NADINE_I_SIMD_AVX2
+/* round the floats of v to int32 like nadine_i_simd_sample_s32_sse2 */
+NADINE_I_FNS NADINE_I_TARGET("avx2")
+__m256i nadine_i_simd_sample_s32_avx2(__m256 v) {
+    const __m256 hi = _mm256_set1_ps(2147483648.0f);
+    __m256i r;
+    v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_EQ_OQ));
+    r = _mm256_cvtps_epi32(v);
+    return _mm256_xor_si256(r, _mm256_castps_si256(
+            _mm256_cmp_ps(v, hi, _CMP_GE_OQ)));
+}
+
+/* the same, clamping to int16 first */
+NADINE_I_FNS NADINE_I_TARGET("avx2")
+__m256i nadine_i_simd_sample_s16_avx2(__m256 v) {
+    const __m256 lo = _mm256_set1_ps(-32768.0f);
+    const __m256 hi = _mm256_set1_ps(32767.0f);
+    v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_EQ_OQ));
+    return _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(v, lo), hi));
+}
+
+NADINE_I_FN NADINE_I_TARGET("avx2")
+size_t nadine_i_simd_sample_avx2(unsigned op, void *d, const void *s,
+                                 size_t n, unsigned xf, float scale) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)d;
+    const unsigned char *b = (const unsigned char *)s;
+    const __m256 k = _mm256_set1_ps(scale);
+    __m128i m2, m4;
+    __m256i w2, w4;
+    size_t i = 0;
+    nadine_i_simd_rev_mask(&m2, 2, xf);
+    nadine_i_simd_rev_mask(&m4, 4, xf);
+    w2 = _mm256_broadcastsi128_si256(m2);
+    w4 = _mm256_broadcastsi128_si256(m4);
+    switch (op) {
+    case NADINE_I_SAMPLE_S16_F32:
+    case NADINE_I_SAMPLE_S16_S32:
+        for (; i + 8 <= n; i += 8) {
+            __m256i v = _mm256_cvtepi16_epi32(_mm_shuffle_epi8(
+                    _mm_loadu_si128((const __m128i *)(b + i * 2)), m2));
+            if (op == NADINE_I_SAMPLE_S16_S32)
+                _mm256_storeu_si256((__m256i *)(a + i * 4), v);
+            else
+                _mm256_storeu_ps((float *)(a + i * 4),
+                                 _mm256_mul_ps(_mm256_cvtepi32_ps(v), k));
+        }
+        break;
+    case NADINE_I_SAMPLE_S32_F32:
+        for (; i + 8 <= n; i += 8) {
+            __m256i v = _mm256_shuffle_epi8(
+                    _mm256_loadu_si256((const __m256i *)(b + i * 4)), w4);
+            _mm256_storeu_ps((float *)(a + i * 4),
+                             _mm256_mul_ps(_mm256_cvtepi32_ps(v), k));
+        }
+        break;
+    case NADINE_I_SAMPLE_F32_S16:
+        for (; i + 16 <= n; i += 16) {
+            __m256i p = nadine_i_simd_sample_s16_avx2(_mm256_mul_ps(
+                    _mm256_loadu_ps((const float *)(b + i * 4)), k));
+            __m256i q = nadine_i_simd_sample_s16_avx2(_mm256_mul_ps(
+                    _mm256_loadu_ps((const float *)(b + i * 4 + 32)), k));
+            /* packs works within lanes: put the quarters back in order */
+            __m256i v = _mm256_permute4x64_epi64(_mm256_packs_epi32(p, q),
+                                                 _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i *)(a + i * 2),
+                                _mm256_shuffle_epi8(v, w2));
+        }
+        break;
+    case NADINE_I_SAMPLE_F32_S32:
+        for (; i + 8 <= n; i += 8) {
+            __m256i v = nadine_i_simd_sample_s32_avx2(_mm256_mul_ps(
+                    _mm256_loadu_ps((const float *)(b + i * 4)), k));
+            _mm256_storeu_si256((__m256i *)(a + i * 4),
+                                _mm256_shuffle_epi8(v, w4));
+        }
+        break;
+    case NADINE_I_SAMPLE_S32_S16:
+        for (; i + 16 <= n; i += 16) {
+            __m256i v = _mm256_permute4x64_epi64(_mm256_packs_epi32(
+                    _mm256_loadu_si256((const __m256i *)(b + i * 4)),
+                    _mm256_loadu_si256((const __m256i *)(b + i * 4 + 32))),
+                    _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i *)(a + i * 2),
+                                _mm256_shuffle_epi8(v, w2));
+        }
+        break;
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_AVX2 */
+
+#if NADINE_I_SIMD_NEON
+/* transform every element of v for XORed endians as in NADINE_I_SIMD_XOR,
+   for elements of 2 or 4 chars */
+NADINE_I_FNS uint8x16_t nadine_i_simd_xf_neon(uint8x16_t v, size_t x) {
+    if (x >> 1 == 1)
+        v = vreinterpretq_u8_u16(vrev32q_u16(vreinterpretq_u16_u8(v)));
+    if (x & 1)
+        v = vrev16q_u8(v);
+    return v;
+}
+
+NADINE_I_FN
+size_t nadine_i_simd_sample_neon(unsigned op, void *d, const void *s,
+                                 size_t n, unsigned xf, float scale) {
+    /* cast for C++ compatibility */
+    unsigned char *a = (unsigned char *)d;
+    const unsigned char *b = (const unsigned char *)s;
+    const size_t x2 = NADINE_I_SIMD_XOR(2, xf), x4 = NADINE_I_SIMD_XOR(4, xf);
+    size_t i = 0;
+    switch (op) {
+    case NADINE_I_SAMPLE_S16_F32:
+    case NADINE_I_SAMPLE_S16_S32:
+        for (; i + 8 <= n; i += 8) {
+            int16x8_t v = vreinterpretq_s16_u8(
+                    nadine_i_simd_xf_neon(vld1q_u8(b + i * 2), x2));
+            int32x4_t p = vmovl_s16(vget_low_s16(v));
+            int32x4_t q = vmovl_s16(vget_high_s16(v));
+            if (op == NADINE_I_SAMPLE_S16_S32) {
+                vst1q_s32((int32_t *)(a + i * 4), p);
+                vst1q_s32((int32_t *)(a + i * 4 + 16), q);
+                continue;
+            }
+            vst1q_f32((float *)(a + i * 4),
+                      vmulq_n_f32(vcvtq_f32_s32(p), scale));
+            vst1q_f32((float *)(a + i * 4 + 16),
+                      vmulq_n_f32(vcvtq_f32_s32(q), scale));
+        }
+        break;
+    case NADINE_I_SAMPLE_S32_F32:
+        for (; i + 4 <= n; i += 4) {
+            int32x4_t v = vreinterpretq_s32_u8(
+                    nadine_i_simd_xf_neon(vld1q_u8(b + i * 4), x4));
+            vst1q_f32((float *)(a + i * 4),
+                      vmulq_n_f32(vcvtq_f32_s32(v), scale));
+        }
+        break;
+#if NADINE_I_ARCH_ARM64
+    /* only AArch64 rounds to nearest; vcvtnq saturates and makes NaN 0 */
+    case NADINE_I_SAMPLE_F32_S16:
+        for (; i + 8 <= n; i += 8) {
+            int32x4_t p = vcvtnq_s32_f32(vmulq_n_f32(
+                    vld1q_f32((const float *)(b + i * 4)), scale));
+            int32x4_t q = vcvtnq_s32_f32(vmulq_n_f32(
+                    vld1q_f32((const float *)(b + i * 4 + 16)), scale));
+            uint8x16_t v = vreinterpretq_u8_s16(
+                    vcombine_s16(vqmovn_s32(p), vqmovn_s32(q)));
+            vst1q_u8(a + i * 2, nadine_i_simd_xf_neon(v, x2));
+        }
+        break;
+    case NADINE_I_SAMPLE_F32_S32:
+        for (; i + 4 <= n; i += 4) {
+            uint8x16_t v = vreinterpretq_u8_s32(vcvtnq_s32_f32(vmulq_n_f32(
+                    vld1q_f32((const float *)(b + i * 4)), scale)));
+            vst1q_u8(a + i * 4, nadine_i_simd_xf_neon(v, x4));
+        }
+        break;
+#endif /* NADINE_I_ARCH_ARM64 */
+    case NADINE_I_SAMPLE_S32_S16:
+        for (; i + 8 <= n; i += 8) {
+            uint8x16_t v = vreinterpretq_u8_s16(vcombine_s16(
+                    vqmovn_s32(vld1q_s32((const int32_t *)(b + i * 4))),
+                    vqmovn_s32(vld1q_s32((const int32_t *)(b + i * 4 + 16)))));
+            vst1q_u8(a + i * 2, nadine_i_simd_xf_neon(v, x2));
+        }
+        break;
+    }
+    return i;
+}
+#endif /* NADINE_I_SIMD_NEON */
+
+/* convert with the sample kernel for the kernel in use */
+NADINE_I_FNS size_t nadine_i_simd_sample(unsigned op, void *d, const void *s,
+                                         size_t n, unsigned xf, float scale) {
+#if NADINE_I_SIMD
+    if (xf > 3) return 0;
+#endif
+#if NADINE_DISPATCH
+    switch (nadine_simd_kernel()) {
+#if NADINE_I_SIMD_SSE2
+    case NADINE_KERNEL_SSE2:
+    case NADINE_KERNEL_SSSE3:
+        return nadine_i_simd_sample_sse2(op, d, s, n, xf, scale);
+    case NADINE_KERNEL_AVX2:
+    case NADINE_KERNEL_AVX512:
+        return nadine_i_simd_sample_avx2(op, d, s, n, xf, scale);
+#endif
+#if NADINE_I_SIMD_NEON
+    case NADINE_KERNEL_NEON:
+        return nadine_i_simd_sample_neon(op, d, s, n, xf, scale);
+#endif
+    }
+#elif NADINE_I_SIMD_AVX2 && NADINE_I_KERNEL >= NADINE_KERNEL_AVX2            \
+        && NADINE_I_KERNEL <= NADINE_KERNEL_AVX512
+    return nadine_i_simd_sample_avx2(op, d, s, n, xf, scale);
+#elif NADINE_I_SIMD_SSE2 && (NADINE_I_KERNEL == NADINE_KERNEL_SSE2           \
+                             || NADINE_I_KERNEL == NADINE_KERNEL_SSSE3)
+    return nadine_i_simd_sample_sse2(op, d, s, n, xf, scale);
+#elif NADINE_I_SIMD_NEON && NADINE_I_KERNEL == NADINE_KERNEL_NEON
+    return nadine_i_simd_sample_neon(op, d, s, n, xf, scale);
+#endif
+    (void)op, (void)d, (void)s, (void)n, (void)xf, (void)scale;
+    return 0;
+}
+
+/* round x to an integer, to nearest with ties to even like the SIMD
+   conversions in the default rounding mode: adding 2^23 leaves no bits
+   for a fraction. without excess precision for the sum, or it is kept */
+NADINE_I_FNS float nadine_i_sample_round(float x) {
+#if (defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0)                         \
+        || (defined(__FLT_EVAL_METHOD__) && __FLT_EVAL_METHOD__ == 0)          \
+        || defined(_M_X64) || defined(_M_ARM64)
+    float t;
+#else
+    volatile float t;
+#endif
+    if (!(x > -8388608.0f && x < 8388608.0f)) return x;
+    if (x < 0) {
+        t = x - 8388608.0f;
+        return t + 8388608.0f;
+    }
+    t = x + 8388608.0f;
+    return t - 8388608.0f;
+}
+
+/* float to int16 and int32, rounding like nadine_i_sample_round,
+   saturating, and NaN to 0 */
+NADINE_I_FNS int16_t nadine_i_sample_s16(float x) {
+    if (x != x) return 0;
+    if (x <= -32768.0f) return -32767 - 1;
+    if (x >= 32767.0f) return 32767;
+    return (int16_t)nadine_i_sample_round(x);
+}
+
+NADINE_I_FNS int32_t nadine_i_sample_s32(float x) {
+    if (x != x) return 0;
+    if (x <= -2147483648.0f) return -2147483647L - 1;
+    if (x >= 2147483648.0f) return 2147483647L;
+    return (int32_t)nadine_i_sample_round(x);
+}
+
+NADINE_I_FN void nadine_read_array_int16_to_int32(unsigned endian, int32_t *d,
+                                                  const void *s,
+                                                  size_t count) {
+    /* cast for C++ compatibility */
+    const unsigned char *src = (const unsigned char *)s;
+    size_t i = nadine_i_simd_sample(NADINE_I_SAMPLE_S16_S32, d, s, count,
+                                    NADINE_I_NATIVE_INT(uint16_t, uint16)
+                                        ^ endian, 1.0f);
+    for (; i < count; ++i)
+        d[i] = nadine_read_int16(endian, src + i * 2);
+}
+
+NADINE_I_FN void nadine_write_array_int32_to_int16(unsigned endian, void *d,
+                                                   const int32_t *s,
+                                                   size_t count) {
+    /* cast for C++ compatibility */
+    unsigned char *dst = (unsigned char *)d;
+    size_t i = nadine_i_simd_sample(NADINE_I_SAMPLE_S32_S16, d, s, count,
+                                    NADINE_I_NATIVE_INT(uint16_t, uint16)
+                                        ^ endian, 1.0f);
+    for (; i < count; ++i)
+        nadine_write_int16(endian, dst + i * 2,
+                           (int16_t)(s[i] < -32768 ? -32768
+                                     : s[i] > 32767 ? 32767 : s[i]));
+}
+
+#if NADINE_FLOAT
+NADINE_I_FN void nadine_read_array_int16_to_float(unsigned endian, float *d,
+                                                  const void *s, size_t count,
+                                                  float scale) {
+    /* cast for C++ compatibility */
+    const unsigned char *src = (const unsigned char *)s;
+    size_t i = nadine_i_simd_sample(NADINE_I_SAMPLE_S16_F32, d, s, count,
+                                    NADINE_I_NATIVE_INT(uint16_t, uint16)
+                                        ^ endian, scale);
+    for (; i < count; ++i)
+        d[i] = (float)nadine_read_int16(endian, src + i * 2) * scale;
+}
+
+NADINE_I_FN void nadine_read_array_int32_to_float(unsigned endian, float *d,
+                                                  const void *s, size_t count,
+                                                  float scale) {
+    /* cast for C++ compatibility */
+    const unsigned char *src = (const unsigned char *)s;
+    size_t i = nadine_i_simd_sample(NADINE_I_SAMPLE_S32_F32, d, s, count,
+                                    NADINE_I_NATIVE_INT(uint32_t, uint32)
+                                        ^ endian, scale);
+    for (; i < count; ++i)
+        d[i] = (float)nadine_read_int32(endian, src + i * 4) * scale;
+}
+
+NADINE_I_FN void nadine_write_array_float_to_int16(unsigned endian, void *d,
+                                                   const float *s,
+                                                   size_t count,
+                                                   float scale) {
+    /* cast for C++ compatibility */
+    unsigned char *dst = (unsigned char *)d;
+    size_t i = nadine_i_simd_sample(NADINE_I_SAMPLE_F32_S16, d, s, count,
+                                    NADINE_I_NATIVE_INT(uint16_t, uint16)
+                                        ^ endian, scale);
+    for (; i < count; ++i)
+        nadine_write_int16(endian, dst + i * 2,
+                           nadine_i_sample_s16(s[i] * scale));
+}
+
+NADINE_I_FN void nadine_write_array_float_to_int32(unsigned endian, void *d,
+                                                   const float *s,
+                                                   size_t count,
+                                                   float scale) {
+    /* cast for C++ compatibility */
+    unsigned char *dst = (unsigned char *)d;
+    size_t i = nadine_i_simd_sample(NADINE_I_SAMPLE_F32_S32, d, s, count,
+                                    NADINE_I_NATIVE_INT(uint32_t, uint32)
+                                        ^ endian, scale);
+    for (; i < count; ++i)
+        nadine_write_int32(endian, dst + i * 4,
+                           nadine_i_sample_s32(s[i] * scale));
+}
+#endif /* NADINE_FLOAT */
+
+#else /* NADINE_STATIC || NADINE_IMPL */
+
+extern void nadine_read_array_int16_to_int32(unsigned endian, int32_t *d,
+                                             const void *s, size_t count);
+extern void nadine_write_array_int32_to_int16(unsigned endian, void *d,
+                                              const int32_t *s, size_t count);
+#if NADINE_FLOAT
+extern void nadine_read_array_int16_to_float(unsigned endian, float *d,
+                                             const void *s, size_t count,
+                                             float scale);
+extern void nadine_read_array_int32_to_float(unsigned endian, float *d,
+                                             const void *s, size_t count,
+                                             float scale);
+extern void nadine_write_array_float_to_int16(unsigned endian, void *d,
+                                              const float *s, size_t count,
+                                              float scale);
+extern void nadine_write_array_float_to_int32(unsigned endian, void *d,
+                                              const float *s, size_t count,
+                                              float scale);
+#endif /* NADINE_FLOAT */
+
+#endif /* NADINE_STATIC || NADINE_IMPL */
+#endif /* CHAR_BIT == 8 && NADINE_STDINT && INT16_MAX && INT32_MAX */
+
+/* record field descriptor */
+typedef struct nadine_field {
+    size_t offset;          /* offset of the field in the record, in chars */
+    size_t width;           /* width of the field in chars */
+    unsigned kind;          /* one of NADINE_FIELD_* */
+} nadine_field;
+
+/* compiled record layout for nadine_convert_records */
+typedef struct nadine_plan {
+    size_t size;            /* record size, up to the end of the last field */
+    unsigned count;         /* number of fields */
+    unsigned kinds;         /* 1 << kind for every kind to be converted */
+    nadine_field fields[NADINE_PLAN_MAX_FIELDS];
+    /* if size <= 16: for every endian value, the source index of every char
+       of a converted record */
+    unsigned char shuffle[4][16];
+} nadine_plan;
+
+#if NADINE_STATIC || NADINE_IMPL
+
+/* XORed endians for a field of the given kind */
+NADINE_I_FNS unsigned nadine_i_field_xf(unsigned kind, unsigned endian) {
+    if (kind == NADINE_FIELD_RAW)
+        return 0;
+#if NADINE_FLOAT
+    if (kind == NADINE_FIELD_FLOAT)
+        return endian ^ nadine_endian_native_double();
+#endif
+    (void)kind;
+    return endian ^ nadine_endian_native_unsigned_long();
+}
+
+NADINE_I_FN int nadine_plan_compile(nadine_plan *plan,
+                                    const nadine_field *fields, size_t count) {
+    size_t i, j;
+    unsigned e;
+
+    if (count > NADINE_PLAN_MAX_FIELDS) return 0;
+    plan->size = 0;
+    plan->count = (unsigned)count;
+    plan->kinds = 0;
+    for (i = 0; i < count; ++i) {
+        const nadine_field *f = &fields[i];
+        if (f->kind > NADINE_FIELD_RAW) return 0;
+        plan->fields[i] = *f;
+        if (!f->width) continue;
+        /* fields may not overlap */
+        for (j = 0; j < i; ++j)
+            if (fields[j].width && f->offset < fields[j].offset + fields[j].width
+                                && fields[j].offset < f->offset + f->width)
+                return 0;
+        if (plan->size < f->offset + f->width)
+            plan->size = f->offset + f->width;
+        /* raw and single-char fields are never converted */
+        if (f->kind != NADINE_FIELD_RAW && f->width > 1)
+            plan->kinds |= 1U << f->kind;
+    }
+
+    /* transform identity masks the same way as the fields themselves */
+    if (plan->size <= 16) {
+        for (e = 0; e < 4; ++e) {
+            unsigned char *m = plan->shuffle[e];
+            for (j = 0; j < 16; ++j) m[j] = (unsigned char)j;
+            for (i = 0; i < plan->count; ++i)
+                if (plan->fields[i].width > 1)
+                    nadine_i_xform(m + plan->fields[i].offset,
+                                   plan->fields[i].width,
+                                   nadine_i_field_xf(plan->fields[i].kind, e));
+        }
+    }
+    return 1;
+}
+
+NADINE_I_FN void nadine_convert_records(const nadine_plan *plan,
+                                        unsigned endian, void *base,
+                                        size_t stride, size_t count) {
+    /* cast for C++ compatibility */
+    unsigned char *p = (unsigned char *)base;
+    unsigned xf[3];
+    size_t i = 0, j;
+
+    xf[NADINE_FIELD_INT] = nadine_i_field_xf(NADINE_FIELD_INT, endian);
+    xf[NADINE_FIELD_FLOAT] = nadine_i_field_xf(NADINE_FIELD_FLOAT, endian);
+    xf[NADINE_FIELD_RAW] = 0;
+    if (!count || !(((plan->kinds & (1U << NADINE_FIELD_INT))
+                                && xf[NADINE_FIELD_INT])
+                 || ((plan->kinds & (1U << NADINE_FIELD_FLOAT))
+                                && xf[NADINE_FIELD_FLOAT])))
+        return;
+
+    if (plan->size <= 16)
+        i = nadine_i_simd_shuf(p, (count - 1) * stride + plan->size, stride,
+                               count, plan->shuffle[endian & 3]);
+    for (; i < count; ++i) {
+        unsigned char *r = p + i * stride;
+        for (j = 0; j < plan->count; ++j) {
+            const nadine_field *f = &plan->fields[j];
+            /* empty fields have no last char for nadine_i_xform */
+            if (f->width > 1)
+                nadine_i_xform(r + f->offset, f->width, xf[f->kind]);
+        }
+    }
+}
+
+/* number of records to deinterleave or interleave at a time */
+#define NADINE_I_RECORD_BLOCK 256
+
+/* define column gather/scatter functions for type T: copy n values between
+   the records s/d (stride chars apart) and the column d/s, converting */
+#define NADINE_I_IMPL_GATHER(T, N)                                             \
+    NADINE_I_FNS void nadine_i_gather_##N(unsigned endian, unsigned char *d,   \
+                                          const unsigned char *s,              \
+                                          size_t stride, size_t n) {           \
+        T v;                                                                   \
+        for (; n; --n, s += stride, d += sizeof(T)) {                          \
+            nadine_i_memcpy(&v, s, sizeof(T));                                 \
+            v = nadine_convert_##N(endian, v);                                 \
+            nadine_i_memcpy(d, &v, sizeof(T));                                 \
+        }                                                                      \
+    }                                                                          \
+    NADINE_I_FNS void nadine_i_scatter_##N(unsigned endian, unsigned char *d,  \
+                                           const unsigned char *s,             \
+                                           size_t stride, size_t n) {          \
+        T v;                                                                   \
+        for (; n; --n, s += sizeof(T), d += stride) {                          \
+            nadine_i_memcpy(&v, s, sizeof(T));                                 \
+            v = nadine_convert_##N(endian, v);                                 \
+            nadine_i_memcpy(d, &v, sizeof(T));                                 \
+        }                                                                      \
+    }
+
+NADINE_I_IMPL_GATHER(unsigned short, unsigned_short)
+NADINE_I_IMPL_GATHER(unsigned int, unsigned_int)
+NADINE_I_IMPL_GATHER(unsigned long, unsigned_long)
+#if NADINE_I_HAS_ULL
+NADINE_I_IMPL_GATHER(unsigned long long, unsigned_long_long)
+#endif
+#if NADINE_FLOAT
+NADINE_I_IMPL_GATHER(float, float)
+NADINE_I_IMPL_GATHER(double, double)
+#endif
+
+/* pick a function for the field among nadine_i_gather_* (or scatter) */
+#if NADINE_I_HAS_ULL
+#define NADINE_I_PICK_INT_ULL(fn, w)                                           \
+    if ((w) == sizeof(unsigned long long)) return &fn##unsigned_long_long;
+#else
+#define NADINE_I_PICK_INT_ULL(fn, w)
+#endif
+#if NADINE_FLOAT
+#define NADINE_I_PICK_FLOAT(fn, k, w)                                          \
+    if ((k) == NADINE_FIELD_FLOAT) {                                           \
+        if ((w) == sizeof(float)) return &fn##float;                           \
+        if ((w) == sizeof(double)) return &fn##double;                         \
+    }
+#else
+#define NADINE_I_PICK_FLOAT(fn, k, w)
+#endif
+#define NADINE_I_PICK_FIELD_FN(fn, k, w)                                       \
+    if ((k) == NADINE_FIELD_INT) {                                             \
+        if ((w) == sizeof(unsigned short)) return &fn##unsigned_short;         \
+        if ((w) == sizeof(unsigned int)) return &fn##unsigned_int;             \
+        if ((w) == sizeof(unsigned long)) return &fn##unsigned_long;           \
+        NADINE_I_PICK_INT_ULL(fn, w)                                           \
+    }                                                                          \
+    NADINE_I_PICK_FLOAT(fn, k, w)                                              \
+    return NULL
+
+typedef void (*nadine_i_gather_fn)(unsigned endian, unsigned char *d,
+                                   const unsigned char *s,
+                                   size_t stride, size_t n);
+
+NADINE_I_FNS nadine_i_gather_fn nadine_i_gather_for(const nadine_field *f) {
+    NADINE_I_PICK_FIELD_FN(nadine_i_gather_, f->kind, f->width);
+}
+
+NADINE_I_FNS nadine_i_gather_fn nadine_i_scatter_for(const nadine_field *f) {
+    NADINE_I_PICK_FIELD_FN(nadine_i_scatter_, f->kind, f->width);
+}
+
+NADINE_I_FN void nadine_deinterleave(const nadine_plan *plan, unsigned endian,
+                                     void *const *columns, const void *source,
+                                     size_t stride, size_t count) {
+    /* cast for C++ compatibility */
+    const unsigned char *s = (const unsigned char *)source;
+    nadine_i_gather_fn fns[NADINE_PLAN_MAX_FIELDS];
+    size_t b, i, j, n;
+
+    for (j = 0; j < plan->count; ++j)
+        fns[j] = nadine_i_gather_for(&plan->fields[j]);
+
+    /* one block at a time, so that the records stay in the cache while
+       all of their fields are gathered */
+    for (b = 0; b < count; b += n) {
+        n = count - b < NADINE_I_RECORD_BLOCK ? count - b
+                                              : NADINE_I_RECORD_BLOCK;
+        for (j = 0; j < plan->count; ++j) {
+            const nadine_field *f = &plan->fields[j];
+            const unsigned char *r = s + b * stride + f->offset;
+            unsigned char *d;
+            unsigned xf;
+            if (!columns[j] || !f->width) continue;
+            d = (unsigned char *)columns[j] + b * f->width;
+            if (fns[j]) {
+                fns[j](endian, d, r, stride, n);
+                continue;
+            }
+            xf = f->width > 1 ? nadine_i_field_xf(f->kind, endian) : 0;
+            for (i = 0; i < n; ++i, r += stride, d += f->width) {
+                nadine_i_memcpy(d, r, f->width);
+                nadine_i_xform(d, f->width, xf);
+            }
+        }
+    }
+}
+
+NADINE_I_FN void nadine_interleave(const nadine_plan *plan, unsigned endian,
+                                   void *destination, size_t stride,
+                                   const void *const *columns, size_t count) {
+    /* cast for C++ compatibility */
+    unsigned char *d = (unsigned char *)destination;
+    nadine_i_gather_fn fns[NADINE_PLAN_MAX_FIELDS];
+    size_t b, i, j, n;
+
+    for (j = 0; j < plan->count; ++j)
+        fns[j] = nadine_i_scatter_for(&plan->fields[j]);
+
+    for (b = 0; b < count; b += n) {
+        n = count - b < NADINE_I_RECORD_BLOCK ? count - b
+                                              : NADINE_I_RECORD_BLOCK;
+        for (j = 0; j < plan->count; ++j) {
+            const nadine_field *f = &plan->fields[j];
+            unsigned char *r = d + b * stride + f->offset;
+            const unsigned char *s;
+            unsigned xf;
+            if (!columns[j] || !f->width) continue;
+            s = (const unsigned char *)columns[j] + b * f->width;
+            if (fns[j]) {
+                fns[j](endian, r, s, stride, n);
+                continue;
+            }
+            xf = f->width > 1 ? nadine_i_field_xf(f->kind, endian) : 0;
+            for (i = 0; i < n; ++i, r += stride, s += f->width) {
+                nadine_i_memcpy(r, s, f->width);
+                nadine_i_xform(r, f->width, xf);
+            }
+        }
+    }
+}
+
+#if NADINE_MMAP
+
+/* an open file for nadine_convert_mapped */
+typedef struct nadine_i_mfile {
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+    size_t size;
+} nadine_i_mfile;
+
+/* open the file at path for reading, or for reading and writing. if from
+   is not NULL, create the file if needed and make it from->size chars
+   long, failing if it is the file of from, which that would truncate.
+   returns 0 on error */
+NADINE_I_FNS int nadine_i_mfile_open(nadine_i_mfile *f, const char *path,
+                                     int write, const nadine_i_mfile *from) {
+#if defined(_WIN32)
+    LARGE_INTEGER n;
+    size_t size;
+    f->mapping = NULL;
+    /* from's file is open without FILE_SHARE_WRITE, so opening it again
+       for writing fails (before CREATE_ALWAYS truncates it) */
+    f->file = CreateFileA(path, write ? GENERIC_READ | GENERIC_WRITE
+                                      : GENERIC_READ,
+                          FILE_SHARE_READ, NULL,
+                          from ? CREATE_ALWAYS : OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                          NULL);
+    if (f->file == INVALID_HANDLE_VALUE) return 0;
+    if (from) {
+        size = from->size;
+    } else {
+        if (!GetFileSizeEx(f->file, &n) || (unsigned long long)n.QuadPart
+                                                    > (size_t)-1) {
+            CloseHandle(f->file);
+            return 0;
+        }
+        size = (size_t)n.QuadPart;
+    }
+    f->size = size;
+    /* empty files cannot be mapped, but there is nothing to map either */
+    if (!size) return 1;
+    /* for a new file, this also extends it to the given size */
+    f->mapping = CreateFileMappingA(f->file, NULL,
+                                    write ? PAGE_READWRITE : PAGE_READONLY,
+                                    (DWORD)(size >> 16 >> 16), (DWORD)size,
+                                    NULL);
+    if (!f->mapping) {
+        CloseHandle(f->file);
+        return 0;
+    }
+    return 1;
+#else
+    struct stat st, fst;
+    /* not O_TRUNC: the file may be from's, under another name */
+    f->fd = open(path, !write ? O_RDONLY
+                              : from ? O_RDWR | O_CREAT : O_RDWR,
+                 0666);
+    if (f->fd < 0) return 0;
+    if (fstat(f->fd, &st)) {
+        close(f->fd);
+        return 0;
+    }
+    if (from) {
+        if (fstat(from->fd, &fst)) {
+            close(f->fd);
+            return 0;
+        }
+        if (st.st_dev == fst.st_dev && st.st_ino == fst.st_ino) {
+            close(f->fd);
+            errno = EINVAL;
+            return 0;
+        }
+        if (ftruncate(f->fd, (off_t)from->size)) {
+            close(f->fd);
+            return 0;
+        }
+        f->size = from->size;
+        return 1;
+    }
+    /* compared as off_t, which may be wider than size_t */
+    if (st.st_size < 0 || (off_t)(size_t)st.st_size != st.st_size) {
+        close(f->fd);
+        errno = EFBIG;
+        return 0;
+    }
+    f->size = (size_t)st.st_size;
+    return 1;
+#endif
+}
+
+/* close a file opened with nadine_i_mfile_open. returns 0 on error */
+NADINE_I_FNS int nadine_i_mfile_close(nadine_i_mfile *f) {
+#if defined(_WIN32)
+    int ok = 1;
+    if (f->mapping) ok &= CloseHandle(f->mapping) != 0;
+    ok &= CloseHandle(f->file) != 0;
+    return ok;
+#else
+    return !close(f->fd);
+#endif
+}
+
+/* offsets of mapped windows must be multiples of this */
+NADINE_I_FNS size_t nadine_i_mfile_granularity(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+#else
+    long n = sysconf(_SC_PAGESIZE);
+    return n > 0 ? (size_t)n : 4096;
+#endif
+}
+
+/* map n chars of the file starting at offset. returns NULL on error */
+NADINE_I_FNS unsigned char *nadine_i_mfile_map(nadine_i_mfile *f,
+                                               size_t offset, size_t n,
+                                               int write) {
+#if defined(_WIN32)
+    return (unsigned char *)MapViewOfFile(f->mapping,
+                                          write ? FILE_MAP_WRITE
+                                                : FILE_MAP_READ,
+                                          (DWORD)(offset >> 16 >> 16),
+                                          (DWORD)offset, n);
+#else
+    void *p = mmap(NULL, n, write ? PROT_READ | PROT_WRITE : PROT_READ,
+                   MAP_SHARED, f->fd, (off_t)offset);
+    if (p == MAP_FAILED) return NULL;
+    /* only a hint; ignore errors */
+    (void)posix_madvise(p, n, POSIX_MADV_SEQUENTIAL);
+    return (unsigned char *)p;
+#endif
+}
+
+/* unmap a window mapped with nadine_i_mfile_map */
+NADINE_I_FNS void nadine_i_mfile_unmap(unsigned char *p, size_t n) {
+#if defined(_WIN32)
+    (void)n;
+    UnmapViewOfFile(p);
+#else
+    munmap(p, n);
+#endif
+}
+
+/* array copy/convert function for integers of width chars, if any */
+NADINE_I_FNS nadine_i_copy_fn nadine_i_copy_for(size_t width) {
+    if (width == sizeof(unsigned short))
+        return &nadine_i_copy_array_unsigned_short;
+    if (width == sizeof(unsigned int))
+        return &nadine_i_copy_array_unsigned_int;
+    if (width == sizeof(unsigned long))
+        return &nadine_i_copy_array_unsigned_long;
+    NADINE_I_PICK_INT_ULL(nadine_i_copy_array_, width)
+#if NADINE_INT128 && NADINE_I_HAS_INT128
+    if (width == sizeof(nadine_uint128))
+        return &nadine_i_copy_array_uint128;
+#endif
+    return NULL;
+}
+
+/* copy count values of width chars at offset in file s to the same offset
+   in file d (may be s), transforming them for XORed endians xf, one window
+   of the files at a time. no values are split across windows */
+NADINE_I_FNS int nadine_i_mapped_run(nadine_i_mfile *d, nadine_i_mfile *s,
+                                     size_t offset, size_t width,
+                                     size_t count, unsigned xf) {
+    const size_t gran = nadine_i_mfile_granularity();
+    const size_t chunk = NADINE_MAPPED_CHUNK > gran
+                       ? NADINE_MAPPED_CHUNK / gran * gran : gran;
+    nadine_i_copy_fn fn = xf ? nadine_i_copy_for(width) : NULL;
+    /* the copy functions use the native integer order */
+    const unsigned endian = xf ^ nadine_endian_native_unsigned_long();
+
+    while (count) {
+        const size_t base = offset / gran * gran, skip = offset - base;
+        size_t n = skip < chunk ? (chunk - skip) / width : 0, len, i;
+        unsigned char *src, *dst;
+
+        if (!n) n = 1;
+        if (n > count) n = count;
+        len = skip + n * width;
+
+        src = nadine_i_mfile_map(s, base, len, d == s);
+        if (!src) return 0;
+        dst = src;
+        if (d != s) {
+            dst = nadine_i_mfile_map(d, base, len, 1);
+            if (!dst) {
+                nadine_i_mfile_unmap(src, len);
+                return 0;
+            }
+        }
+
+        if (!xf) {
+            if (dst != src)
+                nadine_i_memcpy(dst + skip, src + skip, n * width);
+        } else if (fn) {
+            fn(endian, dst + skip, src + skip, n);
+        } else {
+            for (i = 0; i < n; ++i) {
+                unsigned char *p = dst + skip + i * width;
+                if (dst != src)
+                    nadine_i_memcpy(p, src + skip + i * width, width);
+                nadine_i_xform(p, width, xf);
+            }
+        }
+
+        if (dst != src) nadine_i_mfile_unmap(dst, len);
+        nadine_i_mfile_unmap(src, len);
+        offset += n * width;
+        count -= n;
+    }
+    return 1;
+}
+
+/* check the range for nadine_convert_mapped, resolving NADINE_MAPPED_ALL */
+NADINE_I_FNS int nadine_i_mapped_range(const nadine_i_mfile *f, size_t width,
+                                       unsigned kind, size_t offset,
+                                       size_t *count) {
+    size_t max;
+    if (!width || kind > NADINE_FIELD_RAW || offset > f->size)
+        return 0;
+    max = (f->size - offset) / width;
+    if (*count == NADINE_MAPPED_ALL) *count = max;
+    return *count <= max;
+}
+
+NADINE_I_FN int nadine_convert_mapped(const char *path, size_t width,
+                                      unsigned kind, unsigned endian,
+                                      size_t offset, size_t count) {
+    const unsigned xf = width > 1 ? nadine_i_field_xf(kind, endian) : 0;
+    nadine_i_mfile f;
+    int ok;
+    if (!nadine_i_mfile_open(&f, path, xf != 0, NULL)) return 0;
+    ok = nadine_i_mapped_range(&f, width, kind, offset, &count);
+    /* nothing to do in place if the order is already right */
+    if (ok && xf) ok = nadine_i_mapped_run(&f, &f, offset, width, count, xf);
+    ok &= nadine_i_mfile_close(&f);
+    return ok;
+}
+
+NADINE_I_FN int nadine_convert_mapped_copy(const char *destination,
+                                           const char *source, size_t width,
+                                           unsigned kind, unsigned endian,
+                                           size_t offset, size_t count) {
+    const unsigned xf = width > 1 ? nadine_i_field_xf(kind, endian) : 0;
+    nadine_i_mfile s, d;
+    size_t end;
+    int ok;
+    if (!nadine_i_mfile_open(&s, source, 0, NULL)) return 0;
+    ok = nadine_i_mapped_range(&s, width, kind, offset, &count);
+    if (ok) ok = nadine_i_mfile_open(&d, destination, 1, &s);
+    if (ok) {
+        end = offset + count * width;
+        /* the chars before and after the values are copied as they are */
+        ok = nadine_i_mapped_run(&d, &s, 0, 1, offset, 0)
+          && nadine_i_mapped_run(&d, &s, offset, width, count, xf)
+          && nadine_i_mapped_run(&d, &s, end, 1, s.size - end, 0);
+        ok &= nadine_i_mfile_close(&d);
+    }
+    ok &= nadine_i_mfile_close(&s);
+    return ok;
+}
+
+#endif /* NADINE_MMAP */
+
+#else /* NADINE_STATIC || NADINE_IMPL */
+
+extern int nadine_plan_compile(nadine_plan *plan,
+                               const nadine_field *fields, size_t count);
+extern void nadine_convert_records(const nadine_plan *plan, unsigned endian,
+                                   void *base, size_t stride, size_t count);
+extern void nadine_deinterleave(const nadine_plan *plan, unsigned endian,
+                                void *const *columns, const void *source,
+                                size_t stride, size_t count);
+extern void nadine_interleave(const nadine_plan *plan, unsigned endian,
+                              void *destination, size_t stride,
+                              const void *const *columns, size_t count);
+
+#if NADINE_MMAP
+extern int nadine_convert_mapped(const char *path, size_t width,
+                                 unsigned kind, unsigned endian,
+                                 size_t offset, size_t count);
+extern int nadine_convert_mapped_copy(const char *destination,
+                                      const char *source, size_t width,
+                                      unsigned kind, unsigned endian,
+                                      size_t offset, size_t count);
+#endif /* NADINE_MMAP */
+
+#endif /* NADINE_STATIC || NADINE_IMPL */
+
+#if NADINE_STREAM
+
+/* buffered reader or writer over a FILE or a file descriptor */
+typedef struct nadine_stream {
+    FILE *file;             /* the stdio stream, or NULL */
+    int fd;                 /* the file descriptor, if file is NULL */
+    unsigned char *buffer;  /* the caller's buffer */
+    size_t size;            /* size of the buffer in chars */
+    size_t pos;             /* first buffered char not read yet */
+    size_t end;             /* end of the buffered chars */
+    int ok;                 /* zero after a read or write error */
+} nadine_stream;
+
+#if NADINE_STATIC || NADINE_IMPL
+
+/* most chars to pass to a single read or write */
+#define NADINE_I_STREAM_IO_MAX 0x40000000UL
+
+NADINE_I_FN void nadine_stream_init_file(nadine_stream *s, FILE *file,
+                                         void *buffer, size_t size) {
+    s->file = file;
+    s->fd = -1;
+    /* cast for C++ compatibility */
+    s->buffer = (unsigned char *)buffer;
+    s->size = size;
+    s->pos = s->end = 0;
+    s->ok = 1;
+}
+
+#if NADINE_I_STREAM_FD
+NADINE_I_FN void nadine_stream_init_fd(nadine_stream *s, int fd,
+                                       void *buffer, size_t size) {
+    nadine_stream_init_file(s, NULL, buffer, size);
+    s->fd = fd;
+}
+#endif /* NADINE_I_STREAM_FD */
+
+NADINE_I_FN int nadine_stream_ok(const nadine_stream *s) {
+    return s->ok;
+}
+
+/* read up to n chars into p. returns how many, 0 at the end of the stream
+   or on an error */
+NADINE_I_FNS size_t nadine_i_stream_in(nadine_stream *s, void *p, size_t n) {
+    if (n > NADINE_I_STREAM_IO_MAX) n = NADINE_I_STREAM_IO_MAX;
+    if (s->file) {
+        const size_t k = fread(p, 1, n, s->file);
+        if (!k && ferror(s->file)) s->ok = 0;
+        return k;
+    }
+#if NADINE_I_STREAM_FD
+    for (;;) {
+#if defined(_WIN32)
+        const int r = _read(s->fd, p, (unsigned)n);
+#else
+        const ssize_t r = read(s->fd, p, n);
+#endif
+        if (r >= 0) return (size_t)r;
+        if (errno != EINTR) break;
+    }
+#endif /* NADINE_I_STREAM_FD */
+    s->ok = 0;
+    return 0;
+}
+
+/* write the n chars at p. returns 0 on an error */
+NADINE_I_FNS int nadine_i_stream_out(nadine_stream *s, const void *p,
+                                     size_t n) {
+    /* cast for C++ compatibility */
+    const unsigned char *c = (const unsigned char *)p;
+    if (s->file) {
+        if (fwrite(c, 1, n, s->file) == n) return 1;
+        s->ok = 0;
+        return 0;
+    }
+#if NADINE_I_STREAM_FD
+    while (n) {
+        const size_t k = n > NADINE_I_STREAM_IO_MAX ? NADINE_I_STREAM_IO_MAX
+                                                    : n;
+#if defined(_WIN32)
+        const int r = _write(s->fd, c, (unsigned)k);
+#else
+        const ssize_t r = write(s->fd, c, k);
+#endif
+        if (r <= 0) {
+            if (r < 0 && errno == EINTR) continue;
+            break;
+        }
+        c += r, n -= (size_t)r;
+    }
+    if (!n) return 1;
+#endif /* NADINE_I_STREAM_FD */
+    s->ok = 0;
+    return 0;
+}
+
+/* buffer at least n chars, moving the unread ones to the start of the
+   buffer first. returns 0 if the stream ends (or fails) before that. a
+   descriptor is read for as much as fits, since read returns what is
+   there, but fread waits for every char asked for, so a FILE is only read
+   up to want chars (or n if more), to not block on a pipe or socket for
+   chars the caller does not need yet */
+NADINE_I_FNS int nadine_i_stream_fill(nadine_stream *s, size_t n,
+                                      size_t want) {
+    size_t max = s->file && want < s->size ? want : s->size;
+    if (max < n && n <= s->size) max = n;
+    if (s->pos) {
+        memmove(s->buffer, s->buffer + s->pos, s->end - s->pos);
+        s->end -= s->pos;
+        s->pos = 0;
+    }
+    while (s->end < n) {
+        const size_t k = nadine_i_stream_in(s, s->buffer + s->end,
+                                            max - s->end);
+        if (!k) return 0;
+        s->end += k;
+    }
+    return 1;
+}
+
+NADINE_I_FN int nadine_stream_flush(nadine_stream *s) {
+    const size_t n = s->end - s->pos, pos = s->pos;
+    s->pos = s->end = 0;
+    return !n || nadine_i_stream_out(s, s->buffer + pos, n);
+}
+
+NADINE_I_FN size_t nadine_stream_read(nadine_stream *s, void *data,
+                                      size_t n) {
+    /* cast for C++ compatibility */
+    unsigned char *d = (unsigned char *)data;
+    size_t done = 0;
+    while (done < n) {
+        size_t k = s->end - s->pos;
+        if (!k) {
+            /* too much to buffer: read it straight into data */
+            if (n - done >= s->size) {
+                k = nadine_i_stream_in(s, d + done, n - done);
+                if (!k) break;
+                done += k;
+                continue;
+            }
+            if (!nadine_i_stream_fill(s, 1, n - done)) break;
+            continue;
+        }
+        if (k > n - done) k = n - done;
+        nadine_i_memcpy(d + done, s->buffer + s->pos, k);
+        s->pos += k, done += k;
+    }
+    return done;
+}
+
+NADINE_I_FN size_t nadine_stream_write(nadine_stream *s, const void *data,
+                                       size_t n) {
+    /* cast for C++ compatibility */
+    const unsigned char *c = (const unsigned char *)data;
+    size_t done = 0;
+    while (done < n) {
+        size_t k = s->size - s->end;
+        if (!k) {
+            /* an empty buffer (of size 0) would not do */
+            if (!s->end || !nadine_stream_flush(s)) break;
+            continue;
+        }
+        if (k > n - done) k = n - done;
+        nadine_i_memcpy(s->buffer + s->end, c + done, k);
+        s->end += k, done += k;
+    }
+    return done;
+}
+
+/* define stream array functions for T. the values are converted a buffer
+   at a time, straight from or into the caller's array */
+#define NADINE_I_IMPL_STREAM(T, N)                                             \
+    NADINE_I_FN size_t nadine_stream_read_array_##N(nadine_stream *s,          \
+                                                    unsigned endian, T *d,     \
+                                                    size_t count) {            \
+        size_t done = 0;                                                       \
+        while (done < count) {                                                 \
+            size_t n = (s->end - s->pos) / sizeof(T);                          \
+            if (!n) {                                                          \
+                /* the values left, without overflowing */                     \
+                const size_t want = count - done < s->size / sizeof(T)         \
+                                        ? (count - done) * sizeof(T)           \
+                                        : s->size;                             \
+                if (!nadine_i_stream_fill(s, sizeof(T), want)) break;          \
+                continue;                                                      \
+            }                                                                  \
+            if (n > count - done) n = count - done;                            \
+            nadine_read_array_##N(endian, d + done, s->buffer + s->pos, n);    \
+            s->pos += n * sizeof(T), done += n;                                \
+        }                                                                      \
+        return done;                                                           \
+    }                                                                          \
+    NADINE_I_FN size_t nadine_stream_write_array_##N(nadine_stream *s,         \
+                                                     unsigned endian,          \
+                                                     const T *src,             \
+                                                     size_t count) {           \
+        size_t done = 0;                                                       \
+        while (done < count) {                                                 \
+            size_t n = (s->size - s->end) / sizeof(T);                         \
+            if (!n) {                                                          \
+                /* an empty buffer too small for a value would not do */       \
+                if (!s->end || !nadine_stream_flush(s)) break;                 \
+                continue;                                                      \
+            }                                                                  \
+            if (n > count - done) n = count - done;                            \
+            nadine_write_array_##N(endian, s->buffer + s->end, src + done, n); \
+            s->end += n * sizeof(T), done += n;                                \
+        }                                                                      \
+        return done;                                                           \
+    }
+
+#else /* NADINE_STATIC || NADINE_IMPL */
+
+extern void nadine_stream_init_file(nadine_stream *s, FILE *file,
+                                    void *buffer, size_t size);
+#if NADINE_I_STREAM_FD
+extern void nadine_stream_init_fd(nadine_stream *s, int fd,
+                                  void *buffer, size_t size);
+#endif /* NADINE_I_STREAM_FD */
+extern int nadine_stream_ok(const nadine_stream *s);
+extern int nadine_stream_flush(nadine_stream *s);
+extern size_t nadine_stream_read(nadine_stream *s, void *data, size_t n);
+extern size_t nadine_stream_write(nadine_stream *s, const void *data,
+                                  size_t n);
+
+#define NADINE_I_IMPL_STREAM(T, N)                                             \
+    extern size_t nadine_stream_read_array_##N(nadine_stream *s,               \
+                                               unsigned endian,                \
+                                               T *destination, size_t count);  \
+    extern size_t nadine_stream_write_array_##N(nadine_stream *s,              \
+                                                unsigned endian,               \
+                                                const T *source,               \
+                                                size_t count);
+
+#endif /* NADINE_STATIC || NADINE_IMPL */
+
+NADINE_I_IMPL_STREAM(short, short)
+NADINE_I_IMPL_STREAM(unsigned short, unsigned_short)
+NADINE_I_IMPL_STREAM(int, int)
+NADINE_I_IMPL_STREAM(unsigned int, unsigned_int)
+NADINE_I_IMPL_STREAM(long, long)
+NADINE_I_IMPL_STREAM(unsigned long, unsigned_long)
+#if NADINE_I_HAS_ULL
+NADINE_I_IMPL_STREAM(long long, long_long)
+NADINE_I_IMPL_STREAM(unsigned long long, unsigned_long_long)
+#endif
+#if NADINE_STDINT
+#if defined(UINT16_MAX) && defined(INT16_MAX)
+NADINE_I_IMPL_STREAM(int16_t, int16)
+NADINE_I_IMPL_STREAM(uint16_t, uint16)
+#endif
+#if defined(UINT32_MAX) && defined(INT32_MAX)
+NADINE_I_IMPL_STREAM(int32_t, int32)
+NADINE_I_IMPL_STREAM(uint32_t, uint32)
+#endif
+#if defined(UINT64_MAX) && defined(INT64_MAX)
+NADINE_I_IMPL_STREAM(int64_t, int64)
+NADINE_I_IMPL_STREAM(uint64_t, uint64)
+#endif
+#endif /* NADINE_STDINT */
+#if NADINE_INT128
+NADINE_I_IMPL_STREAM(nadine_int128, int128)
+NADINE_I_IMPL_STREAM(nadine_uint128, uint128)
+#endif
+#if NADINE_FLOAT
+NADINE_I_IMPL_STREAM(float, float)
+NADINE_I_IMPL_STREAM(double, double)
+#endif
+
+#endif /* NADINE_STREAM */
 
 #ifdef __cplusplus
 }
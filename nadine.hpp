@@ -0,0 +1,351 @@
+/*******************************************************************************
+*                                                                              *
+*   NADINE -- PORTABLE, SINGLE-HEADER, ENDIAN CONVERSION LIBRARY FOR C         *
+*   C++ COMPANION HEADER                                                       *
+*   DEVELOPED BY SAMPO HIPPELAINEN (HISAHI)                                    *
+*                                                                              *
+*   THIS LIBRARY IS DUAL-LICENSED UNDER THE UNLICENSE PUBLIC-DOMAIN            *
+*   EQUIVALENT LICENSE AND THE MIT LICENSE.                                    *
+*                                                                              *
+*******************************************************************************/
+
+/* To use this header, include it instead of (or after) nadine.h. It requires
+   C++11 or above. The same rules for NADINE_STATIC and NADINE_IMPL apply as
+   for nadine.h; the C functions are only used if the native endianness is
+   not known at compile time. */
+
+/* Documentation:
+
+  For all of the following templates, Endian is one of the following:
+      nadine::little            for NADINE_ENDIAN_LITTLE
+      nadine::big               for NADINE_ENDIAN_BIG
+      nadine::pdp               for NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS
+      nadine::h316              for NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS
+  or any other valid `endian' value for nadine.h.
+
+  T may be any integral or floating-point type (for floating-point types,
+  only if NADINE_FLOAT is enabled).
+
+  template <unsigned Endian, class T> constexpr T nadine::convert(T value)
+      Converts the given value to or from the given endianness, like
+      nadine_convert_N. This is constexpr if the native endianness is known
+      at compile time and is either little-endian or big-endian (and for
+      floating-point types, if std::bit_cast is available, i.e. C++20).
+  template <unsigned Endian, class T> T nadine::read(const void *source)
+      Reads a value of type T at the given pointer with the specified
+      endianness and returns it, like nadine_read_N.
+  template <unsigned Endian, class T> void nadine::write(void *destination,
+                                                         T value)
+      Writes a value of type T at the given pointer with the specified
+      endianness, like nadine_write_N.
+
+  template <unsigned Endian, class T> class nadine::stored
+      Holds a T in the given endianness, as sizeof(T) chars with an
+      alignment of 1 and no padding. It is trivially copyable and standard
+      layout, so that packed wire structs can be declared with it and a
+      buffer accessed in place through a pointer to one. Converts to T and
+      is assigned from T with nadine::read and nadine::write, and provides
+      get(), set(T), data() and the compound assignment, increment and
+      decrement operators of T. Aliases are provided for the usual
+      endiannesses: nadine::be<T>, nadine::le<T>, nadine::pdpe<T> and
+      nadine::h316e<T> (nadine::pdp and nadine::h316 name the values).
+
+  Since the endianness is a template parameter, every conversion is
+  specialized for it at compile time and contains no branches on it.
+
+  Example: std::uint32_t v = nadine::read<nadine::big, std::uint32_t>(p);
+  Example: struct header { nadine::be<std::uint16_t> type, length; };
+           unsigned length = reinterpret_cast<const header *>(p)->length;
+
+*******************************************************************************/
+
+#ifndef NADINE_HPP
+#define NADINE_HPP
+
+#if defined(_MSVC_LANG)
+#define NADINE_I_CPLUSPLUS _MSVC_LANG
+#else
+#define NADINE_I_CPLUSPLUS __cplusplus
+#endif
+
+#if NADINE_I_CPLUSPLUS < 201103L
+#error nadine.hpp requires C++11 or above
+#endif
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#if NADINE_I_CPLUSPLUS >= 202002L
+#include <bit>
+#endif
+
+#include "nadine.h"
+
+/* is std::byteswap available? (C++23) */
+#if defined(__cpp_lib_byteswap) && __cpp_lib_byteswap >= 202110L
+#define NADINE_I_HPP_BYTESWAP 1
+#else
+#define NADINE_I_HPP_BYTESWAP 0
+#endif
+
+/* is std::bit_cast available? (C++20) */
+#if defined(__cpp_lib_bit_cast) && __cpp_lib_bit_cast >= 201806L
+#define NADINE_I_HPP_BIT_CAST 1
+#else
+#define NADINE_I_HPP_BIT_CAST 0
+#endif
+
+/* are the byte swap builtins available and constexpr? */
+#if CHAR_BIT == 8 && (__clang_major__ >= 4 ||                                  \
+        (!defined(__clang__) && (__GNUC__ > 4 ||                               \
+            (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))))
+#define NADINE_I_HPP_BUILTIN_BSWAP 1
+#else
+#define NADINE_I_HPP_BUILTIN_BSWAP 0
+#endif
+
+/* native endianness at compile time. only little- and big-endian can be
+   done on values; everything else goes through the C functions */
+#if defined(NADINE_NATIVE_ENDIAN_INT) && CHAR_BIT == 8
+#if (NADINE_NATIVE_ENDIAN_INT) == NADINE_ENDIAN_LITTLE                         \
+        || (NADINE_NATIVE_ENDIAN_INT) == NADINE_ENDIAN_BIG
+#define NADINE_I_HPP_NATIVE_INT (NADINE_NATIVE_ENDIAN_INT)
+#endif
+#elif NADINE_I_CPLUSPLUS >= 202002L && CHAR_BIT == 8
+#define NADINE_I_HPP_NATIVE_INT                                                \
+    (std::endian::native == std::endian::little ? NADINE_ENDIAN_LITTLE :       \
+     std::endian::native == std::endian::big    ? NADINE_ENDIAN_BIG    :       \
+     NADINE_ENDIAN_UNKNOWN)
+#define NADINE_I_HPP_NATIVE_INT_CHECK 1
+#endif
+
+/* float values are converted as integers, so we need to know both */
+#if NADINE_FLOAT && defined(NADINE_NATIVE_ENDIAN_FLOAT)                        \
+        && defined(NADINE_I_HPP_NATIVE_INT)
+#define NADINE_I_HPP_NATIVE_FLOAT (NADINE_NATIVE_ENDIAN_FLOAT)
+#endif
+
+namespace nadine {
+
+/* endianness values */
+const unsigned little = NADINE_ENDIAN_LITTLE;
+const unsigned big = NADINE_ENDIAN_BIG;
+const unsigned pdp = NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS;
+const unsigned h316 = NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS;
+
+namespace detail {
+
+#ifdef NADINE_I_HPP_NATIVE_INT_CHECK
+static_assert(NADINE_I_HPP_NATIVE_INT != NADINE_ENDIAN_UNKNOWN,
+              "nadine.hpp: std::endian::native is mixed-endian");
+#endif
+
+/* reverse the lowest n chars of x */
+template <class U>
+constexpr U rev_generic(U x, unsigned n) noexcept {
+    return n == 0 ? U(0)
+         : U(U(U(x & 0xFFU) << (CHAR_BIT * (n - 1)))
+                | rev_generic(U(x >> CHAR_BIT), n - 1));
+}
+
+/* reverse the chars of unsigned integer x */
+template <class U>
+constexpr U rev(U x) noexcept {
+#if NADINE_I_HPP_BYTESWAP
+    return std::byteswap(x);
+#elif NADINE_I_HPP_BUILTIN_BSWAP
+    return sizeof(U) == 1 ? x
+         : sizeof(U) == 2 ? U(__builtin_bswap16((unsigned short)x))
+         : sizeof(U) == 4 ? U(__builtin_bswap32((std::uint32_t)x))
+         : sizeof(U) == 8 ? U(__builtin_bswap64((std::uint64_t)x))
+         : rev_generic(x, sizeof(U));
+#else
+    return rev_generic(x, sizeof(U));
+#endif
+}
+
+/* 0x00FF00FF... for unsigned integer type U */
+template <class U>
+constexpr U pair_mask() noexcept {
+    return U(U(U(~U(0)) / U(0xFFFFU)) * U(0xFFU));
+}
+
+/* swap char pairs of unsigned integer x */
+template <class U>
+constexpr U swap_pairs(U x) noexcept {
+    return sizeof(U) == 1 ? x
+         : U(U(U(x & pair_mask<U>()) << CHAR_BIT)
+                | U(U(x >> CHAR_BIT) & pair_mask<U>()));
+}
+
+/* applies needed transformations for XORed endians xf, like nadine_i_xform,
+   but on a value. only valid if the native endianness is little or big */
+template <class U>
+constexpr U xform(unsigned xf, U x) noexcept {
+    return (xf & 2) ? swap_pairs<U>((xf & 1) ? rev<U>(x) : x)
+                    : ((xf & 1) ? rev<U>(x) : x);
+}
+
+#if !defined(NADINE_I_HPP_NATIVE_INT) || !defined(NADINE_I_HPP_NATIVE_FLOAT)
+/* run-time conversion through the C functions */
+inline unsigned char c_convert(unsigned, unsigned char v) noexcept {
+    return v;
+}
+inline unsigned short c_convert(unsigned e, unsigned short v) noexcept {
+    return nadine_convert_unsigned_short(e, v);
+}
+inline unsigned int c_convert(unsigned e, unsigned int v) noexcept {
+    return nadine_convert_unsigned_int(e, v);
+}
+inline unsigned long c_convert(unsigned e, unsigned long v) noexcept {
+    return nadine_convert_unsigned_long(e, v);
+}
+inline unsigned long long c_convert(unsigned e, unsigned long long v) noexcept {
+    return nadine_convert_unsigned_long_long(e, v);
+}
+#if NADINE_FLOAT
+inline float c_convert(unsigned e, float v) noexcept {
+    return nadine_convert_float(e, v);
+}
+inline double c_convert(unsigned e, double v) noexcept {
+    return nadine_convert_double(e, v);
+}
+#endif
+#endif
+
+/* unsigned integer type with the same size as floating-point type T */
+template <class T>
+struct float_bits {
+    typedef typename std::conditional<sizeof(T) == 4, std::uint32_t,
+                                      std::uint64_t>::type type;
+    static_assert(sizeof(type) == sizeof(T),
+                  "nadine.hpp: unsupported floating-point type");
+};
+
+template <unsigned Endian, class T,
+          bool Float = std::is_floating_point<T>::value>
+struct converter;
+
+/* integral types */
+template <unsigned Endian, class T>
+struct converter<Endian, T, false> {
+    static_assert(std::is_integral<T>::value,
+                  "nadine.hpp: T must be an integral or floating-point type");
+    typedef typename std::make_unsigned<T>::type U;
+#ifdef NADINE_I_HPP_NATIVE_INT
+    static constexpr T apply(T value) noexcept {
+        return T(xform<U>(Endian ^ NADINE_I_HPP_NATIVE_INT, U(value)));
+    }
+#else
+    static T apply(T value) noexcept {
+        return T(c_convert(Endian, U(value)));
+    }
+#endif
+};
+
+#if NADINE_FLOAT
+/* floating-point types */
+template <unsigned Endian, class T>
+struct converter<Endian, T, true> {
+    typedef typename float_bits<T>::type U;
+#if defined(NADINE_I_HPP_NATIVE_FLOAT) && NADINE_I_HPP_BIT_CAST
+    static constexpr T apply(T value) noexcept {
+        return std::bit_cast<T>(xform<U>(Endian ^ NADINE_I_HPP_NATIVE_FLOAT,
+                                         std::bit_cast<U>(value)));
+    }
+#elif defined(NADINE_I_HPP_NATIVE_FLOAT)
+    static T apply(T value) noexcept {
+        U u;
+        std::memcpy(&u, &value, sizeof(u));
+        u = xform<U>(Endian ^ NADINE_I_HPP_NATIVE_FLOAT, u);
+        std::memcpy(&value, &u, sizeof(u));
+        return value;
+    }
+#else
+    static T apply(T value) noexcept {
+        return c_convert(Endian, value);
+    }
+#endif
+};
+#endif /* NADINE_FLOAT */
+
+} /* namespace detail */
+
+template <unsigned Endian, class T>
+constexpr T convert(T value) noexcept {
+    return detail::converter<Endian, T>::apply(value);
+}
+
+template <unsigned Endian, class T>
+inline T read(const void *source) noexcept {
+    T value;
+    std::memcpy(&value, source, sizeof(value));
+    return convert<Endian, T>(value);
+}
+
+template <unsigned Endian, class T>
+inline void write(void *destination, T value) noexcept {
+    value = convert<Endian, T>(value);
+    std::memcpy(destination, &value, sizeof(value));
+}
+
+/* a T stored with the given endianness, for overlaying wire structs */
+template <unsigned Endian, class T>
+class stored {
+public:
+    typedef T value_type;
+    static const unsigned endian = Endian;
+
+    stored() noexcept = default;
+    stored(T value) noexcept { write<Endian>(bytes_, value); }
+    stored &operator=(T value) noexcept {
+        write<Endian>(bytes_, value);
+        return *this;
+    }
+    operator T() const noexcept { return read<Endian, T>(bytes_); }
+
+    T get() const noexcept { return read<Endian, T>(bytes_); }
+    void set(T value) noexcept { write<Endian>(bytes_, value); }
+    unsigned char *data() noexcept { return bytes_; }
+    const unsigned char *data() const noexcept { return bytes_; }
+
+    stored &operator+=(T v) noexcept { return *this = T(get() + v); }
+    stored &operator-=(T v) noexcept { return *this = T(get() - v); }
+    stored &operator*=(T v) noexcept { return *this = T(get() * v); }
+    stored &operator/=(T v) noexcept { return *this = T(get() / v); }
+    stored &operator%=(T v) noexcept { return *this = T(get() % v); }
+    stored &operator&=(T v) noexcept { return *this = T(get() & v); }
+    stored &operator|=(T v) noexcept { return *this = T(get() | v); }
+    stored &operator^=(T v) noexcept { return *this = T(get() ^ v); }
+    stored &operator<<=(unsigned n) noexcept { return *this = T(get() << n); }
+    stored &operator>>=(unsigned n) noexcept { return *this = T(get() >> n); }
+    stored &operator++() noexcept { return *this += T(1); }
+    stored &operator--() noexcept { return *this -= T(1); }
+    T operator++(int) noexcept {
+        T old = get();
+        *this = T(old + T(1));
+        return old;
+    }
+    T operator--(int) noexcept {
+        T old = get();
+        *this = T(old - T(1));
+        return old;
+    }
+
+private:
+    /* chars, so that the alignment is 1 and any buffer may be accessed */
+    unsigned char bytes_[sizeof(T)];
+};
+
+template <unsigned Endian, class T>
+const unsigned stored<Endian, T>::endian;
+
+template <class T> using be = stored<big, T>;
+template <class T> using le = stored<little, T>;
+template <class T> using pdpe = stored<pdp, T>;
+template <class T> using h316e = stored<h316, T>;
+
+} /* namespace nadine */
+
+#endif /* NADINE_HPP */
@@ -0,0 +1,257 @@
+/* BENCHMARK PROGRAM FOR NADINE */
+
+/* Reports ns/op and GB/s for every type and endianness, for the single-value
+   read/write functions and the array functions, on a buffer that fits in
+   the cache and on one that does not.
+
+   The variant being measured is selected when compiling:
+
+     cc -O2 nadine_bench.c                  NADINE_STATIC, default settings
+     cc -O2 -std=c89 nadine_bench.c         C89 (shift-free/union-free paths)
+     cc -O2 -std=c99 nadine_bench.c         C99 (shift reads/writes, unions)
+     cc -O2 -DNADINE_MEMCPY=0 nadine_bench.c
+     cc -O2 -DNADINE_KERNEL=NADINE_KERNEL_SCALAR nadine_bench.c
+                                            scalar array code (also try the
+                                            other NADINE_KERNEL_ values)
+     cc -O2 -DNADINE_SIMD=0 nadine_bench.c  no SIMD code at all
+
+   To measure NADINE_IMPL (calls into another translation unit, no inlining
+   unless link-time optimization is used), compile this file twice:
+
+     cc -O2 -DBENCH_IMPL -c nadine_bench.c -o bench.o
+     cc -O2 -DBENCH_IMPL_TU -c nadine_bench.c -o bench_impl.o
+     cc bench.o bench_impl.o -o nadine_bench
+
+   BENCH_HOT_SIZE and BENCH_COLD_SIZE set the buffer sizes in bytes, and
+   BENCH_MIN_TIME the minimum time to run each measurement in seconds.
+   If arguments are given, only the types named by them are measured
+   (e.g. `nadine_bench uint32 double'). */
+
+#ifdef BENCH_IMPL_TU
+
+#define NADINE_IMPL 1
+#include "nadine.h"
+
+#else /* BENCH_IMPL_TU */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef BENCH_IMPL
+#include "nadine.h"
+#define BENCH_MODE "NADINE_IMPL"
+#else
+#define NADINE_STATIC 1
+#include "nadine.h"
+#define BENCH_MODE "NADINE_STATIC"
+#endif
+
+#ifndef BENCH_HOT_SIZE
+#define BENCH_HOT_SIZE 16384UL
+#endif
+
+#ifndef BENCH_COLD_SIZE
+#define BENCH_COLD_SIZE 67108864UL
+#endif
+
+#ifndef BENCH_MIN_TIME
+#define BENCH_MIN_TIME 0.1
+#endif
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 202311L
+#define BENCH_STD "C23"
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201710L
+#define BENCH_STD "C17"
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define BENCH_STD "C11"
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#define BENCH_STD "C99"
+#else
+#define BENCH_STD "C89"
+#endif
+
+static unsigned char *src_buf;
+static unsigned char *dst_buf;
+
+typedef void (*bench_fn)(unsigned endian, size_t count);
+
+/* returns nanoseconds per element */
+static double bench_run(bench_fn fn, unsigned endian, size_t count) {
+    unsigned long reps = 0, k = 1, i;
+    clock_t start, now;
+    clock_t min_clocks = (clock_t)(BENCH_MIN_TIME * CLOCKS_PER_SEC);
+    if (min_clocks < 1) min_clocks = 1;
+
+    fn(endian, count); /* warm up */
+    start = clock();
+    do {
+        for (i = 0; i < k; ++i) fn(endian, count);
+        reps += k;
+        k *= 2;
+        now = clock();
+    } while (now - start < min_clocks);
+
+    return (double)(now - start) * 1e9 / CLOCKS_PER_SEC
+            / ((double)reps * (double)count);
+}
+
+#define BENCH_TYPE(T, N)                                                       \
+static void bench_read_##N(unsigned endian, size_t count) {                    \
+    size_t i;                                                                  \
+    T *d = (T *)dst_buf;                                                       \
+    for (i = 0; i < count; ++i)                                                \
+        d[i] = nadine_read_##N(endian, src_buf + i * sizeof(T));               \
+}                                                                              \
+static void bench_write_##N(unsigned endian, size_t count) {                   \
+    size_t i;                                                                  \
+    const T *s = (const T *)src_buf;                                           \
+    for (i = 0; i < count; ++i)                                                \
+        nadine_write_##N(endian, dst_buf + i * sizeof(T), s[i]);               \
+}                                                                              \
+static void bench_convert_array_##N(unsigned endian, size_t count) {           \
+    nadine_convert_array_##N(endian, (T *)dst_buf, count);                     \
+}                                                                              \
+static void bench_read_array_##N(unsigned endian, size_t count) {              \
+    nadine_read_array_##N(endian, (T *)dst_buf, src_buf, count);               \
+}                                                                              \
+static void bench_write_array_##N(unsigned endian, size_t count) {             \
+    nadine_write_array_##N(endian, dst_buf, (const T *)src_buf, count);        \
+}                                                                              \
+static void bench_##N(void) {                                                  \
+    bench_type(#N, sizeof(T), bench_read_##N, bench_write_##N,                 \
+               bench_convert_array_##N, bench_read_array_##N,                  \
+               bench_write_array_##N);                                         \
+}
+
+static void bench_type(const char *name, size_t size,
+                       bench_fn read, bench_fn write, bench_fn convert_array,
+                       bench_fn read_array, bench_fn write_array) {
+    static const char *endians[] = { "little", "big", "h316", "pdp" };
+    static const unsigned long sizes[] = { BENCH_HOT_SIZE, BENCH_COLD_SIZE };
+    const char *ops[5];
+    bench_fn fns[5];
+    unsigned e, s, o;
+
+    ops[0] = "read";            fns[0] = read;
+    ops[1] = "write";           fns[1] = write;
+    ops[2] = "convert_array";   fns[2] = convert_array;
+    ops[3] = "read_array";      fns[3] = read_array;
+    ops[4] = "write_array";     fns[4] = write_array;
+
+    for (s = 0; s < 2; ++s) {
+        size_t count = sizes[s] / size;
+        for (o = 0; o < 5; ++o) {
+            for (e = 0; e < 4; ++e) {
+                double ns = bench_run(fns[o], e, count);
+                printf("%-20s %-14s %-7s %9lu %9.3f %9.3f\n", name, ops[o],
+                       endians[e], sizes[s], ns, size / ns);
+                fflush(stdout);
+            }
+        }
+    }
+}
+
+BENCH_TYPE(short, short)
+BENCH_TYPE(unsigned short, unsigned_short)
+BENCH_TYPE(int, int)
+BENCH_TYPE(unsigned int, unsigned_int)
+BENCH_TYPE(long, long)
+BENCH_TYPE(unsigned long, unsigned_long)
+#if NADINE_I_HAS_ULL
+BENCH_TYPE(long long, long_long)
+BENCH_TYPE(unsigned long long, unsigned_long_long)
+#endif
+#if NADINE_STDINT
+BENCH_TYPE(int16_t, int16)
+BENCH_TYPE(uint16_t, uint16)
+BENCH_TYPE(int32_t, int32)
+BENCH_TYPE(uint32_t, uint32)
+BENCH_TYPE(int64_t, int64)
+BENCH_TYPE(uint64_t, uint64)
+#endif
+#if NADINE_INT128
+BENCH_TYPE(nadine_uint128, uint128)
+#endif
+#if NADINE_FLOAT
+BENCH_TYPE(float, float)
+BENCH_TYPE(double, double)
+#endif
+
+struct bench_entry {
+    const char *name;
+    void (*fn)(void);
+};
+
+static const struct bench_entry benches[] = {
+    { "short", bench_short },
+    { "unsigned_short", bench_unsigned_short },
+    { "int", bench_int },
+    { "unsigned_int", bench_unsigned_int },
+    { "long", bench_long },
+    { "unsigned_long", bench_unsigned_long },
+#if NADINE_I_HAS_ULL
+    { "long_long", bench_long_long },
+    { "unsigned_long_long", bench_unsigned_long_long },
+#endif
+#if NADINE_STDINT
+    { "int16", bench_int16 },
+    { "uint16", bench_uint16 },
+    { "int32", bench_int32 },
+    { "uint32", bench_uint32 },
+    { "int64", bench_int64 },
+    { "uint64", bench_uint64 },
+#endif
+#if NADINE_INT128
+    { "uint128", bench_uint128 },
+#endif
+#if NADINE_FLOAT
+    { "float", bench_float },
+    { "double", bench_double },
+#endif
+};
+
+static int selected(const char *name, int argc, char *argv[]) {
+    int i;
+    if (argc < 2) return 1;
+    for (i = 1; i < argc; ++i)
+        if (!strcmp(name, argv[i])) return 1;
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    size_t i;
+
+    /* malloc aligns the buffers for every type they are accessed as */
+    src_buf = malloc(BENCH_COLD_SIZE);
+    dst_buf = malloc(BENCH_COLD_SIZE);
+    if (!src_buf || !dst_buf) {
+        puts("Out of memory.");
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < BENCH_COLD_SIZE; ++i) {
+        src_buf[i] = (unsigned char)(i * 7 + 1);
+        dst_buf[i] = 0;
+    }
+
+    printf("nadine_bench: " BENCH_MODE ", " BENCH_STD ", NADINE_MEMCPY=%d, "
+#if NADINE_SIMD
+           "NADINE_SIMD=1, "
+#else
+           "NADINE_SIMD=0, "
+#endif
+           "array kernel=%u\n", NADINE_MEMCPY, nadine_simd_kernel());
+    printf("%-20s %-14s %-7s %9s %9s %9s\n", "type", "op", "endian",
+           "bytes", "ns/op", "GB/s");
+
+    for (i = 0; i < sizeof(benches) / sizeof(benches[0]); ++i)
+        if (selected(benches[i].name, argc, argv))
+            benches[i].fn();
+
+    free(src_buf);
+    free(dst_buf);
+    return EXIT_SUCCESS;
+}
+
+#endif /* BENCH_IMPL_TU */
@@ -0,0 +1,123 @@
+/* WHOLE-FILE ENDIAN CONVERSION PROGRAM FOR NADINE */
+
+/* Converts an array of values in a file to or from the given endianness,
+   in place or into a new file, using nadine_convert_mapped.
+
+     cc -O2 nadine_conv.c -o nadine_conv
+
+   Usage: nadine_conv [-o output] [-s offset] [-n count] type endian file
+
+   type is one of int16, int32, int64, int128, float or double, and endian
+   one of le, be, pdp or h316. offset is where the values start in the file
+   in chars (default 0), and count how many there are (default all up to
+   the end of the file). With -o, file is left as it is and the result is
+   written to output instead, which must not be file itself. */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NADINE_STATIC 1
+#define NADINE_MMAP 1
+#include "nadine.h"
+
+struct conv_name {
+    const char *name;
+    size_t value;
+    unsigned kind;
+};
+
+static const struct conv_name types[] = {
+    { "int16", 2, NADINE_FIELD_INT },
+    { "int32", 4, NADINE_FIELD_INT },
+    { "int64", 8, NADINE_FIELD_INT },
+    { "int128", 16, NADINE_FIELD_INT },
+#if NADINE_FLOAT
+    { "float", sizeof(float), NADINE_FIELD_FLOAT },
+    { "double", sizeof(double), NADINE_FIELD_FLOAT },
+#endif
+};
+
+static const struct conv_name endians[] = {
+    { "le", NADINE_ENDIAN_LITTLE, 0 },
+    { "be", NADINE_ENDIAN_BIG, 0 },
+    { "pdp", NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS, 0 },
+    { "h316", NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS, 0 },
+};
+
+static const struct conv_name *lookup(const struct conv_name *names,
+                                      size_t n, const char *name) {
+    size_t i;
+    for (i = 0; i < n; ++i)
+        if (!strcmp(names[i].name, name)) return &names[i];
+    return NULL;
+}
+
+/* parse a whole nonnegative number into *value. returns 0 on error */
+static int parse_size(const char *s, size_t *value) {
+    char *end;
+    unsigned long n;
+    if (*s < '0' || *s > '9') return 0;
+    n = strtoul(s, &end, 0);
+    if (*end || n > (size_t)-1) return 0;
+    *value = (size_t)n;
+    return 1;
+}
+
+static int usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-o output] [-s offset] [-n count] "
+                    "type endian file\n"
+                    "  type:   int16 int32 int64 int128"
+#if NADINE_FLOAT
+                    " float double"
+#endif
+                    "\n  endian: le be pdp h316\n", argv0);
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[]) {
+    const char *output = NULL;
+    const struct conv_name *type, *endian;
+    size_t offset = 0, count = NADINE_MAPPED_ALL;
+    int i, ok;
+
+    for (i = 1; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+        if (!strcmp(argv[i], "-o"))
+            output = argv[i + 1];
+        else if (!strcmp(argv[i], "-s") && parse_size(argv[i + 1], &offset))
+            ;
+        else if (!strcmp(argv[i], "-n") && parse_size(argv[i + 1], &count))
+            ;
+        else
+            return usage(argv[0]);
+    }
+    if (argc - i != 3) return usage(argv[0]);
+
+    type = lookup(types, sizeof(types) / sizeof(types[0]), argv[i]);
+    endian = lookup(endians, sizeof(endians) / sizeof(endians[0]),
+                    argv[i + 1]);
+    if (!type || !endian) return usage(argv[0]);
+
+    errno = 0;
+    if (output)
+        ok = nadine_convert_mapped_copy(output, argv[i + 2], type->value,
+                                        type->kind, (unsigned)endian->value,
+                                        offset, count);
+    else
+        ok = nadine_convert_mapped(argv[i + 2], type->value, type->kind,
+                                   (unsigned)endian->value, offset, count);
+    if (!ok) {
+        if (errno)
+            perror(argv[i + 2]);
+        else
+            fprintf(stderr, "%s: values do not fit in the file\n",
+                    argv[i + 2]);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
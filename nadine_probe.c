@@ -0,0 +1,82 @@
+/* NATIVE ENDIANNESS PROBE PROGRAM FOR NADINE */
+
+/* Detects the native endianness of the integral and floating-point types
+   at run time and prints a header that defines NADINE_NATIVE_ENDIAN_INT
+   and NADINE_NATIVE_ENDIAN_FLOAT accordingly, for compilers and systems
+   that do not make them known at compile time. Run it on (or for) the
+   target as part of the build:
+
+     cc nadine_probe.c -o nadine_probe
+     ./nadine_probe > nadine_native.h
+     cc -DNADINE_CONFIG_HEADER='"nadine_native.h"' ...
+
+   If the types of a class do not all have the same endianness, or it is
+   not supported, the header leaves that class to be detected at run time.
+   The exit status is nonzero if the header could not be written. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NADINE_STATIC 1
+#define NADINE_NATIVE_ENDIAN_INT_AUTO 0
+#define NADINE_NATIVE_ENDIAN_FLOAT_AUTO 0
+#define NADINE_NATIVE_ENDIAN_CACHE 0
+#undef NADINE_CONFIG_HEADER
+#undef NADINE_NATIVE_ENDIAN_INT
+#undef NADINE_NATIVE_ENDIAN_FLOAT
+#include "nadine.h"
+
+static const char *endian_name(unsigned endian) {
+    switch (endian) {
+    case NADINE_ENDIAN_LITTLE:
+        return "NADINE_ENDIAN_LITTLE";
+    case NADINE_ENDIAN_BIG:
+        return "NADINE_ENDIAN_BIG";
+    case NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS:
+        return "(NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS)";
+    case NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS:
+        return "(NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS)";
+    }
+    return NULL;
+}
+
+/* returns the endianness common to all n values, or NADINE_ENDIAN_UNKNOWN */
+static unsigned common(const unsigned *endians, size_t n) {
+    size_t i;
+    for (i = 1; i < n; ++i)
+        if (endians[i] != endians[0]) return NADINE_ENDIAN_UNKNOWN;
+    return endians[0];
+}
+
+static void emit(const char *macro, const unsigned *endians, size_t n) {
+    const char *name = endian_name(common(endians, n));
+    if (name)
+        printf("#ifndef %s\n#define %s %s\n#endif\n", macro, macro, name);
+    else
+        printf("/* %s: differs between types or is not supported, "
+               "detected at run time */\n", macro);
+}
+
+int main(void) {
+    unsigned ints[8], floats[2];
+    size_t ni = 0, nf = 0;
+
+    ints[ni++] = nadine_endian_native_unsigned_short();
+    ints[ni++] = nadine_endian_native_unsigned_int();
+    ints[ni++] = nadine_endian_native_unsigned_long();
+#if NADINE_I_HAS_ULL
+    ints[ni++] = nadine_endian_native_unsigned_long_long();
+#endif
+#if NADINE_INT128 && NADINE_I_HAS_INT128
+    ints[ni++] = nadine_endian_native_uint128();
+#endif
+#if NADINE_FLOAT
+    floats[nf++] = nadine_endian_native_float();
+    floats[nf++] = nadine_endian_native_double();
+#endif
+
+    puts("/* native endianness for nadine.h, generated by nadine_probe */");
+    emit("NADINE_NATIVE_ENDIAN_INT", ints, ni);
+    if (nf) emit("NADINE_NATIVE_ENDIAN_FLOAT", floats, nf);
+    return fflush(stdout) || ferror(stdout) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -1,8 +1,15 @@
 /* TEST PROGRAM FOR NADINE */
 
+/* the memory-mapped file functions need POSIX.1-2001 (posix_madvise,
+   ftruncate), which strict C modes hide */
+#if NADINE_MMAP && !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define NADINE_STATIC 1
 #include "nadine.h"
@@ -314,6 +321,18 @@ static int test_uint64(void) {
                   && buf[4] == 4 && buf[5] == 3
                   && buf[6] == 2 && buf[7] == 1, "u64 write LE fail");
 
+    nadine_write_uint64(NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS, buf, vbe);
+    failed += VERIFY(buf[0] == 2 && buf[1] == 1
+                  && buf[2] == 4 && buf[3] == 3
+                  && buf[4] == 6 && buf[5] == 5
+                  && buf[6] == 8 && buf[7] == 7, "u64 write PDP fail");
+
+    nadine_write_uint64(NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS, buf, vbe);
+    failed += VERIFY(buf[0] == 7 && buf[1] == 8
+                  && buf[2] == 5 && buf[3] == 6
+                  && buf[4] == 3 && buf[5] == 4
+                  && buf[6] == 1 && buf[7] == 2, "u64 write 316 fail");
+
     return failed;
 }
 
@@ -379,7 +398,1859 @@ static int test_int64(void) {
     return failed;
 }
 
+#if NADINE_INT128
+#if NADINE_I_HAS_INT128
+#define U128_HI(v) ((uint64_t)((v) >> 64))
+#define U128_LO(v) ((uint64_t)(v))
+#else
+#define U128_HI(v) ((uint64_t)(v).hi)
+#define U128_LO(v) ((uint64_t)(v).lo)
+#endif
+
+static int test_uint128(void) {
+    int failed = 0;
+
+    unsigned char buf[16], out[16];
+    nadine_uint128 v;
+    nadine_int128 s;
+    unsigned i;
+
+    for (i = 0; i < 16; ++i) buf[i] = (unsigned char)(i + 1);
+
+    v = nadine_read_uint128(NADINE_ENDIAN_BIG, buf);
+    failed += VERIFY(U128_HI(v) == UINT64_C(0x0102030405060708)
+                  && U128_LO(v) == UINT64_C(0x090A0B0C0D0E0F10),
+                     "u128 read BE fail");
+    v = nadine_read_uint128(NADINE_ENDIAN_LITTLE, buf);
+    failed += VERIFY(U128_HI(v) == UINT64_C(0x100F0E0D0C0B0A09)
+                  && U128_LO(v) == UINT64_C(0x0807060504030201),
+                     "u128 read LE fail");
+    v = nadine_read_uint128(NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS, buf);
+    failed += VERIFY(U128_HI(v) == UINT64_C(0x0201040306050807)
+                  && U128_LO(v) == UINT64_C(0x0A090C0B0E0D100F),
+                     "u128 read PDP fail");
+    v = nadine_read_uint128(NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS, buf);
+    failed += VERIFY(U128_HI(v) == UINT64_C(0x0F100D0E0B0C090A)
+                  && U128_LO(v) == UINT64_C(0x0708050603040102),
+                     "u128 read 316 fail");
+
+    for (i = 0; i < 4; ++i) {
+        v = nadine_read_uint128(i, buf);
+        nadine_write_uint128(i, out, v);
+        failed += VERIFY(!memcmp(out, buf, 16), "u128 write fail");
+        s = nadine_read_be_int128(buf);
+        nadine_write_be_int128(out, s);
+        failed += VERIFY(!memcmp(out, buf, 16), "i128 write BE fail");
+    }
+
+    v = nadine_read_le_uint128(buf);
+    v = nadine_convert_uint128(nadine_endian_native_uint128(), v);
+    nadine_write_le_uint128(out, v);
+    failed += VERIFY(!memcmp(out, buf, 16), "u128 convert native fail");
+
+    return failed;
+}
+#endif
+
+#define PACKED_TEST_LEN 101
+
+static int test_native_endian(void) {
+    int failed = 0;
+    unsigned long v = 1;
+    unsigned char buf[sizeof(v)];
+    unsigned endian;
+
+    nadine_i_memcpy(buf, &v, sizeof(buf));
+    endian = buf[0] ? NADINE_ENDIAN_LITTLE
+           : buf[sizeof(v) - 1] ? NADINE_ENDIAN_BIG : NADINE_ENDIAN_UNKNOWN;
+
+    failed += VERIFY(nadine_endian_native_unsigned_long() == endian,
+                     "native ulong endianness mismatch");
+    failed += VERIFY(nadine_endian_native_long() == endian,
+                     "native long endianness mismatch");
+    failed += VERIFY(nadine_endian_native_unsigned_long() ==
+                     nadine_endian_native_unsigned_long(),
+                     "native endianness changed between calls");
+    failed += VERIFY(nadine_convert_unsigned_long(endian, v) == v,
+                     "native ulong conversion should not change value");
+#if NADINE_FLOAT
+    {
+        double d = 2.0;
+        unsigned char dbuf[sizeof(d)];
+        nadine_i_memcpy(dbuf, &d, sizeof(dbuf));
+        endian = dbuf[sizeof(d) - 1] ? NADINE_ENDIAN_LITTLE
+               : dbuf[0] ? NADINE_ENDIAN_BIG : NADINE_ENDIAN_UNKNOWN;
+        failed += VERIFY(nadine_endian_native_double() == endian,
+                         "native double endianness mismatch");
+    }
+#endif
+
+    return failed;
+}
+
+static int test_config(void) {
+    int failed = 0;
+    nadine_config_info info;
+    const nadine_type_info *ti;
+    unsigned i, e, native;
+
+    nadine_config(&info);
+    failed += VERIFY(info.kernel == nadine_simd_kernel(),
+                     "config kernel mismatch");
+    failed += VERIFY(!(info.flags & NADINE_CONFIG_STATS) == !NADINE_STATS,
+                     "config stats flag mismatch");
+    failed += VERIFY(info.type_count > 0
+                     && info.type_count <= NADINE_CONFIG_MAX_TYPES,
+                     "config type count out of range");
+    failed += VERIFY(!strcmp(info.types[0].name, "unsigned_short")
+                     && info.types[0].size == sizeof(unsigned short)
+                     && info.types[0].native
+                        == nadine_endian_native_unsigned_short(),
+                     "config first type mismatch");
+
+    for (i = 0; i < info.type_count && i < NADINE_CONFIG_MAX_TYPES; ++i) {
+        ti = &info.types[i];
+        if (ti->native == NADINE_ENDIAN_UNKNOWN) continue;
+        for (e = 0; e < 4; ++e) {
+            failed += VERIFY((ti->convert[e] == NADINE_PATH_NATIVE)
+                             == (e == ti->native),
+                             "config convert path mismatch");
+            if (!(info.flags & NADINE_CONFIG_SHIFT_RW))
+                failed += VERIFY(ti->rw[e] == ti->convert[e],
+                                 "config rw path mismatch");
+        }
+    }
+
+#if NADINE_STATS
+    {
+        nadine_stats stats;
+        unsigned long v = 0x1234UL;
+        native = nadine_endian_native_unsigned_long();
+        nadine_reset_stats();
+        v = nadine_convert_unsigned_long(native, v);
+        v = nadine_convert_unsigned_long(native ^ NADINE_ENDIAN_BIG, v);
+        nadine_get_stats(&stats);
+        failed += VERIFY(v == nadine_convert_unsigned_long(
+                                    native ^ NADINE_ENDIAN_BIG, 0x1234UL),
+                         "stats conversion mismatch");
+        /* info.types[2] is unsigned_long */
+        e = info.types[2].convert[native ^ NADINE_ENDIAN_BIG];
+        failed += VERIFY(stats.calls[NADINE_PATH_NATIVE] == 1
+                         && stats.calls[e] == 1,
+                         "stats counts mismatch");
+        nadine_reset_stats();
+        nadine_get_stats(&stats);
+        failed += VERIFY(!stats.calls[NADINE_PATH_NATIVE]
+                         && !stats.calls[e], "stats reset fail");
+    }
+#else
+    (void)native;
+#endif
+
+    return failed;
+}
+
+static int test_packed(void) {
+    int failed = 0;
+
+    static const unsigned char b24[3] = { 0x01, 0x02, 0x03 };
+    unsigned char buf[6], src[PACKED_TEST_LEN * 6 + 1];
+    unsigned char dst[PACKED_TEST_LEN * 6 + 1];
+    nadine_uint24 u24[PACKED_TEST_LEN];
+    nadine_int24 s24[PACKED_TEST_LEN];
+    unsigned endian;
+    size_t i;
+    int ok;
+
+    failed += VERIFY(nadine_read_uint24(NADINE_ENDIAN_BIG, b24) == 0x010203UL,
+                     "u24 read BE fail");
+    failed += VERIFY(nadine_read_uint24(NADINE_ENDIAN_LITTLE, b24)
+                     == 0x030201UL, "u24 read LE fail");
+    failed += VERIFY(nadine_read_uint24(NADINE_ENDIAN_BIG
+                                        | NADINE_ENDIAN_SWAPCHARS, b24)
+                     == 0x020103UL, "u24 read PDP fail");
+    failed += VERIFY(nadine_read_uint24(NADINE_ENDIAN_LITTLE
+                                        | NADINE_ENDIAN_SWAPCHARS, b24)
+                     == 0x030102UL, "u24 read 316 fail");
+
+    buf[0] = 0xFF; buf[1] = 0xFF; buf[2] = 0xFE;
+    failed += VERIFY(nadine_read_int24(NADINE_ENDIAN_BIG, buf) == -2,
+                     "i24 read negative fail");
+    failed += VERIFY(nadine_read_uint24(NADINE_ENDIAN_BIG, buf) == 0xFFFFFEUL,
+                     "u24 read should not sign-extend");
+    buf[0] = 0x00; buf[1] = 0x00; buf[2] = 0x80;
+    failed += VERIFY(nadine_read_int24(NADINE_ENDIAN_LITTLE, buf) == -8388608L,
+                     "i24 read min fail");
+    buf[0] = 0xFF; buf[1] = 0xFF; buf[2] = 0x7F;
+    failed += VERIFY(nadine_read_int24(NADINE_ENDIAN_LITTLE, buf) == 8388607L,
+                     "i24 read max fail");
+
+    nadine_write_int24(NADINE_ENDIAN_BIG, buf, -2);
+    failed += VERIFY(buf[0] == 0xFF && buf[1] == 0xFF && buf[2] == 0xFE,
+                     "i24 write BE fail");
+    nadine_write_uint24(NADINE_ENDIAN_LITTLE, buf, 0x12345678UL);
+    failed += VERIFY(buf[0] == 0x78 && buf[1] == 0x56 && buf[2] == 0x34,
+                     "u24 write should drop the high bits");
+
+    /* arrays, unaligned, against single values */
+    for (i = 0; i < sizeof(src); ++i)
+        src[i] = (unsigned char)(i * 151 + 7);
+    for (endian = 0; endian < 4; ++endian) {
+        nadine_read_array_uint24(endian, u24, src + 1, PACKED_TEST_LEN);
+        nadine_read_array_int24(endian, s24, src + 1, PACKED_TEST_LEN);
+        ok = 1;
+        for (i = 0; i < PACKED_TEST_LEN; ++i) {
+            ok &= u24[i] == nadine_read_uint24(endian, src + 1 + i * 3);
+            ok &= s24[i] == nadine_read_int24(endian, src + 1 + i * 3);
+        }
+        failed += VERIFY(ok, "24-bit array read mismatch");
+
+        memset(dst, 0, sizeof(dst));
+        nadine_write_array_int24(endian, dst + 1, s24, PACKED_TEST_LEN);
+        failed += VERIFY(!memcmp(dst + 1, src + 1, PACKED_TEST_LEN * 3),
+                         "i24 array write mismatch");
+        memset(dst, 0, sizeof(dst));
+        nadine_write_array_uint24(endian, dst + 1, u24, PACKED_TEST_LEN);
+        failed += VERIFY(!memcmp(dst + 1, src + 1, PACKED_TEST_LEN * 3),
+                         "u24 array write mismatch");
+    }
+
+#ifdef NADINE_I_U64
+    {
+        static const unsigned char b48[6] = { 1, 2, 3, 4, 5, 6 };
+        nadine_uint48 u48[PACKED_TEST_LEN];
+        nadine_int48 s48[PACKED_TEST_LEN];
+
+        failed += VERIFY(nadine_read_uint48(NADINE_ENDIAN_BIG, b48)
+                         == UINT64_C(0x010203040506), "u48 read BE fail");
+        failed += VERIFY(nadine_read_uint48(NADINE_ENDIAN_LITTLE, b48)
+                         == UINT64_C(0x060504030201), "u48 read LE fail");
+        failed += VERIFY(nadine_read_uint48(NADINE_ENDIAN_BIG
+                                            | NADINE_ENDIAN_SWAPCHARS, b48)
+                         == UINT64_C(0x020104030605), "u48 read PDP fail");
+        failed += VERIFY(nadine_read_uint48(NADINE_ENDIAN_LITTLE
+                                            | NADINE_ENDIAN_SWAPCHARS, b48)
+                         == UINT64_C(0x050603040102), "u48 read 316 fail");
+
+        memset(buf, 0xFF, 6);
+        buf[5] = 0xFE;
+        failed += VERIFY(nadine_read_int48(NADINE_ENDIAN_BIG, buf) == -2,
+                         "i48 read negative fail");
+        buf[0] = 0x80;
+        failed += VERIFY(nadine_read_int48(NADINE_ENDIAN_LITTLE, buf)
+                         == -INT64_C(0x010000000080),
+                         "i48 read LE fail");
+        nadine_write_int48(NADINE_ENDIAN_BIG, buf, -3);
+        failed += VERIFY(buf[0] == 0xFF && buf[4] == 0xFF && buf[5] == 0xFD,
+                         "i48 write BE fail");
+
+        for (endian = 0; endian < 4; ++endian) {
+            nadine_read_array_uint48(endian, u48, src + 1, PACKED_TEST_LEN);
+            nadine_read_array_int48(endian, s48, src + 1, PACKED_TEST_LEN);
+            ok = 1;
+            for (i = 0; i < PACKED_TEST_LEN; ++i) {
+                ok &= u48[i] == nadine_read_uint48(endian, src + 1 + i * 6);
+                ok &= s48[i] == nadine_read_int48(endian, src + 1 + i * 6);
+                ok &= ((u48[i] >> 47) & 1) == (s48[i] < 0);
+            }
+            failed += VERIFY(ok, "48-bit array read mismatch");
+
+            memset(dst, 0, sizeof(dst));
+            nadine_write_array_int48(endian, dst + 1, s48, PACKED_TEST_LEN);
+            failed += VERIFY(!memcmp(dst + 1, src + 1, PACKED_TEST_LEN * 6),
+                             "i48 array write mismatch");
+        }
+    }
+#endif
+
+    return failed;
+}
+
+static int test_fixed_endian(void) {
+    int failed = 0;
+
+    const unsigned char src[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    unsigned char buf[8];
+
+    failed += VERIFY(nadine_read_le_uint16(src) == UINT16_C(0x0201),
+                     "u16 read_le fail");
+    failed += VERIFY(nadine_read_be_int32(src) == INT32_C(0x01020304),
+                     "i32 read_be fail");
+    failed += VERIFY(nadine_read_pdp_uint32(src) == UINT32_C(0x02010403),
+                     "u32 read_pdp fail");
+    failed += VERIFY(nadine_read_h316_uint32(src) == UINT32_C(0x03040102),
+                     "u32 read_h316 fail");
+    failed += VERIFY(nadine_read_be_uint64(src)
+                        == UINT64_C(0x0102030405060708), "u64 read_be fail");
+
+    nadine_write_be_uint32(buf, UINT32_C(0x01020304));
+    failed += VERIFY(!memcmp(buf, src, 4), "u32 write_be fail");
+    nadine_write_le_int64(buf, INT64_C(0x0807060504030201));
+    failed += VERIFY(!memcmp(buf, src, 8), "i64 write_le fail");
+    nadine_write_pdp_uint32(buf, UINT32_C(0x02010403));
+    failed += VERIFY(!memcmp(buf, src, 4), "u32 write_pdp fail");
+
+    failed += VERIFY(nadine_convert_be_uint32(UINT32_C(0x01020304))
+                == nadine_convert_uint32(NADINE_ENDIAN_BIG, UINT32_C(0x01020304)),
+                "u32 convert_be fail");
+    failed += VERIFY(nadine_convert_h316_uint32(UINT32_C(0x01020304))
+                == nadine_convert_uint32(
+                        NADINE_ENDIAN_LITTLE | NADINE_ENDIAN_SWAPCHARS,
+                        UINT32_C(0x01020304)),
+                "u32 convert_h316 fail");
+
+#if NADINE_FLOAT
+    nadine_write_be_double(buf, 7.0);
+    failed += VERIFY(buf[0] == 0x40 && buf[1] == 0x1C,
+                     "f64 write_be fail");
+    failed += VERIFY(nadine_read_be_double(buf) == 7.0, "f64 read_be fail");
+#endif
+
+    return failed;
+}
+
+static int test_codec(void) {
+    int failed = 0;
+
+    const unsigned char src[32] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+                                    13, 14, 15, 16, 17, 18, 19, 20, 21, 22,
+                                    23, 24, 25, 26, 27, 28, 29, 30, 31, 32 };
+    unsigned char buf[32], ref[32];
+    uint32_t a32[8], r32[8];
+    uint16_t a16[16], r16[16];
+    unsigned endian;
+    size_t i;
+    int ok;
+
+    for (endian = 0; endian < 4; ++endian) {
+        const nadine_codec *c = nadine_codec_for(endian);
+        if (VERIFY(c && c->endian == endian, "codec missing")) {
+            ++failed;
+            continue;
+        }
+
+        ok = 1;
+        ok &= c->read_uint16(src + 1) == nadine_read_uint16(endian, src + 1);
+        ok &= c->read_int32(src + 1) == nadine_read_int32(endian, src + 1);
+        ok &= c->read_uint64(src + 3) == nadine_read_uint64(endian, src + 3);
+        ok &= c->read_unsigned_long(src)
+                == nadine_read_unsigned_long(endian, src);
+        ok &= c->convert_uint32(UINT32_C(0x01020304))
+                == nadine_convert_uint32(endian, UINT32_C(0x01020304));
+        c->write_int16(buf, -2);
+        nadine_write_int16(endian, ref, -2);
+        ok &= !memcmp(buf, ref, 2);
+        c->write_uint64(buf + 1, UINT64_C(0x0102030405060708));
+        nadine_write_uint64(endian, ref + 1, UINT64_C(0x0102030405060708));
+        ok &= !memcmp(buf + 1, ref + 1, 8);
+#if NADINE_FLOAT
+        c->write_double(buf, -7.5);
+        nadine_write_double(endian, ref, -7.5);
+        ok &= !memcmp(buf, ref, 8) && c->read_double(buf) == -7.5;
+#endif
+        failed += VERIFY(ok, "codec value mismatch");
+
+        ok = 1;
+        c->read_array_uint32(a32, src, 8);
+        nadine_read_array_uint32(endian, r32, src, 8);
+        ok &= !memcmp(a32, r32, sizeof(a32));
+        c->write_array_uint32(buf, a32, 8);
+        nadine_write_array_uint32(endian, ref, a32, 8);
+        ok &= !memcmp(buf, ref, 32);
+        for (i = 0; i < 16; ++i) a16[i] = r16[i] = (uint16_t)(i * 0x0305);
+        c->convert_array_uint16(a16, 16);
+        nadine_convert_array_uint16(endian, r16, 16);
+        ok &= !memcmp(a16, r16, sizeof(a16));
+        failed += VERIFY(ok, "codec array mismatch");
+    }
+
+    failed += VERIFY(!nadine_codec_for(4), "codec for endian 4");
+    failed += VERIFY(!nadine_codec_for(NADINE_ENDIAN_UNKNOWN),
+                     "codec for unknown endian");
+
+    return failed;
+}
+
+static int test_aligned(void) {
+    int failed = 0;
+
+    uint64_t words[2], out[2];
+    unsigned char bytes[40], copy[40];
+    const unsigned char *src = (const unsigned char *)words;
+    unsigned endian;
+    size_t i, j, n;
+    int ok;
+
+    for (i = 0; i < 16; ++i)
+        ((unsigned char *)words)[i] = (unsigned char)(i + 1);
+
+    for (endian = 0; endian < 4; ++endian) {
+        ok = nadine_read_aligned_uint16(endian, src)
+                == nadine_read_uint16(endian, src);
+        ok &= nadine_read_aligned_int32(endian, src + 4)
+                == nadine_read_int32(endian, src + 4);
+        ok &= nadine_read_aligned_uint64(endian, src + 8)
+                == nadine_read_uint64(endian, src + 8);
+        failed += VERIFY(ok, "aligned read mismatch");
+
+        nadine_write_aligned_uint32(endian, out, UINT32_C(0x01020304));
+        nadine_write_aligned_int64(endian, out + 1, INT64_C(-0x0102030405));
+        nadine_write_uint32(endian, bytes, UINT32_C(0x01020304));
+        nadine_write_int64(endian, bytes + 8, INT64_C(-0x0102030405));
+        failed += VERIFY(!memcmp(out, bytes, 4)
+                      && !memcmp(out + 1, bytes + 8, 8),
+                         "aligned write mismatch");
+#if NADINE_FLOAT
+        nadine_write_aligned_double(endian, out, -7.25);
+        failed += VERIFY(nadine_read_double(endian, out) == -7.25
+                      && nadine_read_aligned_double(endian, out) == -7.25,
+                         "aligned f64 mismatch");
+#endif
+    }
+
+    /* the copy loop, if it is ours, at every relative alignment */
+    for (i = 0; i < sizeof(bytes); ++i)
+        bytes[i] = (unsigned char)(i * 7 + 1);
+    ok = 1;
+    for (i = 0; i < 8; ++i) {
+        for (j = 1; j < 9; ++j) {
+            for (n = 0; n <= 24; ++n) {
+                memset(copy, 0xEE, sizeof(copy));
+                nadine_i_memcpy(copy + j, bytes + i, n);
+                ok &= !memcmp(copy + j, bytes + i, n);
+                ok &= copy[j - 1] == 0xEE && copy[j + n] == 0xEE;
+            }
+        }
+    }
+    failed += VERIFY(ok, "nadine_i_memcpy mismatch");
+
+    return failed;
+}
+
+#define CHECKSUM_LEN 5000
+
+static unsigned char checksum_src[CHECKSUM_LEN * 8 + 1];
+static uint16_t checksum_u16[CHECKSUM_LEN];
+static uint64_t checksum_u64[CHECKSUM_LEN];
+
+static uint32_t crc32c_ref(uint32_t crc, const unsigned char *p, size_t n) {
+    int k;
+    crc = ~crc;
+    while (n--) {
+        crc ^= *p++;
+        for (k = 0; k < 8; ++k)
+            crc = (crc >> 1) ^ (UINT32_C(0x82F63B78) & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static int test_checksum(void) {
+    int failed = 0;
+
+    static const unsigned char rfc1071[] = {
+        0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7
+    };
+    const unsigned char *src = checksum_src + 1;
+    unsigned endian, sum;
+    uint32_t want;
+    size_t i, n;
+    int ok;
+
+    sum = nadine_read_array_sum_uint16(NADINE_ENDIAN_BIG, checksum_u16,
+                                       rfc1071, 4, 0);
+    failed += VERIFY(sum == 0xddf2, "RFC 1071 example sum mismatch");
+    failed += VERIFY(nadine_read_array_crc32c_uint16(NADINE_ENDIAN_BIG,
+                            checksum_u16, "12345678", 4, 0)
+                     == crc32c_ref(0, (const unsigned char *)"12345678", 8),
+                     "CRC32C mismatch on short input");
+    failed += VERIFY(crc32c_ref(0, (const unsigned char *)"123456789", 9)
+                     == UINT32_C(0xE3069283), "CRC32C reference broken");
+
+    for (i = 0; i < sizeof(checksum_src); ++i)
+        checksum_src[i] = (unsigned char)(i * 131 + (i >> 7) + 3);
+
+    for (endian = 0; endian < 4; ++endian) {
+        for (n = 0; n <= CHECKSUM_LEN; n += n < 40 ? 1 : 1237) {
+            unsigned long ref = 0;
+            ok = 1;
+            for (i = 0; i < n; ++i)
+                ref += nadine_read_uint16(endian, src + i * 2);
+            while (ref >> 16)
+                ref = (ref & 0xFFFF) + (ref >> 16);
+            sum = nadine_read_array_sum_uint16(endian, checksum_u16, src, n,
+                                               0x1234);
+            ref += 0x1234;
+            while (ref >> 16)
+                ref = (ref & 0xFFFF) + (ref >> 16);
+            ok &= sum == ref;
+            for (i = 0; i < n; ++i)
+                ok &= checksum_u16[i] == nadine_read_uint16(endian,
+                                                            src + i * 2);
+            failed += VERIFY(ok, "u16 read with sum mismatch");
+
+            want = crc32c_ref(UINT32_C(0x89abcdef), src, n * 8);
+            ok = nadine_read_array_crc32c_uint64(endian, checksum_u64, src,
+                                                 n, UINT32_C(0x89abcdef))
+                    == want;
+            for (i = 0; i < n; ++i)
+                ok &= checksum_u64[i] == nadine_read_uint64(endian,
+                                                            src + i * 8);
+            failed += VERIFY(ok, "u64 read with CRC32C mismatch");
+        }
+    }
+
+    return failed;
+}
+
+#define SEARCH_LEN 3001
+
+static unsigned char search_buf[SEARCH_LEN * 8 + 1];
+
+static int test_search(void) {
+    int failed = 0;
+
+    unsigned char *keys = search_buf + 1;
+    unsigned endian;
+    size_t i, n, want;
+    int ok;
+
+    for (endian = 0; endian < 4; ++endian) {
+        uint16_t lo16, hi16;
+        int32_t lo32, hi32;
+        uint64_t k64, lo64, hi64;
+
+        /* sorted, with runs of equal keys */
+        for (i = 0; i < SEARCH_LEN; ++i)
+            nadine_write_uint64(endian, keys + i * 8,
+                                (uint64_t)(i / 3) * UINT64_C(0x0100000001));
+        ok = 1;
+        for (n = 0; n <= SEARCH_LEN; n += n < 20 ? 1 : 997) {
+            /* keys that are there, and ones between them */
+            for (k64 = 0; k64 <= SEARCH_LEN; k64 += 1 + k64 / 7) {
+                uint64_t key = (k64 / 2) * UINT64_C(0x0100000001) + k64 % 2;
+                for (want = 0; want < n
+                        && nadine_read_uint64(endian, keys + want * 8) < key;
+                        ++want)
+                    ;
+                ok &= nadine_bsearch_uint64(endian, keys, n, key) == want;
+            }
+        }
+        failed += VERIFY(ok, "u64 bsearch mismatch");
+
+        /* every position of a single match, and none */
+        ok = 1;
+        for (i = 0; i < SEARCH_LEN; ++i)
+            nadine_write_uint16(endian, keys + i * 2, (uint16_t)(i * 2 + 1));
+        for (i = 0; i < 70; ++i)
+            ok &= nadine_find_uint16(endian, keys, 70, (uint16_t)(i * 2 + 1))
+                    == i;
+        ok &= nadine_find_uint16(endian, keys, SEARCH_LEN, 2) == SEARCH_LEN;
+        /* chars of the key matching across value boundaries */
+        ok &= nadine_find_uint16(endian, keys, SEARCH_LEN, 0x0300)
+                == SEARCH_LEN;
+        ok &= nadine_find_uint64(endian, keys, SEARCH_LEN / 4,
+                                 nadine_read_uint64(endian, keys + 40 * 8))
+                == 40;
+        ok &= nadine_find_int32(endian, keys + 2, 5, 0) == 5;
+        failed += VERIFY(ok, "find mismatch");
+
+        ok = nadine_minmax_uint16(endian, keys, SEARCH_LEN, &lo16, &hi16);
+        ok &= lo16 == 1 && hi16 == (uint16_t)((SEARCH_LEN - 1) * 2 + 1);
+        for (i = 0; i < SEARCH_LEN; ++i)
+            nadine_write_int32(endian, keys + i * 4,
+                               (int32_t)((i * 7919) % 2003) - 1000);
+        ok &= nadine_minmax_int32(endian, keys, SEARCH_LEN, &lo32, &hi32);
+        ok &= lo32 == -1000 && hi32 == 1002;
+        ok &= nadine_minmax_int32(endian, keys, 1, &lo32, NULL);
+        ok &= lo32 == -1000;
+        ok &= !nadine_minmax_uint64(endian, keys, 0, &lo64, &hi64);
+        failed += VERIFY(ok, "minmax mismatch");
+    }
+
+    return failed;
+}
+
+#define ARRAY_TEST_LEN 37
+
+#define KEY_LEN 1500
+
+static unsigned char key_buf[KEY_LEN * 8 + 1];
+
+/* whether the keys of v[n] at k, size chars each, are in the order of
+   the values: cmp(i, j) is the sign of v[i] - v[j] */
+static int key_order(const unsigned char *k, size_t size, size_t n,
+                     int (*cmp)(size_t, size_t)) {
+    size_t i, j;
+    int ok = 1;
+    for (i = 0; i < n; ++i)
+        for (j = 0; j < n; ++j) {
+            int c = memcmp(k + i * size, k + j * size, size);
+            ok &= (c > 0) - (c < 0) == cmp(i, j);
+        }
+    return ok;
+}
+
+static const int32_t key_i32[] = {
+    0, 1, -1, 2, -2, 127, 128, -128, -129, 255, 256, 65535, -65536,
+    INT32_C(2147483647), -INT32_C(2147483647) - 1, INT32_C(0x01020304),
+};
+static const uint64_t key_u64[] = {
+    0, 1, 255, 256, UINT64_C(0x0100000000), UINT64_C(0xFFFFFFFFFFFFFFFF),
+    UINT64_C(0x8000000000000000), UINT64_C(0x7FFFFFFFFFFFFFFF),
+};
+
+static int key_cmp_i32(size_t i, size_t j) {
+    return (key_i32[i] > key_i32[j]) - (key_i32[i] < key_i32[j]);
+}
+
+static int key_cmp_u64(size_t i, size_t j) {
+    return (key_u64[i] > key_u64[j]) - (key_u64[i] < key_u64[j]);
+}
+
+#if NADINE_FLOAT
+static const double key_f64[] = {
+    0.0, 1.0, -1.0, 0.5, -0.5, 1e300, -1e300, 1e-300, -1e-300, 2.0, -2.0,
+    4.9e-324, -4.9e-324, 1.5, -1.5, 123456.789,
+};
+
+static int key_cmp_f64(size_t i, size_t j) {
+    return (key_f64[i] > key_f64[j]) - (key_f64[i] < key_f64[j]);
+}
+#endif
+
+static int test_key(void) {
+    const size_t n32 = sizeof(key_i32) / sizeof(key_i32[0]);
+    const size_t n64 = sizeof(key_u64) / sizeof(key_u64[0]);
+    unsigned char *k = key_buf + 1;
+    int failed = 0;
+    int32_t a32[KEY_LEN];
+    int16_t a16[KEY_LEN];
+    size_t i;
+    int ok;
+
+    nadine_write_key_int32(k, -2);
+    failed += VERIFY(k[0] == 0x7F && k[1] == 0xFF && k[2] == 0xFF
+                     && k[3] == 0xFE, "i32 key -2");
+    nadine_write_key_uint16(k, 0x0102);
+    failed += VERIFY(k[0] == 1 && k[1] == 2, "u16 key");
+
+    for (i = 0; i < n32; ++i)
+        nadine_write_key_int32(k + i * 4, key_i32[i]);
+    failed += VERIFY(key_order(k, 4, n32, key_cmp_i32), "i32 key order");
+    ok = 1;
+    for (i = 0; i < n32; ++i)
+        ok &= nadine_read_key_int32(k + i * 4) == key_i32[i];
+    failed += VERIFY(ok, "i32 key read");
+
+    for (i = 0; i < n64; ++i)
+        nadine_write_key_uint64(k + i * 8, key_u64[i]);
+    failed += VERIFY(key_order(k, 8, n64, key_cmp_u64), "u64 key order");
+
+    /* arrays over more than a chunk match the single keys */
+    for (i = 0; i < KEY_LEN; ++i) {
+        a32[i] = (int32_t)(i * UINT32_C(2654435761));
+        a16[i] = (int16_t)(i * 40503U);
+    }
+    ok = 1;
+    nadine_write_array_key_int32(k, a32, KEY_LEN);
+    for (i = 0; i < KEY_LEN; ++i) {
+        unsigned char one[4];
+        nadine_write_key_int32(one, a32[i]);
+        ok &= !memcmp(one, k + i * 4, 4);
+    }
+    memset(a32, 0, sizeof(a32));
+    nadine_read_array_key_int32(a32, k, KEY_LEN);
+    for (i = 0; i < KEY_LEN; ++i)
+        ok &= a32[i] == (int32_t)(i * UINT32_C(2654435761));
+    nadine_write_array_key_short(k, a16, KEY_LEN);
+    for (i = 0; i + 1 < KEY_LEN; ++i)
+        ok &= (a16[i] < a16[i + 1])
+                == (memcmp(k + i * 2, k + i * 2 + 2, 2) < 0);
+    failed += VERIFY(ok, "key array mismatch");
+
+#if NADINE_FLOAT
+    {
+        const size_t nf = sizeof(key_f64) / sizeof(key_f64[0]);
+        double ad[sizeof(key_f64) / sizeof(key_f64[0])];
+        float af[KEY_LEN], rf[KEY_LEN];
+        unsigned char zero[8];
+
+        nadine_write_array_key_double(k, key_f64, nf);
+        failed += VERIFY(key_order(k, 8, nf, key_cmp_f64), "f64 key order");
+        nadine_read_array_key_double(ad, k, nf);
+        failed += VERIFY(!memcmp(ad, key_f64, sizeof(ad)), "f64 key read");
+
+        /* -0 sorts just before +0 */
+        nadine_write_key_double(zero, -0.0);
+        nadine_write_key_double(k, 0.0);
+        failed += VERIFY(memcmp(zero, k, 8) < 0, "f64 key -0");
+
+        for (i = 0; i < KEY_LEN; ++i)
+            af[i] = ((float)i - KEY_LEN / 2) * 0.37f;
+        nadine_write_array_key_float(k, af, KEY_LEN);
+        ok = 1;
+        for (i = 0; i + 1 < KEY_LEN; ++i)
+            ok &= memcmp(k + i * 4, k + i * 4 + 4, 4) < 0;
+        nadine_read_array_key_float(rf, k, KEY_LEN);
+        ok &= !memcmp(af, rf, sizeof(af));
+        ok &= nadine_read_key_float(k + 7 * 4) == af[7];
+        failed += VERIFY(ok, "f32 key array mismatch");
+    }
+#endif
+
+    return failed;
+}
+
+static int test_convert_array(void) {
+    int failed = 0;
+
+    uint16_t a16[ARRAY_TEST_LEN];
+    uint32_t a32[ARRAY_TEST_LEN];
+    int64_t a64[ARRAY_TEST_LEN];
+    unsigned endian;
+    size_t i;
+
+    for (endian = 0; endian < 4; ++endian) {
+        int ok16 = 1, ok32 = 1, ok64 = 1;
+
+        for (i = 0; i < ARRAY_TEST_LEN; ++i) {
+            a16[i] = (uint16_t)(UINT16_C(0x0102) * (i + 1));
+            a32[i] = (uint32_t)(UINT32_C(0x01020304) * (i + 1));
+            a64[i] = (int64_t)(INT64_C(0x0102030405060708) * (i + 1));
+        }
+
+        nadine_convert_array_uint16(endian, a16, ARRAY_TEST_LEN);
+        nadine_convert_array_uint32(endian, a32, ARRAY_TEST_LEN);
+        nadine_convert_array_int64(endian, a64, ARRAY_TEST_LEN);
+
+        for (i = 0; i < ARRAY_TEST_LEN; ++i) {
+            ok16 &= a16[i] == nadine_convert_uint16(endian,
+                        (uint16_t)(UINT16_C(0x0102) * (i + 1)));
+            ok32 &= a32[i] == nadine_convert_uint32(endian,
+                        (uint32_t)(UINT32_C(0x01020304) * (i + 1)));
+            ok64 &= a64[i] == nadine_convert_int64(endian,
+                        (int64_t)(INT64_C(0x0102030405060708) * (i + 1)));
+        }
+
+        failed += VERIFY(ok16, "u16 array convert mismatch");
+        failed += VERIFY(ok32, "u32 array convert mismatch");
+        failed += VERIFY(ok64, "i64 array convert mismatch");
+    }
+
+    a32[0] = UINT32_C(0x01020304);
+    nadine_convert_array_uint32(NADINE_ENDIAN_BIG, a32, 0);
+    failed += VERIFY(a32[0] == UINT32_C(0x01020304),
+                     "u32 empty array convert modified array");
+
+    return failed;
+}
+
+static int test_read_write_array(void) {
+    int failed = 0;
+
+    /* odd offsets to get unaligned buffers */
+    unsigned char src[ARRAY_TEST_LEN * 8 + 1], dst[ARRAY_TEST_LEN * 8 + 1];
+    uint16_t a16[ARRAY_TEST_LEN];
+    int32_t a32[ARRAY_TEST_LEN];
+    uint64_t a64[ARRAY_TEST_LEN];
+    unsigned endian;
+    size_t i;
+
+    for (i = 0; i < sizeof(src); ++i)
+        src[i] = (unsigned char)(i * 7 + 1);
+
+    for (endian = 0; endian < 4; ++endian) {
+        int ok16 = 1, ok32 = 1, ok64 = 1;
+
+        nadine_read_array_uint16(endian, a16, src + 1, ARRAY_TEST_LEN);
+        nadine_read_array_int32(endian, a32, src + 1, ARRAY_TEST_LEN);
+        nadine_read_array_uint64(endian, a64, src + 1, ARRAY_TEST_LEN);
+
+        for (i = 0; i < ARRAY_TEST_LEN; ++i) {
+            ok16 &= a16[i] == nadine_read_uint16(endian, src + 1 + i * 2);
+            ok32 &= a32[i] == nadine_read_int32(endian, src + 1 + i * 4);
+            ok64 &= a64[i] == nadine_read_uint64(endian, src + 1 + i * 8);
+        }
+
+        failed += VERIFY(ok16, "u16 array read mismatch");
+        failed += VERIFY(ok32, "i32 array read mismatch");
+        failed += VERIFY(ok64, "u64 array read mismatch");
+
+        nadine_write_array_uint16(endian, dst + 1, a16, ARRAY_TEST_LEN);
+        failed += VERIFY(!memcmp(dst + 1, src + 1, ARRAY_TEST_LEN * 2),
+                         "u16 array write mismatch");
+        nadine_write_array_int32(endian, dst + 1, a32, ARRAY_TEST_LEN);
+        failed += VERIFY(!memcmp(dst + 1, src + 1, ARRAY_TEST_LEN * 4),
+                         "i32 array write mismatch");
+        nadine_write_array_uint64(endian, dst + 1, a64, ARRAY_TEST_LEN);
+        failed += VERIFY(!memcmp(dst + 1, src + 1, ARRAY_TEST_LEN * 8),
+                         "u64 array write mismatch");
+    }
+
+    return failed;
+}
+
+/* reference for the array functions: transform every size-char element of
+   p[count] for XORed endians xf in two separate passes */
+static void xform_ref(unsigned char *p, size_t size, size_t count,
+                      unsigned xf) {
+    size_t i;
+    for (i = 0; i < count; ++i) {
+        if (xf & 1) nadine_i_memrev(p + i * size, size);
+        if (xf & 2) nadine_i_byteswap(p + i * size, size);
+    }
+}
+
+/* checks the array and single-value functions for type T against xform_ref
+   for all endians. long enough to go through both SIMD and scalar code */
+#define CHECK_XFORM(T, N, native, msg)                                         \
+    for (endian = 0; endian < 4; ++endian) {                                   \
+        T a[ARRAY_TEST_LEN];                                                   \
+        int ok = 1;                                                            \
+        memcpy(ref, src + 1, ARRAY_TEST_LEN * sizeof(T));                      \
+        xform_ref(ref, sizeof(T), ARRAY_TEST_LEN, (native) ^ endian);          \
+        nadine_read_array_##N(endian, a, src + 1, ARRAY_TEST_LEN);             \
+        ok &= !memcmp(a, ref, sizeof(a));                                      \
+        nadine_write_array_##N(endian, dst + 1, a, ARRAY_TEST_LEN);            \
+        ok &= !memcmp(dst + 1, src + 1, sizeof(a));                            \
+        memcpy(a, src + 1, sizeof(a));                                         \
+        nadine_convert_array_##N(endian, a, ARRAY_TEST_LEN);                   \
+        ok &= !memcmp(a, ref, sizeof(a));                                      \
+        for (i = 0; i < ARRAY_TEST_LEN; ++i) {                                 \
+            T v = nadine_read_##N(endian, src + 1 + i * sizeof(T));            \
+            ok &= !memcmp(&v, ref + i * sizeof(T), sizeof(T));                 \
+            nadine_write_##N(endian, dst, v);                                  \
+            ok &= !memcmp(dst, src + 1 + i * sizeof(T), sizeof(T));            \
+        }                                                                      \
+        failed += VERIFY(ok, msg);                                             \
+    }
+
+static int test_xform(void) {
+    int failed = 0;
+
+    unsigned char src[ARRAY_TEST_LEN * 16 + 1], dst[ARRAY_TEST_LEN * 16 + 1];
+    unsigned char ref[ARRAY_TEST_LEN * 16];
+    unsigned endian;
+    size_t i;
+
+    for (i = 0; i < sizeof(src); ++i)
+        src[i] = (unsigned char)(i * 7 + 1);
+
+    CHECK_XFORM(uint16_t, uint16, nadine_endian_native_uint16(),
+                "u16 transform mismatch");
+    CHECK_XFORM(uint32_t, uint32, nadine_endian_native_uint32(),
+                "u32 transform mismatch");
+    CHECK_XFORM(uint64_t, uint64, nadine_endian_native_uint64(),
+                "u64 transform mismatch");
+#if NADINE_INT128
+    CHECK_XFORM(nadine_uint128, uint128, nadine_endian_native_uint128(),
+                "u128 transform mismatch");
+#endif
+#if NADINE_FLOAT
+    CHECK_XFORM(float, float, nadine_endian_native_float(),
+                "f32 transform mismatch");
+    CHECK_XFORM(double, double, nadine_endian_native_double(),
+                "f64 transform mismatch");
+#endif
+
+    /* a single pass must still equal two passes on odd and long arrays */
+    for (i = 0; i < 4; ++i) {
+        static const size_t sizes[4] = { 3, 6, 10, 16 };
+        memcpy(ref, src, sizes[i]);
+        xform_ref(ref, sizes[i], 1, 3);
+        memcpy(dst, src, sizes[i]);
+        nadine_i_xform(dst, sizes[i], 3);
+        failed += VERIFY(!memcmp(dst, ref, sizes[i]), "xform 3 mismatch");
+    }
+
+    /* sizes that reverse whole words and the chars left in the middle */
+    for (i = 1; i <= 40; ++i) {
+        size_t j;
+        int ok = 1;
+        memcpy(dst, src, i);
+        nadine_i_memrev(dst, i);
+        for (j = 0; j < i; ++j)
+            ok &= dst[j] == src[i - j - 1];
+        failed += VERIFY(ok, "memrev mismatch");
+    }
+
+    return failed;
+}
+
+#define NT_TEST_LEN 211
+
+/* non-temporal stores must give the same result at every alignment */
+#define CHECK_NONTEMPORAL(T, N, msg)                                           \
+    for (endian = 0; endian < 4; ++endian) {                                   \
+        int ok = 1;                                                            \
+        T a[NT_TEST_LEN];                                                      \
+        memcpy(a, src, sizeof(a));                                             \
+        for (o = 0; o < 64; ++o) {                                             \
+            nadine_set_nontemporal(NADINE_NONTEMPORAL_OFF);                    \
+            memset(ref, 0, sizeof(ref));                                       \
+            nadine_write_array_##N(endian, ref + o, a, NT_TEST_LEN);           \
+            nadine_set_nontemporal(NADINE_NONTEMPORAL_ON);                     \
+            memset(dst, 0, sizeof(dst));                                       \
+            nadine_write_array_##N(endian, dst + o, a, NT_TEST_LEN);           \
+            ok &= !memcmp(dst, ref, sizeof(dst));                              \
+        }                                                                      \
+        failed += VERIFY(ok, msg);                                             \
+    }
+
+static int test_nontemporal(void) {
+    int failed = 0;
+
+    unsigned char src[NT_TEST_LEN * 16];
+    unsigned char dst[NT_TEST_LEN * 16 + 64], ref[NT_TEST_LEN * 16 + 64];
+    unsigned endian;
+    size_t i, o;
+
+    for (i = 0; i < sizeof(src); ++i)
+        src[i] = (unsigned char)(i * 7 + 1);
+
+    CHECK_NONTEMPORAL(uint16_t, uint16, "u16 non-temporal mismatch");
+    CHECK_NONTEMPORAL(uint32_t, uint32, "u32 non-temporal mismatch");
+    CHECK_NONTEMPORAL(uint64_t, uint64, "u64 non-temporal mismatch");
+#if NADINE_INT128
+    CHECK_NONTEMPORAL(nadine_uint128, uint128, "u128 non-temporal mismatch");
+#endif
+
+    nadine_set_nontemporal(NADINE_NONTEMPORAL_AUTO);
+    return failed;
+}
+
+static int test_cursor(void) {
+    int failed = 0;
+
+    static const unsigned char src[15] = {
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+    };
+    unsigned char dst[sizeof(src)];
+    nadine_cursor c;
+
+    nadine_cursor_init(&c, src, sizeof(src), NADINE_ENDIAN_BIG);
+    failed += VERIFY(nadine_cursor_require(&c, 15), "cursor require 15");
+    failed += VERIFY(!nadine_cursor_require(&c, 16), "cursor require 16");
+    failed += VERIFY(nadine_cursor_read_uint16(&c) == UINT16_C(0x0102),
+                     "cursor read uint16");
+    failed += VERIFY(nadine_cursor_read_int32(&c) == INT32_C(0x03040506),
+                     "cursor read int32");
+    nadine_cursor_skip(&c, 1);
+    failed += VERIFY(nadine_cursor_read_uint64(&c)
+                        == UINT64_C(0x08090A0B0C0D0E0F),
+                     "cursor read uint64");
+    failed += VERIFY(nadine_cursor_tell(&c) == 15, "cursor tell");
+    failed += VERIFY(nadine_cursor_remaining(&c) == 0, "cursor remaining");
+
+    nadine_cursor_init(&c, dst, sizeof(dst), NADINE_ENDIAN_LITTLE);
+    nadine_cursor_write_uint16(&c, UINT16_C(0x0201));
+    nadine_cursor_write_int32(&c, INT32_C(0x06050403));
+    dst[nadine_cursor_tell(&c)] = 0x07;
+    nadine_cursor_skip(&c, 1);
+    c.endian = NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS;
+    nadine_cursor_write_uint64(&c, UINT64_C(0x09080B0A0D0C0F0E));
+    failed += VERIFY(!memcmp(dst, src, sizeof(src)), "cursor write");
+
+    return failed;
+}
+
+/* check every field of every record against nadine_read_N */
+static int check_records(const unsigned char *orig, const unsigned char *conv,
+                         const nadine_field *fields, size_t nfields,
+                         unsigned endian, size_t size, size_t stride,
+                         size_t count) {
+    size_t i, j;
+    int ok = 1;
+    for (i = 0; i < count; ++i) {
+        for (j = 0; j < nfields; ++j) {
+            const unsigned char *a = orig + i * stride + fields[j].offset;
+            const unsigned char *b = conv + i * stride + fields[j].offset;
+            uint16_t v16;
+            uint32_t v32;
+            uint64_t v64;
+            if (!fields[j].width) continue;
+            if (fields[j].kind == NADINE_FIELD_RAW) {
+                ok &= !memcmp(a, b, fields[j].width);
+                continue;
+            }
+#if NADINE_FLOAT
+            if (fields[j].kind == NADINE_FIELD_FLOAT) {
+                double d = nadine_read_double(endian, a);
+                ok &= !memcmp(&d, b, sizeof(d));
+                continue;
+            }
+#endif
+            switch (fields[j].width) {
+            case 2:
+                v16 = nadine_read_uint16(endian, a);
+                ok &= !memcmp(&v16, b, 2);
+                break;
+            case 4:
+                v32 = nadine_read_uint32(endian, a);
+                ok &= !memcmp(&v32, b, 4);
+                break;
+            case 8:
+                v64 = nadine_read_uint64(endian, a);
+                ok &= !memcmp(&v64, b, 8);
+                break;
+            }
+        }
+        /* padding must not change */
+        if (i + 1 < count)
+            ok &= !memcmp(orig + i * stride + size, conv + i * stride + size,
+                          stride - size);
+    }
+    return ok;
+}
+
+#define BITS_TEST_FIELDS 300
+
+static int test_bits(void) {
+    int failed = 0;
+    unsigned char buf[BITS_TEST_FIELDS * 8], ref[BITS_TEST_FIELDS * 8];
+    unsigned widths[BITS_TEST_FIELDS];
+    uint64_t values[BITS_TEST_FIELDS], x = UINT64_C(0x9E3779B97F4A7C15), v;
+    nadine_bitwriter w;
+    nadine_bitreader r;
+    size_t i, pos, n;
+    unsigned endian, b;
+    int ok;
+
+    for (i = 0; i < BITS_TEST_FIELDS; ++i) {
+        x = x * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+        widths[i] = (unsigned)(x >> 58) % NADINE_BITS_MAX + 1;
+        /* the bits above the width must be ignored */
+        values[i] = x;
+    }
+
+    for (endian = 0; endian < 2; ++endian) {
+        /* reference, one bit at a time */
+        memset(ref, 0, sizeof(ref));
+        for (i = 0, pos = 0; i < BITS_TEST_FIELDS; ++i) {
+            for (b = 0; b < widths[i]; ++b, ++pos) {
+                unsigned bit = endian == NADINE_ENDIAN_BIG
+                        ? (unsigned)(values[i] >> (widths[i] - b - 1)) & 1
+                        : (unsigned)(values[i] >> b) & 1;
+                ref[pos / 8] |= (unsigned char)(endian == NADINE_ENDIAN_BIG
+                        ? bit << (7 - pos % 8) : bit << (pos % 8));
+            }
+        }
+
+        memset(buf, 0xEE, sizeof(buf));
+        nadine_bitwriter_init(&w, buf, sizeof(buf), endian);
+        for (i = 0; i < BITS_TEST_FIELDS; ++i)
+            nadine_bitwriter_put(&w, values[i], widths[i]);
+        failed += VERIFY(nadine_bitwriter_tell(&w) == pos,
+                         "bitwriter tell mismatch");
+        n = nadine_bitwriter_finish(&w);
+        failed += VERIFY(nadine_bitwriter_ok(&w) && n == (pos + 7) / 8
+                         && !memcmp(buf, ref, n), "bitwriter mismatch");
+
+        /* exactly sized, so that the end goes through the tail */
+        nadine_bitreader_init(&r, buf, n, endian);
+        for (i = 0, ok = 1; i < BITS_TEST_FIELDS; ++i) {
+            uint64_t mask = ((uint64_t)1 << widths[i]) - 1;
+            if (i % 3) {
+                v = nadine_bitreader_read(&r, widths[i]);
+            } else {
+                nadine_bitreader_refill(&r);
+                v = nadine_bitreader_peek(&r, widths[i]);
+                nadine_bitreader_consume(&r, widths[i]);
+            }
+            ok &= v == (values[i] & mask);
+        }
+        failed += VERIFY(ok, "bitreader mismatch");
+        failed += VERIFY(nadine_bitreader_tell(&r) == pos
+                         && nadine_bitreader_ok(&r), "bitreader tell/ok");
+        nadine_bitreader_align(&r);
+        failed += VERIFY(nadine_bitreader_tell(&r) == n * 8
+                         && nadine_bitreader_ok(&r), "bitreader align");
+        v = nadine_bitreader_read(&r, 1);
+        failed += VERIFY(!v && !nadine_bitreader_ok(&r),
+                         "bitreader past end");
+
+        /* short buffers */
+        nadine_bitwriter_init(&w, buf, 3, endian);
+        nadine_bitwriter_put(&w, 0x1ABCU, 13);
+        nadine_bitwriter_put(&w, 0x0123U, 11);
+        failed += VERIFY(nadine_bitwriter_ok(&w)
+                         && nadine_bitwriter_finish(&w) == 3
+                         && nadine_bitwriter_ok(&w), "bitwriter fill");
+        nadine_bitwriter_put(&w, 1, 1);
+        nadine_bitwriter_finish(&w);
+        failed += VERIFY(!nadine_bitwriter_ok(&w), "bitwriter past end");
+        nadine_bitreader_init(&r, buf, 3, endian);
+        v = nadine_bitreader_read(&r, 13);
+        failed += VERIFY(v == 0x1ABCU
+                         && nadine_bitreader_read(&r, 11) == 0x0123U
+                         && nadine_bitreader_ok(&r), "bitreader short");
+    }
+
+    return failed;
+}
+
+static int test_iowriter(void) {
+    int failed = 0;
+    static const size_t sizes[] = { 3, 0, 5, 1, 1, 2, 64, 16 };
+    unsigned char seg[8][64], flat[128], out[128];
+    nadine_iov iov[8];
+    nadine_iowriter w;
+    nadine_cursor c;
+    size_t i, n, k;
+
+    for (i = 0; i < 8; ++i) {
+        iov[i].iov_base = seg[i];
+        iov[i].iov_len = sizes[i];
+    }
+    nadine_iowriter_init(&w, iov, 8, NADINE_ENDIAN_BIG);
+    nadine_cursor_init(&c, flat, sizeof(flat), NADINE_ENDIAN_BIG);
+    /* spills over every boundary at least once, and skips the empty one */
+    for (i = 0; i < 3; ++i) {
+        nadine_iowriter_write_uint16(&w, UINT16_C(0x0102));
+        nadine_cursor_write_uint16(&c, UINT16_C(0x0102));
+        nadine_iowriter_write_uint32(&w, UINT32_C(0x03040506));
+        nadine_cursor_write_uint32(&c, UINT32_C(0x03040506));
+        nadine_iowriter_write_int64(&w, INT64_C(-0x0708090A0B0C0D0E));
+        nadine_cursor_write_int64(&c, INT64_C(-0x0708090A0B0C0D0E));
+        nadine_iowriter_put(&w, "xyz", 3);
+        memcpy(c.pos, "xyz", 3);
+        nadine_cursor_skip(&c, 3);
+    }
+#if NADINE_FLOAT
+    nadine_iowriter_write_double(&w, 0.1);
+    nadine_cursor_write_double(&c, 0.1);
+#endif
+    failed += VERIFY(nadine_iowriter_ok(&w), "iowriter ok");
+    failed += VERIFY(nadine_iowriter_tell(&w) == nadine_cursor_tell(&c),
+                     "iowriter tell");
+
+    n = nadine_iowriter_finish(&w);
+    failed += VERIFY(n == 7, "iowriter finish count");
+    for (i = 0, k = 0; i < n; ++i) {
+        memcpy(out + k, iov[i].iov_base, iov[i].iov_len);
+        k += iov[i].iov_len;
+    }
+    failed += VERIFY(k == nadine_cursor_tell(&c) && !memcmp(out, flat, k),
+                     "iowriter mismatch");
+
+    /* running out of segments */
+    iov[0].iov_len = 3;
+    nadine_iowriter_init(&w, iov, 1, NADINE_ENDIAN_LITTLE);
+    nadine_iowriter_write_uint16(&w, UINT16_C(0x0102));
+    failed += VERIFY(nadine_iowriter_ok(&w), "iowriter ok before end");
+    nadine_iowriter_write_uint16(&w, UINT16_C(0x0304));
+    failed += VERIFY(!nadine_iowriter_ok(&w) && seg[0][2] == 4,
+                     "iowriter past end");
+    failed += VERIFY(nadine_iowriter_finish(&w) == 1 && iov[0].iov_len == 3,
+                     "iowriter finish full");
+
+    nadine_iowriter_init(&w, iov, 0, NADINE_ENDIAN_LITTLE);
+    nadine_iowriter_put(&w, "", 0);
+    failed += VERIFY(nadine_iowriter_ok(&w) && !nadine_iowriter_finish(&w),
+                     "iowriter no segments");
+    return failed;
+}
+
+static int test_records(void) {
+    int failed = 0;
+
+    /* 16 chars: can be shuffled */
+    static const nadine_field small[] = {
+        { 0, 4, NADINE_FIELD_INT },
+        { 4, 2, NADINE_FIELD_INT },
+        { 6, 2, NADINE_FIELD_RAW },
+        { 8, 8, NADINE_FIELD_INT }
+    };
+    /* 24 chars: {u32, u16, u16, f64, i64} */
+    static const nadine_field large[] = {
+        { 0, 4, NADINE_FIELD_INT },
+        { 4, 2, NADINE_FIELD_INT },
+        { 6, 2, NADINE_FIELD_INT },
+#if NADINE_FLOAT
+        { 8, 8, NADINE_FIELD_FLOAT },
+#else
+        { 8, 8, NADINE_FIELD_INT },
+#endif
+        { 16, 8, NADINE_FIELD_INT }
+    };
+    /* empty fields, anywhere, are skipped */
+    static const nadine_field empty[] = {
+        { 0, 4, NADINE_FIELD_INT },
+        { 4, 0, NADINE_FIELD_INT },
+        { 100, 0, NADINE_FIELD_INT },
+        { 4, 2, NADINE_FIELD_INT },
+        { 8, 0, NADINE_FIELD_FLOAT },
+        { 16, 8, NADINE_FIELD_INT }
+    };
+    static const nadine_field overlap[] = {
+        { 0, 4, NADINE_FIELD_INT },
+        { 2, 2, NADINE_FIELD_INT }
+    };
+    unsigned char orig[ARRAY_TEST_LEN * 24], conv[ARRAY_TEST_LEN * 24];
+    nadine_plan plan;
+    unsigned endian;
+    size_t i;
+
+    for (i = 0; i < sizeof(orig); ++i)
+        orig[i] = (unsigned char)(i * 7 + 1);
+
+    failed += VERIFY(!nadine_plan_compile(&plan, overlap, 2),
+                     "overlapping fields accepted");
+
+    failed += VERIFY(nadine_plan_compile(&plan, small, 4),
+                     "plan_compile small");
+    failed += VERIFY(plan.size == 16, "plan size small");
+    for (endian = 0; endian < 4; ++endian) {
+        /* packed records */
+        memcpy(conv, orig, sizeof(orig));
+        nadine_convert_records(&plan, endian, conv, 16, ARRAY_TEST_LEN);
+        failed += VERIFY(check_records(orig, conv, small, 4, endian,
+                                       16, 16, ARRAY_TEST_LEN),
+                         "convert_records small packed");
+        /* padded records */
+        memcpy(conv, orig, sizeof(orig));
+        nadine_convert_records(&plan, endian, conv, 20, ARRAY_TEST_LEN);
+        failed += VERIFY(check_records(orig, conv, small, 4, endian,
+                                       16, 20, ARRAY_TEST_LEN),
+                         "convert_records small padded");
+    }
+
+    failed += VERIFY(nadine_plan_compile(&plan, large, 5),
+                     "plan_compile large");
+    failed += VERIFY(plan.size == 24, "plan size large");
+    for (endian = 0; endian < 4; ++endian) {
+        memcpy(conv, orig, sizeof(orig));
+        nadine_convert_records(&plan, endian, conv, 24, ARRAY_TEST_LEN);
+        failed += VERIFY(check_records(orig, conv, large, 5, endian,
+                                       24, 24, ARRAY_TEST_LEN),
+                         "convert_records large");
+    }
+
+    failed += VERIFY(nadine_plan_compile(&plan, empty, 6),
+                     "plan_compile empty");
+    failed += VERIFY(plan.size == 24, "plan size empty");
+    for (endian = 0; endian < 4; ++endian) {
+        memcpy(conv, orig, sizeof(orig));
+        nadine_convert_records(&plan, endian, conv, 24, ARRAY_TEST_LEN);
+        failed += VERIFY(check_records(orig, conv, empty, 6, endian,
+                                       24, 24, ARRAY_TEST_LEN),
+                         "convert_records empty");
+        /* the first 16 chars alone can be shuffled */
+        memcpy(conv, orig, sizeof(orig));
+        nadine_plan_compile(&plan, empty, 5);
+        nadine_convert_records(&plan, endian, conv, 16, ARRAY_TEST_LEN);
+        failed += VERIFY(check_records(orig, conv, empty, 5, endian,
+                                       6, 16, ARRAY_TEST_LEN),
+                         "convert_records empty shuffled");
+        nadine_plan_compile(&plan, empty, 6);
+    }
+
+    return failed;
+}
+
+static int test_interleave(void) {
+    int failed = 0;
+
+    /* 28 chars: {u32, u16, char[3], u8, i16, f64, i64} + 2 padding */
+    static const nadine_field fields[] = {
+        { 0, 4, NADINE_FIELD_INT },
+        { 4, 2, NADINE_FIELD_INT },
+        { 6, 3, NADINE_FIELD_RAW },
+        { 9, 1, NADINE_FIELD_INT },
+        { 10, 2, NADINE_FIELD_INT },
+#if NADINE_FLOAT
+        { 12, 8, NADINE_FIELD_FLOAT },
+#else
+        { 12, 8, NADINE_FIELD_INT },
+#endif
+        { 20, 8, NADINE_FIELD_INT }
+    };
+    enum { STRIDE = 30, COUNT = 300 };  /* more than one block */
+    static unsigned char src[STRIDE * COUNT], dst[STRIDE * COUNT];
+    static uint32_t c0[COUNT];
+    static uint16_t c1[COUNT];
+    static unsigned char c2[COUNT * 3], c3[COUNT];
+    static int16_t c4[COUNT];
+#if NADINE_FLOAT
+    static double c5[COUNT];
+#else
+    static uint64_t c5[COUNT];
+#endif
+    static int64_t c6[COUNT];
+    void *cols[7];
+    const void *ccols[7];
+    nadine_plan plan;
+    unsigned endian;
+    size_t i;
+    int ok;
+
+    cols[0] = c0, cols[1] = c1, cols[2] = c2, cols[3] = c3;
+    cols[4] = c4, cols[5] = c5, cols[6] = c6;
+    for (i = 0; i < 7; ++i) ccols[i] = cols[i];
+    for (i = 0; i < sizeof(src); ++i)
+        src[i] = (unsigned char)(i * 7 + 1);
+
+    failed += VERIFY(nadine_plan_compile(&plan, fields, 7),
+                     "plan_compile interleave");
+    for (endian = 0; endian < 4; ++endian) {
+        nadine_deinterleave(&plan, endian, cols, src, STRIDE, COUNT);
+        ok = 1;
+        for (i = 0; i < COUNT; ++i) {
+            const unsigned char *r = src + i * STRIDE;
+            ok &= c0[i] == nadine_read_uint32(endian, r);
+            ok &= c1[i] == nadine_read_uint16(endian, r + 4);
+            ok &= !memcmp(&c2[i * 3], r + 6, 3);
+            ok &= c3[i] == r[9];
+            ok &= c4[i] == nadine_read_int16(endian, r + 10);
+#if NADINE_FLOAT
+            {
+                double d = nadine_read_double(endian, r + 12);
+                ok &= !memcmp(&c5[i], &d, sizeof(d));
+            }
+#else
+            ok &= c5[i] == nadine_read_uint64(endian, r + 12);
+#endif
+            ok &= c6[i] == nadine_read_int64(endian, r + 20);
+        }
+        failed += VERIFY(ok, "deinterleave mismatch");
+
+        /* padding must be left alone */
+        memcpy(dst, src, sizeof(dst));
+        for (i = 0; i < COUNT; ++i)
+            memset(dst + i * STRIDE, 0, 28);
+        nadine_interleave(&plan, endian, dst, STRIDE, ccols, COUNT);
+        failed += VERIFY(!memcmp(dst, src, sizeof(dst)),
+                         "interleave mismatch");
+    }
+
+    /* NULL columns are skipped */
+    cols[1] = NULL;
+    c0[0] = 0;
+    nadine_deinterleave(&plan, NADINE_ENDIAN_BIG, cols, src, STRIDE, 1);
+    failed += VERIFY(c0[0] == UINT32_C(0x01080F16), "deinterleave NULL");
+
+    return failed;
+}
+
+#if NADINE_MMAP
+#define MAPPED_FILE "nadine_test.tmp"
+#define MAPPED_COPY "nadine_test2.tmp"
+#define MAPPED_SIZE 20011   /* compile with a small NADINE_MAPPED_CHUNK */
+
+static unsigned char mapped_src[MAPPED_SIZE], mapped_buf[MAPPED_SIZE];
+
+static int mapped_put(const char *path) {
+    FILE *f = fopen(path, "wb");
+    size_t n;
+    if (!f) return 0;
+    n = fwrite(mapped_src, 1, MAPPED_SIZE, f);
+    return !fclose(f) && n == MAPPED_SIZE;
+}
+
+static int mapped_get(const char *path) {
+    FILE *f = fopen(path, "rb");
+    size_t n;
+    if (!f) return 0;
+    n = fread(mapped_buf, 1, MAPPED_SIZE, f);
+    return !fclose(f) && n == MAPPED_SIZE;
+}
+
+/* do the values of width chars at offset in mapped_buf match mapped_src
+   converted, and everything else is unmodified? */
+static int mapped_check(size_t width, unsigned endian,
+                        size_t offset, size_t count) {
+    unsigned char v[16];
+    size_t i;
+    if (memcmp(mapped_buf, mapped_src, offset)) return 0;
+    for (i = 0; i < count; ++i) {
+        const size_t o = offset + i * width;
+        switch (width) {
+        case 4: {
+            uint32_t x = nadine_read_uint32(endian, mapped_src + o);
+            memcpy(v, &x, 4);
+            break;
+        }
+#if NADINE_FLOAT
+        case 8: {
+            double x = nadine_read_double(endian, mapped_src + o);
+            memcpy(v, &x, 8);
+            break;
+        }
+#endif
+        default:
+            memcpy(v, mapped_src + o, width);
+            xform_ref(v, width, 1,
+                      endian ^ nadine_endian_native_unsigned_long());
+        }
+        if (memcmp(mapped_buf + o, v, width)) return 0;
+    }
+    i = offset + count * width;
+    return !memcmp(mapped_buf + i, mapped_src + i, MAPPED_SIZE - i);
+}
+
+static int test_mapped(void) {
+    int failed = 0;
+    static const size_t widths[] = { 4, 8, 3 };
+    size_t i, w, count;
+    unsigned endian;
+#if NADINE_FLOAT
+    const unsigned kind8 = NADINE_FIELD_FLOAT;
+#else
+    const unsigned kind8 = NADINE_FIELD_INT;
+#endif
+
+    for (i = 0; i < MAPPED_SIZE; ++i)
+        mapped_src[i] = (unsigned char)(i * 7 + 1);
+
+    for (w = 0; w < sizeof(widths) / sizeof(widths[0]); ++w) {
+        const size_t width = widths[w];
+        const unsigned kind = width == 8 ? kind8 : NADINE_FIELD_INT;
+        for (endian = 0; endian < 4; ++endian) {
+            /* in place, to the end of the file from an unaligned offset */
+            count = (MAPPED_SIZE - 5) / width;
+            failed += VERIFY(mapped_put(MAPPED_FILE), "mapped put");
+            failed += VERIFY(nadine_convert_mapped(MAPPED_FILE, width, kind,
+                                                   endian, 5,
+                                                   NADINE_MAPPED_ALL),
+                             "convert_mapped");
+            failed += VERIFY(mapped_get(MAPPED_FILE)
+                                && mapped_check(width, endian, 5, count),
+                             "convert_mapped mismatch");
+
+            /* out of place, part of the file */
+            count = 4000 / width;
+            failed += VERIFY(mapped_put(MAPPED_FILE), "mapped put");
+            failed += VERIFY(nadine_convert_mapped_copy(MAPPED_COPY,
+                                                        MAPPED_FILE, width,
+                                                        kind, endian, 4099,
+                                                        count),
+                             "convert_mapped_copy");
+            failed += VERIFY(mapped_get(MAPPED_COPY)
+                                && mapped_check(width, endian, 4099, count),
+                             "convert_mapped_copy mismatch");
+            failed += VERIFY(mapped_get(MAPPED_FILE)
+                                && !memcmp(mapped_buf, mapped_src,
+                                           MAPPED_SIZE),
+                             "convert_mapped_copy modified source");
+        }
+    }
+
+    failed += VERIFY(!nadine_convert_mapped(MAPPED_FILE, 4, NADINE_FIELD_INT,
+                                            NADINE_ENDIAN_BIG, 8,
+                                            MAPPED_SIZE / 4),
+                     "convert_mapped past end of file");
+    /* copying a file onto itself must fail before truncating it */
+    failed += VERIFY(mapped_put(MAPPED_FILE), "mapped put");
+    failed += VERIFY(!nadine_convert_mapped_copy(MAPPED_FILE, MAPPED_FILE, 4,
+                                                 NADINE_FIELD_INT,
+                                                 NADINE_ENDIAN_BIG, 0,
+                                                 NADINE_MAPPED_ALL),
+                     "convert_mapped_copy onto source");
+    failed += VERIFY(!nadine_convert_mapped_copy("./" MAPPED_FILE,
+                                                 MAPPED_FILE, 4,
+                                                 NADINE_FIELD_INT,
+                                                 NADINE_ENDIAN_BIG, 0,
+                                                 NADINE_MAPPED_ALL),
+                     "convert_mapped_copy onto source by another name");
+    failed += VERIFY(mapped_get(MAPPED_FILE)
+                        && !memcmp(mapped_buf, mapped_src, MAPPED_SIZE),
+                     "convert_mapped_copy onto source modified it");
+    failed += VERIFY(!nadine_convert_mapped(MAPPED_FILE, 0, NADINE_FIELD_INT,
+                                            NADINE_ENDIAN_BIG, 0, 0),
+                     "convert_mapped width 0");
+    remove(MAPPED_FILE);
+    remove(MAPPED_COPY);
+    failed += VERIFY(!nadine_convert_mapped(MAPPED_FILE, 4, NADINE_FIELD_INT,
+                                            NADINE_ENDIAN_BIG, 0,
+                                            NADINE_MAPPED_ALL),
+                     "convert_mapped missing file");
+    return failed;
+}
+#endif
+
+#if NADINE_THREADS
+#define PARALLEL_LEN 20011  /* compile with a small NADINE_PARALLEL_MIN */
+
+static unsigned parallel_calls;
+
+/* runs the tasks backwards on this thread */
+static void parallel_runner(void *context, nadine_parallel_task task,
+                            void *argument, unsigned n) {
+    ++*(unsigned *)context;
+    while (n--) task(argument, n);
+}
+
+static int test_parallel(void) {
+    int failed = 0;
+    static const unsigned nthreads[] = { 0, 1, 2, 3, 7, 64, 1000 };
+    static unsigned char src[PARALLEL_LEN * 8 + 1], dst[PARALLEL_LEN * 8 + 1];
+    static uint32_t a32[PARALLEL_LEN], r32[PARALLEL_LEN];
+    static uint64_t a64[PARALLEL_LEN], r64[PARALLEL_LEN];
+    static uint16_t a16[128];
+    unsigned endian, t, r;
+    size_t i;
+
+    for (i = 0; i < sizeof(src); ++i)
+        src[i] = (unsigned char)(i * 7 + 1);
+
+    for (r = 0; r < 2; ++r) {
+        if (r) nadine_set_parallel_runner(&parallel_runner, &parallel_calls);
+        for (endian = 0; endian < 4; ++endian) {
+            nadine_read_array_uint32(endian, r32, src + 1, PARALLEL_LEN);
+            nadine_read_array_uint64(endian, r64, src + 1, PARALLEL_LEN);
+            for (t = 0; t < sizeof(nthreads) / sizeof(nthreads[0]); ++t) {
+                /* the destination is not aligned to a cache line */
+                nadine_read_array_parallel_uint32(endian, a32 + 1, src + 5,
+                                                  PARALLEL_LEN - 1,
+                                                  nthreads[t]);
+                a32[0] = r32[0];
+                failed += VERIFY(!memcmp(a32, r32, sizeof(a32)),
+                                 "read_array_parallel_uint32");
+                nadine_read_array_parallel_uint64(endian, a64, src + 1,
+                                                  PARALLEL_LEN, nthreads[t]);
+                failed += VERIFY(!memcmp(a64, r64, sizeof(a64)),
+                                 "read_array_parallel_uint64");
+
+                nadine_convert_array_parallel_uint64(endian, a64,
+                                                     PARALLEL_LEN,
+                                                     nthreads[t]);
+                failed += VERIFY(!memcmp(a64, src + 1, sizeof(a64)),
+                                 "convert_array_parallel_uint64");
+
+                memset(dst, 0, sizeof(dst));
+                nadine_write_array_parallel_uint32(endian, dst + 1, r32,
+                                                   PARALLEL_LEN, nthreads[t]);
+                failed += VERIFY(!memcmp(dst + 1, src + 1, PARALLEL_LEN * 4)
+                                    && !dst[0] && !dst[PARALLEL_LEN * 4 + 1],
+                                 "write_array_parallel_uint32");
+            }
+        }
+    }
+    nadine_set_parallel_runner(NULL, NULL);
+    failed += VERIFY(parallel_calls > 0, "parallel runner not called");
+
+    /* arrays shorter than the values before the first cache line of a
+       misaligned destination, with NADINE_PARALLEL_MIN as small as 1 */
+    for (r = 0; r < 32; ++r) {
+        for (i = 0; i < 70; ++i) {
+            uint16_t *p = a16 + 1 + r;
+            memcpy(p - 1, src, (i + 2) * 2);
+            nadine_convert_array_parallel_uint16(NADINE_ENDIAN_BIG, p, i,
+                                                 r % 2 ? 2 : 64);
+            nadine_convert_array_uint16(NADINE_ENDIAN_BIG, p, i);
+            failed += VERIFY(!memcmp(p - 1, src, (i + 2) * 2),
+                             "convert_array_parallel_uint16 short");
+        }
+    }
+    return failed;
+}
+#endif
+
+#if NADINE_STREAM
+#define STREAM_LEN 100
+
+/* write a header and arrays of three types to s, and the same chars to
+   ref. returns the number of chars */
+static size_t stream_put(nadine_stream *s, unsigned char *ref) {
+    uint32_t a32[STREAM_LEN];
+    int16_t a16[STREAM_LEN];
+    size_t i, n = 0;
+    for (i = 0; i < STREAM_LEN; ++i) {
+        a32[i] = (uint32_t)(i * UINT32_C(2654435761));
+        a16[i] = (int16_t)(i * 40503U);
+    }
+    nadine_stream_write(s, "HDR", 3);
+    memcpy(ref, "HDR", 3), n += 3;
+    nadine_stream_write_array_uint32(s, NADINE_ENDIAN_BIG, a32, STREAM_LEN);
+    nadine_write_array_uint32(NADINE_ENDIAN_BIG, ref + n, a32, STREAM_LEN);
+    n += STREAM_LEN * 4;
+    nadine_stream_write_array_int16(s, NADINE_ENDIAN_BIG
+                                           | NADINE_ENDIAN_SWAPCHARS,
+                                    a16, STREAM_LEN - 7);
+    nadine_write_array_int16(NADINE_ENDIAN_BIG | NADINE_ENDIAN_SWAPCHARS,
+                             ref + n, a16, STREAM_LEN - 7);
+    n += (STREAM_LEN - 7) * 2;
+    nadine_stream_write_array_uint32(s, NADINE_ENDIAN_LITTLE, a32, 5);
+    nadine_write_array_uint32(NADINE_ENDIAN_LITTLE, ref + n, a32, 5);
+    return n + 5 * 4;
+}
+
+/* read back what stream_put wrote, checking it against it */
+static int stream_get(nadine_stream *s) {
+    uint32_t a32[STREAM_LEN];
+    int16_t a16[STREAM_LEN];
+    char hdr[3];
+    size_t i;
+    int ok = 1;
+    ok &= nadine_stream_read(s, hdr, 3) == 3 && !memcmp(hdr, "HDR", 3);
+    ok &= nadine_stream_read_array_uint32(s, NADINE_ENDIAN_BIG, a32,
+                                          STREAM_LEN) == STREAM_LEN;
+    for (i = 0; i < STREAM_LEN; ++i)
+        ok &= a32[i] == (uint32_t)(i * UINT32_C(2654435761));
+    ok &= nadine_stream_read_array_int16(s, NADINE_ENDIAN_BIG
+                                                | NADINE_ENDIAN_SWAPCHARS,
+                                         a16, STREAM_LEN - 7)
+            == STREAM_LEN - 7;
+    for (i = 0; i < STREAM_LEN - 7; ++i)
+        ok &= a16[i] == (int16_t)(i * 40503U);
+    /* fewer values than asked for at the end */
+    ok &= nadine_stream_read_array_uint32(s, NADINE_ENDIAN_LITTLE, a32,
+                                          STREAM_LEN) == 5;
+    for (i = 0; i < 5; ++i)
+        ok &= a32[i] == (uint32_t)(i * UINT32_C(2654435761));
+    ok &= nadine_stream_read(s, hdr, 1) == 0 && nadine_stream_ok(s);
+    return ok;
+}
+
+static int test_stream(void) {
+    int failed = 0;
+    unsigned char ref[STREAM_LEN * 8], got[STREAM_LEN * 8], wbuf[37];
+    unsigned char rbuf[29];
+    uint32_t a32[2];
+    /* buffers smaller than the arrays, and one larger */
+    static const size_t wsizes[] = { sizeof(wbuf), 16, sizeof(got) };
+    static const size_t rsizes[] = { sizeof(rbuf), 9, sizeof(got) };
+    const uint32_t one = 1;
+    nadine_stream s;
+    size_t n;
+    int ok, k;
+    FILE *f = tmpfile();
+
+    if (VERIFY(f != NULL, "stream tmpfile")) return 1;
+    for (k = 0; k < 3; ++k) {
+        rewind(f);
+        nadine_stream_init_file(&s, f, k == 2 ? got : wbuf, wsizes[k]);
+        n = stream_put(&s, ref);
+        ok = nadine_stream_flush(&s) && nadine_stream_ok(&s);
+        ok &= !fflush(f);
+        rewind(f);
+        ok &= fread(got, 1, n, f) == n && !memcmp(got, ref, n);
+        ok &= fgetc(f) == EOF;
+        failed += VERIFY(ok, "stream write mismatch");
+
+        rewind(f);
+        nadine_stream_init_file(&s, f, k == 2 ? got : rbuf, rsizes[k]);
+        failed += VERIFY(stream_get(&s), "stream read mismatch");
+    }
+
+    /* a FILE is read for no more than the call needs, as a pipe would
+       block for the rest */
+    rewind(f);
+    nadine_stream_init_file(&s, f, got, sizeof(got));
+    ok = nadine_stream_read(&s, rbuf, 3) == 3 && ftell(f) == 3;
+    ok &= nadine_stream_read_array_uint32(&s, NADINE_ENDIAN_BIG, a32, 2) == 2
+          && ftell(f) == 11;
+    failed += VERIFY(ok, "stream read ahead");
+
+    /* a buffer too small for the values */
+    nadine_stream_init_file(&s, f, wbuf, 3);
+    failed += VERIFY(nadine_stream_write_array_uint32(&s, NADINE_ENDIAN_BIG,
+                                                      &one, 1)
+                     == 0, "stream buffer too small");
+    nadine_stream_init_file(&s, f, wbuf, 0);
+    failed += VERIFY(nadine_stream_write(&s, "x", 1) == 0,
+                     "stream empty buffer");
+    fclose(f);
+
+#if NADINE_I_STREAM_FD && defined(__unix__)
+    {
+        /* through a pipe, which takes what stream_put writes at once */
+        int fds[2];
+        if (VERIFY(!pipe(fds), "stream pipe")) return failed + 1;
+        nadine_stream_init_fd(&s, fds[1], wbuf, sizeof(wbuf));
+        stream_put(&s, ref);
+        ok = nadine_stream_flush(&s) && !close(fds[1]);
+        nadine_stream_init_fd(&s, fds[0], rbuf, sizeof(rbuf));
+        ok &= stream_get(&s) && !close(fds[0]);
+        failed += VERIFY(ok, "stream fd mismatch");
+    }
+#endif
+
+    return failed;
+}
+#endif
+
 #if NADINE_FLOAT
+static int test_read_write_array_float(void) {
+    int failed = 0;
+
+    unsigned char src[ARRAY_TEST_LEN * 8 + 1], dst[ARRAY_TEST_LEN * 8 + 1];
+    float af[ARRAY_TEST_LEN];
+    double ad[ARRAY_TEST_LEN];
+    unsigned endian;
+    size_t i;
+
+    for (i = 0; i < ARRAY_TEST_LEN; ++i) {
+        nadine_write_float(NADINE_ENDIAN_BIG, src + 1 + i * 4,
+                           0.75f * (float)i);
+        nadine_write_double(NADINE_ENDIAN_BIG, dst + 1 + i * 8,
+                            -3.5 * (double)i);
+    }
+    nadine_read_array_float(NADINE_ENDIAN_BIG, af, src + 1, ARRAY_TEST_LEN);
+    nadine_read_array_double(NADINE_ENDIAN_BIG, ad, dst + 1, ARRAY_TEST_LEN);
+
+    for (i = 0; i < ARRAY_TEST_LEN; ++i) {
+        failed += VERIFY(af[i] == 0.75f * (float)i, "f32 array read mismatch");
+        failed += VERIFY(ad[i] == -3.5 * (double)i, "f64 array read mismatch");
+    }
+
+    for (endian = 0; endian < 4; ++endian) {
+        int okf = 1, okd = 1;
+
+        nadine_write_array_float(endian, src + 1, af, ARRAY_TEST_LEN);
+        nadine_write_array_double(endian, dst + 1, ad, ARRAY_TEST_LEN);
+
+        for (i = 0; i < ARRAY_TEST_LEN; ++i) {
+            okf &= nadine_read_float(endian, src + 1 + i * 4) == af[i];
+            okd &= nadine_read_double(endian, dst + 1 + i * 8) == ad[i];
+        }
+
+        failed += VERIFY(okf, "f32 array write mismatch");
+        failed += VERIFY(okd, "f64 array write mismatch");
+    }
+
+    return failed;
+}
+
+static int test_convert_array_float(void) {
+    int failed = 0;
+
+    float af[ARRAY_TEST_LEN];
+    double ad[ARRAY_TEST_LEN];
+    unsigned endian;
+    size_t i;
+
+    for (endian = 0; endian < 4; ++endian) {
+        int okf = 1, okd = 1;
+
+        for (i = 0; i < ARRAY_TEST_LEN; ++i) {
+            af[i] = 1.5f * (float)i;
+            ad[i] = -2.25 * (double)i;
+        }
+
+        nadine_convert_array_float(endian, af, ARRAY_TEST_LEN);
+        nadine_convert_array_double(endian, ad, ARRAY_TEST_LEN);
+
+        for (i = 0; i < ARRAY_TEST_LEN; ++i) {
+            float f = nadine_convert_float(endian, 1.5f * (float)i);
+            double d = nadine_convert_double(endian, -2.25 * (double)i);
+            okf &= memcmp(&af[i], &f, sizeof(f)) == 0;
+            okd &= memcmp(&ad[i], &d, sizeof(d)) == 0;
+        }
+
+        failed += VERIFY(okf, "f32 array convert mismatch");
+        failed += VERIFY(okd, "f64 array convert mismatch");
+    }
+
+    return failed;
+}
+
+#define SAMPLE_LEN 1000
+
+static unsigned char sample_buf[SAMPLE_LEN * 4 + 1];
+static float sample_f[SAMPLE_LEN];
+static int32_t sample_i[SAMPLE_LEN];
+
+/* x rounded to nearest with ties to even, saturated to [lo, hi] */
+static long sample_ref(float x, long lo, long hi) {
+    long t;
+    double r;
+    if (x != x) return 0;
+    if (x <= (double)lo) return lo;
+    if (x >= (double)hi) return hi;
+    t = (long)x;
+    r = (double)x - (double)t;
+    if (r > 0.5 || (r == 0.5 && t % 2)) ++t;
+    if (r < -0.5 || (r == -0.5 && t % 2)) --t;
+    return t < lo ? lo : t > hi ? hi : t;
+}
+
+static int test_sample(void) {
+    int failed = 0;
+
+    static const uint32_t specials[] = {
+        0x7FC00000, 0xFFC00000, 0x7F800000, 0xFF800000, 0x3F000000,
+        0xBF000000, 0x3FC00000, 0xC0200000, 0x46FFFF00, 0x46FFFF80,
+        0xC7000000, 0xC7000080, 0x4F000000, 0xCF000000, 0x4EFFFFFF,
+        0xCF000001, 0x4B000001, 0x00000001, 0x80000000, 0x3F7FFFFF,
+    };
+    const size_t ns = sizeof(specials) / sizeof(specials[0]);
+    unsigned char *buf = sample_buf + 1;
+    unsigned endian;
+    size_t i, n;
+    int ok;
+
+    for (endian = 0; endian < 4; ++endian) {
+        for (i = 0; i < SAMPLE_LEN; ++i)
+            nadine_write_uint32(endian, buf + i * 4,
+                                (uint32_t)(i * UINT32_C(2654435761)));
+
+        /* widening reads match the single values */
+        for (n = 0; n <= SAMPLE_LEN; n += n < 40 ? 1 : 320) {
+            ok = 1;
+            nadine_read_array_int16_to_float(endian, sample_f, buf, n,
+                                             1.0f / 32768);
+            for (i = 0; i < n; ++i)
+                ok &= sample_f[i] == (float)nadine_read_int16(endian,
+                                                              buf + i * 2)
+                                     * (1.0f / 32768);
+            nadine_read_array_int16_to_int32(endian, sample_i, buf, n);
+            for (i = 0; i < n; ++i)
+                ok &= sample_i[i] == nadine_read_int16(endian, buf + i * 2);
+            nadine_read_array_int32_to_float(endian, sample_f, buf, n, 0.5f);
+            for (i = 0; i < n; ++i)
+                ok &= sample_f[i] == (float)nadine_read_int32(endian,
+                                                              buf + i * 4)
+                                     * 0.5f;
+            failed += VERIFY(ok, "sample read mismatch");
+        }
+
+        /* narrowing writes round and saturate, at every place in a
+           vector, and NaN is 0 */
+        for (i = 0; i < SAMPLE_LEN; ++i) {
+            uint32_t u = i % 3 ? (uint32_t)(i * UINT32_C(2246822519))
+                               : specials[i / 3 % ns];
+            memcpy(&sample_f[i], &u, sizeof(u));
+            sample_i[i] = (int32_t)(i * UINT32_C(3266489917));
+        }
+        for (n = 0; n <= SAMPLE_LEN; n += n < 40 ? 1 : 320) {
+            ok = 1;
+            nadine_write_array_float_to_int16(endian, buf, sample_f, n, 1.0f);
+            for (i = 0; i < n; ++i)
+                ok &= nadine_read_int16(endian, buf + i * 2)
+                        == sample_ref(sample_f[i], -32768L, 32767L);
+            nadine_write_array_float_to_int32(endian, buf, sample_f, n, 1.0f);
+            for (i = 0; i < n; ++i)
+                ok &= nadine_read_int32(endian, buf + i * 4)
+                        == sample_ref(sample_f[i], -2147483647L - 1,
+                                      2147483647L);
+            nadine_write_array_int32_to_int16(endian, buf, sample_i, n);
+            for (i = 0; i < n; ++i)
+                ok &= nadine_read_int16(endian, buf + i * 2)
+                        == (sample_i[i] < -32768 ? -32768
+                            : sample_i[i] > 32767 ? 32767 : sample_i[i]);
+            failed += VERIFY(ok, "sample write mismatch");
+        }
+    }
+
+    /* scale applies before rounding */
+    for (i = 0; i < 16; ++i)
+        sample_f[i] = (float)i / 4 - 2;
+    nadine_write_array_float_to_int16(NADINE_ENDIAN_BIG, buf, sample_f, 16,
+                                      2.0f);
+    ok = 1;
+    for (i = 0; i < 16; ++i)
+        ok &= nadine_read_int16(NADINE_ENDIAN_BIG, buf + i * 2)
+                == sample_ref(sample_f[i] * 2, -32768L, 32767L);
+    failed += VERIFY(ok, "sample scale mismatch");
+    failed += VERIFY(nadine_read_int16(NADINE_ENDIAN_BIG, buf + 3 * 2) == -2
+                     && nadine_read_int16(NADINE_ENDIAN_BIG, buf + 5 * 2) == -2,
+                     "sample -2.5 and -1.5 should round to even");
+
+    return failed;
+}
+
 static int test_float(void) {
     int failed = 0;
 
@@ -479,6 +2350,191 @@ static int test_double(void) {
                   && buf[6] == 0x1C && buf[7] == 0x40,
                   "f64 write LE fail");
 
+    if (nadine_endian_native_double() == nadine_endian_native_uint64()) {
+        unsigned endian;
+        for (endian = 0; endian < 4; ++endian) {
+            double d = nadine_convert_double(endian, val);
+            uint64_t u;
+            memcpy(&u, &val, sizeof(u));
+            u = nadine_convert_uint64(endian, u);
+            failed += VERIFY(!memcmp(&d, &u, sizeof(u)),
+                             "f64 convert differs from u64 convert");
+        }
+    }
+
+    return failed;
+}
+#endif
+
+#if NADINE_FLOAT16
+static float f32_from_bits(uint32_t x) {
+    float v;
+    memcpy(&v, &x, sizeof(v));
+    return v;
+}
+
+static uint32_t f32_bits(float v) {
+    uint32_t x;
+    memcpy(&x, &v, sizeof(x));
+    return x;
+}
+
+static unsigned f16_write(float v) {
+    unsigned char buf[2];
+    nadine_write_float16(NADINE_ENDIAN_BIG, buf, v);
+    return (unsigned)buf[0] << 8 | buf[1];
+}
+
+static unsigned bf16_write(float v) {
+    unsigned char buf[2];
+    nadine_write_bfloat16(NADINE_ENDIAN_BIG, buf, v);
+    return (unsigned)buf[0] << 8 | buf[1];
+}
+
+static uint32_t f16_read(unsigned h) {
+    unsigned char buf[2];
+    buf[0] = (unsigned char)(h >> 8);
+    buf[1] = (unsigned char)h;
+    return f32_bits(nadine_read_float16(NADINE_ENDIAN_BIG, buf));
+}
+
+#define F16_COUNT 65536UL
+
+static unsigned char f16_src[F16_COUNT * 2 + 1], f16_dst[F16_COUNT * 2 + 1];
+static float f16_val[F16_COUNT];
+
+static int test_float16(void) {
+    int failed = 0;
+    unsigned char buf[2];
+    unsigned endian;
+    unsigned long i;
+    int ok;
+
+    buf[0] = 0x00; buf[1] = 0x3C;
+    failed += VERIFY(nadine_read_float16(NADINE_ENDIAN_LITTLE, buf) == 1.0f,
+                     "f16 read LE fail");
+    buf[0] = 0x3C; buf[1] = 0x00;
+    failed += VERIFY(nadine_read_float16(NADINE_ENDIAN_BIG, buf) == 1.0f,
+                     "f16 read BE fail");
+    nadine_write_float16(NADINE_ENDIAN_LITTLE, buf, -2.0f);
+    failed += VERIFY(buf[0] == 0x00 && buf[1] == 0xC0, "f16 write LE fail");
+
+    failed += VERIFY(f16_read(0xC000) == f32_bits(-2.0f), "f16 -2");
+    failed += VERIFY(f16_read(0x7BFF) == f32_bits(65504.0f), "f16 max");
+    failed += VERIFY(f16_read(0x0001) == f32_bits(1.0f / 16777216.0f),
+                     "f16 smallest subnormal");
+    failed += VERIFY(f16_read(0x03FF) == f32_bits(1023.0f / 16777216.0f),
+                     "f16 largest subnormal");
+    failed += VERIFY(f16_read(0x8000) == UINT32_C(0x80000000), "f16 -0");
+    failed += VERIFY(f16_read(0x7C00) == UINT32_C(0x7F800000), "f16 inf");
+    failed += VERIFY(f16_read(0x7E00) == UINT32_C(0x7FC00000), "f16 qNaN");
+    failed += VERIFY(f16_read(0x7D00) == UINT32_C(0x7FE00000),
+                     "f16 sNaN should become quiet");
+
+    /* ties go to even, overflow goes to infinity */
+    failed += VERIFY(f16_write(1.0f + 1.0f / 2048.0f) == 0x3C00,
+                     "f16 tie down to even");
+    failed += VERIFY(f16_write(1.0f + 3.0f / 2048.0f) == 0x3C02,
+                     "f16 tie up to even");
+    failed += VERIFY(f16_write(65504.0f) == 0x7BFF, "f16 write max");
+    failed += VERIFY(f16_write(65519.0f) == 0x7BFF, "f16 below the tie");
+    failed += VERIFY(f16_write(65520.0f) == 0x7C00, "f16 overflow");
+    failed += VERIFY(f16_write(-1e10f) == 0xFC00, "f16 -overflow");
+    failed += VERIFY(f16_write(1.0f / 33554432.0f) == 0x0000,
+                     "f16 2^-25 to zero");
+    failed += VERIFY(f16_write(3.0f / 33554432.0f) == 0x0002,
+                     "f16 3*2^-25 to 2^-23");
+    failed += VERIFY(f16_write(1e-10f) == 0x0000, "f16 underflow");
+    failed += VERIFY(f16_write(f32_from_bits(UINT32_C(0x387FE000)))
+                     == 0x0400, "f16 subnormal rounding into normal");
+    failed += VERIFY(f16_write(f32_from_bits(UINT32_C(0x7F800001)))
+                     == 0x7E00, "f16 write sNaN should become quiet");
+
+    /* every half: arrays match the single values, and non-NaN values
+       convert back to themselves */
+    for (endian = 0; endian < 4; ++endian) {
+        for (i = 0; i < F16_COUNT; ++i)
+            nadine_write_unsigned_short(endian, f16_src + 1 + i * 2,
+                                        (unsigned short)i);
+        nadine_read_array_float16(endian, f16_val, f16_src + 1, F16_COUNT - 3);
+        ok = 1;
+        for (i = 0; i < F16_COUNT - 3; ++i)
+            ok &= f32_bits(f16_val[i])
+                  == f32_bits(nadine_read_float16(endian, f16_src + 1 + i * 2));
+        failed += VERIFY(ok, "f16 array read mismatch");
+
+        nadine_read_array_float16(endian, f16_val, f16_src + 1, F16_COUNT);
+        nadine_write_array_float16(endian, f16_dst + 1, f16_val, F16_COUNT);
+        ok = 1;
+        for (i = 0; i < F16_COUNT; ++i) {
+            unsigned h = nadine_read_unsigned_short(endian,
+                                                    f16_dst + 1 + i * 2);
+            nadine_write_float16(endian, buf, f16_val[i]);
+            ok &= h == nadine_read_unsigned_short(endian, buf);
+            ok &= ((i & 0x7C00) == 0x7C00 && (i & 0x3FF)) || h == i;
+        }
+        failed += VERIFY(ok, "f16 array write mismatch");
+    }
+
+    /* floats all over the range: arrays round like the single values */
+    for (i = 0; i < F16_COUNT; ++i)
+        f16_val[i] = f32_from_bits((uint32_t)(i * UINT32_C(0x10001) + i / 7));
+    for (endian = 0; endian < 4; ++endian) {
+        nadine_write_array_float16(endian, f16_dst + 1, f16_val, F16_COUNT - 5);
+        ok = 1;
+        for (i = 0; i < F16_COUNT - 5; ++i) {
+            nadine_write_float16(endian, buf, f16_val[i]);
+            ok &= !memcmp(buf, f16_dst + 1 + i * 2, 2);
+        }
+        failed += VERIFY(ok, "f16 array write rounding mismatch");
+    }
+
+    return failed;
+}
+
+static int test_bfloat16(void) {
+    int failed = 0;
+    unsigned char buf[2];
+    float af[ARRAY_TEST_LEN];
+    unsigned endian;
+    size_t i;
+    int ok;
+
+    buf[0] = 0x80; buf[1] = 0x3F;
+    failed += VERIFY(nadine_read_bfloat16(NADINE_ENDIAN_LITTLE, buf) == 1.0f,
+                     "bf16 read LE fail");
+    buf[0] = 0xC0; buf[1] = 0x40;
+    failed += VERIFY(nadine_read_bfloat16(NADINE_ENDIAN_BIG, buf) == -3.0f,
+                     "bf16 read BE fail");
+
+    failed += VERIFY(bf16_write(f32_from_bits(UINT32_C(0x3F808000)))
+                     == 0x3F80, "bf16 tie down to even");
+    failed += VERIFY(bf16_write(f32_from_bits(UINT32_C(0x3F818000)))
+                     == 0x3F82, "bf16 tie up to even");
+    failed += VERIFY(bf16_write(f32_from_bits(UINT32_C(0x3F808001)))
+                     == 0x3F81, "bf16 round up");
+    failed += VERIFY(bf16_write(f32_from_bits(UINT32_C(0x7F7FFFFF)))
+                     == 0x7F80, "bf16 overflow");
+    failed += VERIFY(bf16_write(f32_from_bits(UINT32_C(0x7F800001)))
+                     == 0x7FC0, "bf16 NaN should stay NaN");
+    failed += VERIFY(bf16_write(f32_from_bits(UINT32_C(0xFF800000)))
+                     == 0xFF80, "bf16 -inf");
+
+    for (i = 0; i < ARRAY_TEST_LEN; ++i)
+        af[i] = -0.375f * (float)i;
+    for (endian = 0; endian < 4; ++endian) {
+        float back[ARRAY_TEST_LEN];
+        nadine_write_array_bfloat16(endian, f16_dst + 1, af, ARRAY_TEST_LEN);
+        nadine_read_array_bfloat16(endian, back, f16_dst + 1, ARRAY_TEST_LEN);
+        ok = 1;
+        for (i = 0; i < ARRAY_TEST_LEN; ++i) {
+            nadine_write_bfloat16(endian, buf, af[i]);
+            ok &= !memcmp(buf, f16_dst + 1 + i * 2, 2);
+            ok &= back[i] == nadine_read_bfloat16(endian, buf);
+        }
+        failed += VERIFY(ok, "bf16 array mismatch");
+    }
+
     return failed;
 }
 #endif
@@ -486,6 +2542,9 @@ static int test_double(void) {
 int main(int argc, char *argv[]) {
     int failed = 0;
 
+    nadine_init();
+    printf("array kernel=%u\n", nadine_simd_kernel());
+
     failed += test_uint16();
     failed += test_int16();
 
@@ -495,9 +2554,51 @@ int main(int argc, char *argv[]) {
     failed += test_uint64();
     failed += test_int64();
 
+#if NADINE_INT128
+    failed += test_uint128();
+#endif
+
+    failed += test_native_endian();
+    failed += test_config();
+    failed += test_packed();
+    failed += test_fixed_endian();
+    failed += test_codec();
+    failed += test_aligned();
+    failed += test_checksum();
+    failed += test_search();
+    failed += test_key();
+
+    failed += test_convert_array();
+    failed += test_read_write_array();
+    failed += test_xform();
+    failed += test_nontemporal();
+
+    failed += test_cursor();
+    failed += test_bits();
+    failed += test_iowriter();
+    failed += test_records();
+    failed += test_interleave();
+#if NADINE_MMAP
+    failed += test_mapped();
+#endif
+#if NADINE_THREADS
+    failed += test_parallel();
+#endif
+#if NADINE_STREAM
+    failed += test_stream();
+#endif
+
 #if NADINE_FLOAT
     failed += test_float();
     failed += test_double();
+
+    failed += test_convert_array_float();
+    failed += test_read_write_array_float();
+    failed += test_sample();
+#endif
+#if NADINE_FLOAT16
+    failed += test_float16();
+    failed += test_bfloat16();
 #endif
 
     if (failed) puts("Some tests failed.");
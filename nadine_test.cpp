@@ -0,0 +1,189 @@
+/* TEST PROGRAM FOR NADINE C++ HEADER */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#define NADINE_STATIC 1
+#include "nadine.hpp"
+
+#if CHAR_BIT != 8
+#error test program requires CHAR_BIT 8
+#endif
+
+#ifdef NADINE_I_HPP_NATIVE_INT
+static_assert(nadine::convert<nadine::big>(std::uint32_t(0x01020304UL))
+                == (NADINE_I_HPP_NATIVE_INT == NADINE_ENDIAN_BIG
+                        ? 0x01020304UL : 0x04030201UL),
+              "convert<big> is not constexpr or is wrong");
+static_assert(nadine::convert<nadine::little>(std::uint16_t(0x0102U))
+                == (NADINE_I_HPP_NATIVE_INT == NADINE_ENDIAN_LITTLE
+                        ? 0x0102U : 0x0201U),
+              "convert<little> is not constexpr or is wrong");
+static_assert(nadine::convert<nadine::big>(nadine::convert<nadine::big>(
+                    std::int64_t(-2))) == -2,
+              "convert<big> does not round-trip");
+#endif
+
+static int verify(int line, int cond, const char *msg) {
+    if (!cond) {
+        std::printf("Assert '%s' failed on line %u.\n", msg, line);
+        return 1;
+    }
+    return 0;
+}
+
+#define VERIFY(cond, msg) verify(__LINE__, cond, msg)
+
+template <class T>
+static int test_matches_c(unsigned endian, T (*c_read)(unsigned, const void *),
+                          const char *msg) {
+    int failed = 0;
+    static const unsigned char src[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    unsigned char buf[sizeof(T)];
+    T v;
+
+    /* compare against the C functions */
+    switch (endian) {
+    case nadine::little: v = nadine::read<nadine::little, T>(src); break;
+    case nadine::big:    v = nadine::read<nadine::big, T>(src);    break;
+    case nadine::pdp:    v = nadine::read<nadine::pdp, T>(src);    break;
+    default:             v = nadine::read<nadine::h316, T>(src);   break;
+    }
+    failed += verify(__LINE__, v == c_read(endian, src), msg);
+
+    switch (endian) {
+    case nadine::little: nadine::write<nadine::little>(buf, v); break;
+    case nadine::big:    nadine::write<nadine::big>(buf, v);    break;
+    case nadine::pdp:    nadine::write<nadine::pdp>(buf, v);    break;
+    default:             nadine::write<nadine::h316>(buf, v);   break;
+    }
+    failed += verify(__LINE__, !std::memcmp(buf, src, sizeof(T)), msg);
+    return failed;
+}
+
+static int test_read_write(void) {
+    int failed = 0;
+    unsigned endian;
+
+    for (endian = 0; endian < 4; ++endian) {
+        failed += test_matches_c<std::uint16_t>(endian, &nadine_read_uint16,
+                                                "uint16 read/write");
+        failed += test_matches_c<std::int16_t>(endian, &nadine_read_int16,
+                                               "int16 read/write");
+        failed += test_matches_c<std::uint32_t>(endian, &nadine_read_uint32,
+                                                "uint32 read/write");
+        failed += test_matches_c<std::int32_t>(endian, &nadine_read_int32,
+                                               "int32 read/write");
+        failed += test_matches_c<std::uint64_t>(endian, &nadine_read_uint64,
+                                                "uint64 read/write");
+        failed += test_matches_c<std::int64_t>(endian, &nadine_read_int64,
+                                               "int64 read/write");
+#if NADINE_FLOAT
+        failed += test_matches_c<float>(endian, &nadine_read_float,
+                                        "float read/write");
+        failed += test_matches_c<double>(endian, &nadine_read_double,
+                                         "double read/write");
+#endif
+    }
+
+    return failed;
+}
+
+static int test_convert(void) {
+    int failed = 0;
+    std::uint32_t v = 0x01020304UL;
+
+    failed += VERIFY(nadine::convert<nadine::big>(v)
+                        == nadine_convert_uint32(NADINE_ENDIAN_BIG, v),
+                     "convert<big>");
+    failed += VERIFY(nadine::convert<nadine::little>(v)
+                        == nadine_convert_uint32(NADINE_ENDIAN_LITTLE, v),
+                     "convert<little>");
+    failed += VERIFY(nadine::convert<nadine::pdp>(v)
+                        == nadine_convert_pdp_uint32(v),
+                     "convert<pdp>");
+    failed += VERIFY(nadine::convert<nadine::h316>(v)
+                        == nadine_convert_h316_uint32(v),
+                     "convert<h316>");
+    failed += VERIFY(nadine::convert<nadine::big>(std::uint8_t(0x5A)) == 0x5A,
+                     "convert<big> uint8");
+    return failed;
+}
+
+struct wire_header {
+    nadine::be<std::uint16_t> type;
+    nadine::le<std::uint32_t> length;
+    nadine::pdpe<std::int32_t> offset;
+    nadine::h316e<std::uint16_t> flags;
+};
+
+static_assert(sizeof(wire_header) == 12 && alignof(wire_header) == 1,
+              "stored has padding or alignment");
+static_assert(std::is_trivially_copyable<nadine::be<std::uint64_t> >::value
+                && std::is_standard_layout<nadine::le<std::int16_t> >::value,
+              "stored is not trivially copyable or standard layout");
+
+static int test_stored(void) {
+    int failed = 0;
+    static const unsigned char src[13] = { 0xEE, 0x01, 0x02, 0x10, 0x20,
+                                           0x30, 0x40, 0x03, 0x04, 0x01,
+                                           0x02, 0x05, 0x06 };
+    unsigned char buf[13];
+    wire_header *h;
+
+    /* overlay at an odd address */
+    std::memcpy(buf, src, sizeof(buf));
+    h = reinterpret_cast<wire_header *>(buf + 1);
+    failed += VERIFY(h->type == 0x0102U, "be<uint16> read in place");
+    failed += VERIFY(h->length == nadine_read_uint32(NADINE_ENDIAN_LITTLE,
+                                                     src + 3),
+                     "le<uint32> read in place");
+    failed += VERIFY(h->offset.get() == nadine_read_pdp_int32(src + 7),
+                     "pdpe<int32> read in place");
+    failed += VERIFY(h->flags == nadine_read_h316_uint16(src + 11),
+                     "h316e<uint16> read in place");
+
+    h->type = 0xA0B0U;
+    failed += VERIFY(buf[1] == 0xA0 && buf[2] == 0xB0 && buf[0] == 0xEE
+                        && buf[3] == 0x10,
+                     "be<uint16> write in place");
+    h->length += 1;
+    failed += VERIFY(buf[3] == 0x11
+                        && h->length == 0x40302011UL,
+                     "le<uint32> +=");
+    h->offset = -2;
+    failed += VERIFY(nadine_read_pdp_int32(buf + 7) == -2,
+                     "pdpe<int32> assign");
+    failed += VERIFY(h->flags++ == nadine_read_h316_uint16(src + 11)
+                        && --h->flags == nadine_read_h316_uint16(src + 11),
+                     "h316e<uint16> ++/--");
+    h->flags <<= 4;
+    h->flags |= 0xFU;
+    failed += VERIFY(h->flags == std::uint16_t(
+                        (nadine_read_h316_uint16(src + 11) << 4) | 0xFU),
+                     "h316e<uint16> <<= |=");
+#if NADINE_FLOAT
+    {
+        nadine::le<double> d(2.5);
+        d *= 2.0;
+        failed += VERIFY(d == 5.0 && nadine_read_le_double(d.data()) == 5.0,
+                         "le<double>");
+    }
+#endif
+    return failed;
+}
+
+int main(void) {
+    int failed = 0;
+
+    failed += test_convert();
+    failed += test_read_write();
+    failed += test_stored();
+
+    if (failed) std::puts("Some tests failed.");
+    else        std::puts("All tests OK.");
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}